@@ -11,7 +11,7 @@
 ##
 
 QT += core gui
-greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets concurrent
 
 TARGET = scorep-score-gui
 TEMPLATE = app
@@ -24,6 +24,39 @@ CONFIG += warn_on debug_and_release
 SOURCES += src/main.cpp\
         src/mainwindow.cpp \
         src/connector.cpp \
+        src/frontier.cpp \
+        src/frontierwidget.cpp \
+        src/filterstate.cpp \
+        src/regionselection.cpp \
+        src/selectiondialog.cpp \
+        src/tablemodel.cpp \
+        src/sortindex.cpp \
+        src/trigramindex.cpp \
+        src/processpyramid.cpp \
+        src/heatmapwidget.cpp \
+        src/regiondetailwidget.cpp \
+        src/calltree.cpp \
+        src/calltreemodel.cpp \
+        src/densitymap.cpp \
+        src/densitywidget.cpp \
+        src/filterfile.cpp \
+        src/filtercompression.cpp \
+        src/filterrules.cpp \
+        src/filterexport.cpp \
+        src/profilesession.cpp \
+        src/sessionfile.cpp \
+        src/profilediff.cpp \
+        src/batchscore.cpp \
+        src/scalingmodel.cpp \
+        src/scalingwidget.cpp \
+        src/profileswidget.cpp \
+        src/profilewatcher.cpp \
+        src/baselinewidget.cpp \
+        src/fileswidget.cpp \
+        src/filtersaver.cpp \
+        src/searchbar.cpp \
+        src/calltreewidget.cpp \
+        src/brushwidget.cpp \
         src/score/SCOREP_Score_Estimator.cpp \
         src/score/SCOREP_Score_Profile.cpp \
         src/score/SCOREP_Score_Event.cpp \
@@ -32,6 +65,39 @@ SOURCES += src/main.cpp\
 
 HEADERS  += src/mainwindow.hpp \
             src/connector.hpp \
+            src/frontier.hpp \
+            src/frontierwidget.hpp \
+            src/filterstate.hpp \
+            src/regionselection.hpp \
+            src/selectiondialog.hpp \
+            src/tablemodel.hpp \
+            src/sortindex.hpp \
+            src/trigramindex.hpp \
+            src/processpyramid.hpp \
+            src/heatmapwidget.hpp \
+            src/regiondetailwidget.hpp \
+            src/calltree.hpp \
+            src/calltreemodel.hpp \
+            src/densitymap.hpp \
+            src/densitywidget.hpp \
+            src/filterfile.hpp \
+            src/filtercompression.hpp \
+            src/filterrules.hpp \
+            src/filterexport.hpp \
+            src/profilesession.hpp \
+            src/sessionfile.hpp \
+            src/profilediff.hpp \
+            src/batchscore.hpp \
+            src/scalingmodel.hpp \
+            src/scalingwidget.hpp \
+            src/profileswidget.hpp \
+            src/profilewatcher.hpp \
+            src/baselinewidget.hpp \
+            src/fileswidget.hpp \
+            src/filtersaver.hpp \
+            src/searchbar.hpp \
+            src/calltreewidget.hpp \
+            src/brushwidget.hpp \
             src/score/SCOREP_Score_Estimator.hpp \
             src/score/SCOREP_Score_Profile.hpp \
             src/score/SCOREP_Score_Event.hpp \
@@ -0,0 +1,163 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#include "baselinewidget.hpp"
+
+BaselineWidget::BaselineWidget( QWidget* parent )
+    : QLabel( parent )
+    , mp_shown( 0 )
+    , mp_baseline( 0 )
+    , mp_loading( 0 )
+    , m_diffValid( false )
+{
+    mp_loadWatcher = new QFutureWatcher<bool>( this );
+    mp_diffWatcher = new QFutureWatcher<QSharedPointer<const ProfileDiff> >( this );
+    connect( mp_loadWatcher, SIGNAL( finished() ), this, SLOT( baselineFinished() ) );
+    connect( mp_diffWatcher, SIGNAL( finished() ), this, SLOT( diffFinished() ) );
+    hide();
+}
+
+BaselineWidget::~BaselineWidget()
+{
+    if ( mp_loadWatcher->isRunning() )
+    {
+        m_progress.cancel.fetchAndStoreRelaxed( 1 );
+        mp_loadWatcher->waitForFinished();
+    }
+    delete mp_loading;
+    delete mp_baseline;
+}
+
+bool
+BaselineWidget::load( const QString& fileName )
+{
+    if ( mp_loadWatcher->isRunning() )
+    {
+        return false;
+    }
+    m_loadingFile = fileName;
+    m_progress.stage.fetchAndStoreRelaxed( Connector::OPEN );
+    m_progress.done.fetchAndStoreRelaxed( 0 );
+    m_progress.total.fetchAndStoreRelaxed( 0 );
+    m_progress.cancel.fetchAndStoreRelaxed( 0 );
+    mp_loading = new Connector();
+    mp_loadWatcher->setFuture( QtConcurrent::run( &Connector::load, mp_loading, fileName, &m_progress ) );
+    updateText();
+    return true;
+}
+
+void
+BaselineWidget::stop()
+{
+    if ( mp_loadWatcher->isRunning() )
+    {
+        /*baselineFinished drops it*/
+        m_progress.cancel.fetchAndStoreRelaxed( 1 );
+    }
+    delete mp_baseline;
+    mp_baseline = 0;
+    m_fileName.clear();
+    m_diffValid = false;
+    m_diff.clear();
+    emit diffChanged();
+    updateText();
+}
+
+void
+BaselineWidget::compare( Connector* shown )
+{
+    mp_shown    = shown;
+    m_diffValid = false;
+    if ( m_diff )
+    {
+        m_diff.clear();
+        emit diffChanged();
+    }
+    if ( mp_baseline && mp_shown )
+    {
+        /*the snapshots are shared, the join does not touch the connectors*/
+        m_diffValid = true;
+        mp_diffWatcher->setFuture( QtConcurrent::run( &ProfileDiff::compute, mp_shown->getFunctionData(),
+                                                      mp_baseline->getFunctionData(),
+                                                      mp_baseline->getGroupData() ) );
+    }
+    updateText();
+}
+
+QSharedPointer<const ProfileDiff>
+BaselineWidget::diff() const
+{
+    return m_diff;
+}
+
+void
+BaselineWidget::baselineFinished()
+{
+    bool       loaded     = mp_loadWatcher->result();
+    Connector* connection = mp_loading;
+    mp_loading = 0;
+    if ( !loaded || m_progress.cancel.fetchAndAddRelaxed( 0 ) )
+    {
+        if ( !connection->getLoadError().isEmpty() )
+        {
+            emit loadFailed( "Error: " + connection->getLoadError() );
+        }
+        delete connection;
+        updateText();
+        return;
+    }
+    delete mp_baseline;
+    mp_baseline = connection;
+    m_fileName  = m_loadingFile;
+    compare( mp_shown );
+}
+
+void
+BaselineWidget::diffFinished()
+{
+    if ( !m_diffValid || mp_diffWatcher->isRunning() )
+    {
+        return;
+    }
+    m_diff = mp_diffWatcher->result();
+    emit diffChanged();
+    updateText();
+}
+
+void
+BaselineWidget::updateText()
+{
+    QString baseline = QFileInfo( m_fileName ).fileName();
+    if ( mp_loadWatcher->isRunning() )
+    {
+        setText( "loading baseline " + QFileInfo( m_loadingFile ).fileName() + "..." );
+    }
+    else if ( !mp_baseline )
+    {
+        hide();
+        return;
+    }
+    else if ( !m_diff )
+    {
+        setText( mp_shown ? "comparing with " + baseline + "..." : "baseline " + baseline + " loaded" );
+    }
+    else
+    {
+        setText( QString( "Changes against %1: %2 regions matched, %3 new, %4 removed with max_buf %5" )
+                 .arg( baseline )
+                 .arg( m_diff->matchedNum() )
+                 .arg( m_diff->addedNum() )
+                 .arg( m_diff->removedNum() )
+                 .arg( mp_shown->getReadableByteNo( m_diff->removedMaxBuf() ) ) );
+    }
+    show();
+}
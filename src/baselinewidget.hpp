@@ -0,0 +1,84 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#ifndef BASELINEWIDGET_HPP
+#define BASELINEWIDGET_HPP
+
+#include <QLabel>
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QtConcurrentRun>
+
+#include "connector.hpp"
+#include "profilediff.hpp"
+
+/*
+ * A baseline profile, e.g. of the run before a change, loaded in the
+ * background independent of the shown profile and joined to it. The
+ * label tells what the numbers are compared with and is hidden without a
+ * baseline.
+ */
+class BaselineWidget : public QLabel
+{
+    Q_OBJECT
+
+public:
+    BaselineWidget( QWidget* parent = 0 );
+    /*cancels the loading*/
+    ~BaselineWidget();
+
+    /*returns false if another baseline is still loading*/
+    bool
+    load( const QString& fileName );
+    /*joins shown to the baseline once both are loaded, 0 if no profile is
+     * shown, shown must stay until the next call*/
+    void
+    compare( Connector* shown );
+    /*0 until the join finished*/
+    QSharedPointer<const ProfileDiff>
+    diff() const;
+
+public slots:
+    /*drops the baseline*/
+    void
+    stop();
+
+signals:
+    void
+    diffChanged();
+    /*the message for the status bar*/
+    void
+    loadFailed( QString message );
+
+private slots:
+    void
+    baselineFinished();
+    void
+    diffFinished();
+
+private:
+    Connector*                                          mp_shown;
+    Connector*                                          mp_baseline;
+    Connector*                                          mp_loading;
+    Connector::loadProgress                             m_progress;
+    QFutureWatcher<bool>*                               mp_loadWatcher;
+    QString                                             m_fileName;
+    QString                                             m_loadingFile;
+    QFutureWatcher<QSharedPointer<const ProfileDiff> >* mp_diffWatcher;
+    QSharedPointer<const ProfileDiff>                   m_diff;
+    bool                                                m_diffValid;
+
+    void
+    updateText();
+};
+
+#endif // BASELINEWIDGET_HPP
@@ -0,0 +1,333 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QThread>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QElapsedTimer>
+#include <QTextStream>
+
+#include "batchscore.hpp"
+#include "connector.hpp"
+#include "filterexport.hpp"
+
+namespace
+{
+class scoreJob : public QRunnable
+{
+public:
+    scoreJob( const QString& fileName, BatchScore::result* r ) :
+        m_fileName( fileName ),
+        mp_result( r )
+    {
+    }
+    void
+    run()
+    {
+        mp_result->profile = m_fileName;
+        mp_result->scored  = false;
+        if ( !QFileInfo( m_fileName ).isReadable() )
+        {
+            mp_result->error = "cannot read " + m_fileName;
+            return;
+        }
+        /*the profile is freed with the connection before the next job starts*/
+        Connector connection;
+        if ( !connection.start( m_fileName ) )
+        {
+            mp_result->error = connection.getLoadError();
+            return;
+        }
+        mp_result->sizes = connection.getSizes();
+        QSharedPointer<const dataCenter::groupSnapshot> groups = connection.getGroupData();
+        for ( int i = 0; i < groups->rows.size(); i++ )
+        {
+            if ( groups->rows[ i ].type != "FLT" )
+            {
+                mp_result->groups.append( groups->rows[ i ] );
+            }
+        }
+        mp_result->scored = true;
+    }
+
+private:
+    QString             m_fileName;
+    BatchScore::result* mp_result;
+};
+
+/*all group types in the order they first appear*/
+QVector<std::string>
+groupTypes( const QVector<BatchScore::result>& results )
+{
+    QVector<std::string> types;
+    for ( int i = 0; i < results.size(); i++ )
+    {
+        for ( int j = 0; j < results[ i ].groups.size(); j++ )
+        {
+            if ( !types.contains( results[ i ].groups[ j ].type ) )
+            {
+                types.append( results[ i ].groups[ j ].type );
+            }
+        }
+    }
+    return types;
+}
+
+/*max_buf of the group and its percentage of max_buf of ALL, false if
+ * the profile has no such group*/
+bool
+groupShare( const BatchScore::result& r, const std::string& type, uint64_t* maxBuf, double* share )
+{
+    uint64_t all   = 0;
+    bool     found = false;
+    for ( int i = 0; i < r.groups.size(); i++ )
+    {
+        if ( r.groups[ i ].type == "ALL" )
+        {
+            all = r.groups[ i ].maxBuf;
+        }
+        if ( r.groups[ i ].type == type )
+        {
+            *maxBuf = r.groups[ i ].maxBuf;
+            found   = true;
+        }
+    }
+    *share = found && all > 0 ? 100.0 * *maxBuf / all : 0;
+    return found;
+}
+
+void
+appendCsv( const QString& field, QByteArray* out )
+{
+    QByteArray b = field.toUtf8();
+    if ( !b.contains( ',' ) && !b.contains( '"' ) && !b.contains( '\n' ) )
+    {
+        out->append( b );
+        return;
+    }
+    out->append( '"' );
+    out->append( b.replace( "\"", "\"\"" ) );
+    out->append( '"' );
+}
+}
+
+QStringList
+BatchScore::findProfiles( const QString& directory )
+{
+    QStringList profiles;
+    /*symbolic links are not followed, they might form cycles*/
+    QDirIterator it( directory, QStringList() << "profile.cubex", QDir::Files, QDirIterator::Subdirectories );
+    while ( it.hasNext() )
+    {
+        profiles.append( it.next() );
+    }
+    profiles.sort();
+    return profiles;
+}
+
+QVector<BatchScore::result>
+BatchScore::score( const QStringList& profiles, int jobs )
+{
+    /*every job writes only its own element, the vector is not resized meanwhile*/
+    QVector<result> results( profiles.size() );
+    /*a pool of its own, the loading itself uses the global pool*/
+    QThreadPool     pool;
+    pool.setMaxThreadCount( qMax( 1, jobs ) );
+    for ( int i = 0; i < profiles.size(); i++ )
+    {
+        pool.start( new scoreJob( profiles[ i ], &results[ i ] ) );
+    }
+    pool.waitForDone();
+    return results;
+}
+
+QByteArray
+BatchScore::renderCsv( const QVector<result>& results )
+{
+    QVector<std::string> types = groupTypes( results );
+    QByteArray           out   = "profile,trace_size,max_buf,total_memory";
+    for ( int i = 0; i < types.size(); i++ )
+    {
+        out.append( ',' );
+        out.append( types[ i ].c_str() );
+        out.append( "_max_buf," );
+        out.append( types[ i ].c_str() );
+        out.append( "_share" );
+    }
+    out.append( '\n' );
+    for ( int i = 0; i < results.size(); i++ )
+    {
+        const result& r = results[ i ];
+        appendCsv( r.profile, &out );
+        /*unreadable profiles keep their row with empty fields*/
+        if ( !r.scored )
+        {
+            out.append( QByteArray( 3 + 2 * types.size(), ',' ) );
+            out.append( '\n' );
+            continue;
+        }
+        out.append( ',' + QByteArray::number( ( qulonglong )r.sizes.traceSize ) );
+        out.append( ',' + QByteArray::number( ( qulonglong )r.sizes.maxBuf ) );
+        out.append( ',' + QByteArray::number( ( qulonglong )r.sizes.totalMemory ) );
+        for ( int t = 0; t < types.size(); t++ )
+        {
+            uint64_t maxBuf = 0;
+            double   share  = 0;
+            if ( groupShare( r, types[ t ], &maxBuf, &share ) )
+            {
+                out.append( ',' + QByteArray::number( ( qulonglong )maxBuf ) );
+                out.append( ',' + QByteArray::number( share, 'f', 2 ) );
+            }
+            else
+            {
+                out.append( ",," );
+            }
+        }
+        out.append( '\n' );
+    }
+    return out;
+}
+
+QByteArray
+BatchScore::renderJson( const QVector<result>& results )
+{
+    QVector<std::string> types = groupTypes( results );
+    QByteArray           out   = "[";
+    for ( int i = 0; i < results.size(); i++ )
+    {
+        const result& r = results[ i ];
+        out.append( i == 0 ? "\n  {\"profile\": " : ",\n  {\"profile\": " );
+        FilterExport::appendJson( r.profile.toUtf8().constData(), &out );
+        out.append( ", \"scored\": " );
+        out.append( r.scored ? "true" : "false" );
+        if ( !r.scored )
+        {
+            out.append( ", \"error\": " );
+            FilterExport::appendJson( r.error.toUtf8().constData(), &out );
+        }
+        else
+        {
+            out.append( ", \"trace_size\": " + QByteArray::number( ( qulonglong )r.sizes.traceSize ) );
+            out.append( ", \"max_buf\": " + QByteArray::number( ( qulonglong )r.sizes.maxBuf ) );
+            out.append( ", \"total_memory\": " + QByteArray::number( ( qulonglong )r.sizes.totalMemory ) );
+            out.append( ", \"groups\": {" );
+            bool first = true;
+            for ( int t = 0; t < types.size(); t++ )
+            {
+                uint64_t maxBuf = 0;
+                double   share  = 0;
+                if ( !groupShare( r, types[ t ], &maxBuf, &share ) )
+                {
+                    continue;
+                }
+                out.append( first ? "" : ", " );
+                FilterExport::appendJson( types[ t ], &out );
+                out.append( ": {\"max_buf\": " + QByteArray::number( ( qulonglong )maxBuf ) );
+                out.append( ", \"share\": " + QByteArray::number( share, 'f', 2 ) + "}" );
+                first = false;
+            }
+            out.append( "}" );
+        }
+        out.append( "}" );
+    }
+    out.append( results.isEmpty() ? "]\n" : "\n]\n" );
+    return out;
+}
+
+int
+BatchScore::run( const QStringList& arguments )
+{
+    QTextStream err( stderr );
+    QString     directory;
+    QString     output;
+    /*each job holds a profile and the loading of one is parallel already*/
+    int         jobs  = qMax( 1, QThread::idealThreadCount() / 2 );
+    bool        valid = true;
+    for ( int i = 0; i < arguments.size(); i++ )
+    {
+        bool hasValue = i + 1 < arguments.size();
+        if ( arguments[ i ] == "--batch" && hasValue )
+        {
+            directory = arguments[ ++i ];
+        }
+        else if ( arguments[ i ] == "--jobs" && hasValue )
+        {
+            jobs  = arguments[ ++i ].toInt( &valid );
+            valid = valid && jobs > 0;
+        }
+        else if ( arguments[ i ] == "--output" && hasValue )
+        {
+            output = arguments[ ++i ];
+        }
+        else
+        {
+            valid = false;
+        }
+        if ( !valid )
+        {
+            break;
+        }
+    }
+    if ( !valid || directory.isEmpty() )
+    {
+        err << "usage: scorep-score-gui --batch directory [--jobs n] [--output file.csv|file.json]\n";
+        return 1;
+    }
+
+    QStringList profiles = findProfiles( directory );
+    if ( profiles.isEmpty() )
+    {
+        err << "no profile.cubex below " << directory << "\n";
+        return 1;
+    }
+    QElapsedTimer timer;
+    timer.start();
+    QVector<result> results = score( profiles, jobs );
+    double          seconds = qMax( timer.elapsed(), ( qint64 )1 ) / 1000.0;
+
+    int scored = 0;
+    for ( int i = 0; i < results.size(); i++ )
+    {
+        if ( results[ i ].scored )
+        {
+            scored++;
+        }
+        else
+        {
+            err << results[ i ].error << "\n";
+        }
+    }
+    QByteArray text = output.endsWith( ".json", Qt::CaseInsensitive ) ? renderJson( results ) : renderCsv( results );
+    if ( output.isEmpty() )
+    {
+        QFile out;
+        out.open( stdout, QIODevice::WriteOnly );
+        out.write( text );
+    }
+    else
+    {
+        QString error;
+        if ( !FilterExport::write( output, text, &error ) )
+        {
+            err << error << "\n";
+            return 1;
+        }
+    }
+    err << "scored " << scored << " of " << profiles.size() << " profiles in "
+        << QString::number( seconds, 'f', 1 ) << " s, "
+        << QString::number( scored * 60 / seconds, 'f', 1 ) << " profiles/min\n";
+    return scored == profiles.size() ? 0 : 2;
+}
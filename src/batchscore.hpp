@@ -0,0 +1,67 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#ifndef BATCHSCORE_HPP
+#define BATCHSCORE_HPP
+
+#include <QtGlobal>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QByteArray>
+
+#include "data.hpp"
+
+/*
+ * Scores every profile.cubex below a directory without a window, e.g.
+ * all runs of a parameter study, and writes one table of their sizes.
+ *
+ * The profiles are loaded by a pool of jobs, each job holds one profile
+ * until its sizes are taken, so at most jobs profiles are in memory at
+ * once. Profiles with the same numbers of definitions share their event
+ * sizes, otf2-estimator runs once for them, see SCOREP_Score_Estimator.
+ */
+class BatchScore
+{
+public:
+    struct result
+    {
+        QString                        profile;
+        /*false if the profile could not be read, error says why*/
+        bool                           scored;
+        QString                        error;
+        dataCenter::sizes              sizes;
+        /*the groups of the unfiltered profile, without FLT*/
+        QVector<dataCenter::groupData> groups;
+    };
+
+    /*sorted paths of all profile.cubex files below directory*/
+    static QStringList
+    findProfiles( const QString& directory );
+    /*blocks until all profiles are scored, results in the order of profiles*/
+    static QVector<result>
+    score( const QStringList& profiles,
+           int                jobs );
+
+    /*one row per profile, the groups as max_buf and share of all max_buf*/
+    static QByteArray
+    renderCsv( const QVector<result>& results );
+    static QByteArray
+    renderJson( const QVector<result>& results );
+
+    /*--batch directory [--jobs n] [--output file.csv|file.json],
+     * returns the exit code*/
+    static int
+    run( const QStringList& arguments );
+};
+
+#endif // BATCHSCORE_HPP
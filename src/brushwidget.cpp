@@ -0,0 +1,167 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#include "brushwidget.hpp"
+
+BrushWidget::BrushWidget( QWidget* parent )
+    : QWidget( parent )
+    , mp_connection( 0 )
+    , m_mapValid( false )
+    , m_previewActive( false )
+{
+    mp_density = new DensityWidget( this );
+    mp_label   = new QLabel( this );
+    mp_exclude = new QPushButton( "Exclude brushed", this );
+    mp_include = new QPushButton( "Include brushed", this );
+    mp_exclude->setEnabled( false );
+    mp_include->setEnabled( false );
+    mp_watcher = new QFutureWatcher<QSharedPointer<const DensityMap> >( this );
+
+    QVBoxLayout* layout = new QVBoxLayout( this );
+    QHBoxLayout* row    = new QHBoxLayout();
+    layout->setContentsMargins( 0, 0, 0, 0 );
+    row->addWidget( mp_label );
+    row->addStretch();
+    row->addWidget( mp_exclude );
+    row->addWidget( mp_include );
+    layout->addWidget( mp_density );
+    layout->addLayout( row );
+
+    connect( mp_watcher, SIGNAL( finished() ), this, SLOT( densityFinished() ) );
+    connect( mp_density, SIGNAL( brushed( double, double, double, double ) ),
+             this, SLOT( brushChanged( double, double, double, double ) ) );
+    connect( mp_density, SIGNAL( brushCleared() ), this, SLOT( clearPreview() ) );
+    connect( mp_exclude, SIGNAL( clicked( bool ) ), this, SLOT( excludeClicked() ) );
+    connect( mp_include, SIGNAL( clicked( bool ) ), this, SLOT( includeClicked() ) );
+}
+
+void
+BrushWidget::setFunctions( Connector*                                            connection,
+                           QSharedPointer<const dataCenter::functionSnapshot> functions )
+{
+    mp_connection = connection;
+    m_mapValid    = true;
+    m_map.clear();
+    mp_density->clear( "binning the regions..." );
+    mp_watcher->setFuture( QtConcurrent::run( &DensityMap::build, functions ) );
+}
+
+void
+BrushWidget::clear()
+{
+    clearPreview();
+    mp_connection = 0;
+    m_mapValid    = false;
+    m_map.clear();
+    mp_density->clear();
+}
+
+void
+BrushWidget::densityFinished()
+{
+    if ( !m_mapValid || mp_watcher->isRunning() )
+    {
+        return;
+    }
+    m_map = mp_watcher->result();
+    mp_density->setMap( m_map );
+}
+
+void
+BrushWidget::brushChanged( double minVisits, double maxVisits, double minTime, double maxTime )
+{
+    if ( !m_map )
+    {
+        return;
+    }
+    m_brushed       = m_map->select( minVisits, maxVisits, minTime, maxTime );
+    m_previewActive = true;
+    updatePreview();
+}
+
+void
+BrushWidget::updatePreview()
+{
+    if ( !m_previewActive )
+    {
+        return;
+    }
+    m_preview = mp_connection->previewKeys( m_brushed, true );
+    uint64_t saved = m_preview.before.traceSize - m_preview.after.traceSize;
+    mp_label->setText( QString( "%1 regions brushed, excluding them changes %2 and saves %3 of the trace" )
+                       .arg( m_brushed.size() )
+                       .arg( m_preview.changed )
+                       .arg( mp_connection->getReadableByteNo( saved ) ) );
+    mp_exclude->setEnabled( !m_brushed.isEmpty() );
+    mp_include->setEnabled( !m_brushed.isEmpty() );
+    emit previewChanged();
+}
+
+void
+BrushWidget::clearBrush()
+{
+    mp_density->clearBrush();
+    clearPreview();
+}
+
+void
+BrushWidget::clearPreview()
+{
+    if ( !m_previewActive )
+    {
+        return;
+    }
+    m_previewActive = false;
+    m_brushed.clear();
+    m_preview = Connector::selectionPreview();
+    mp_label->clear();
+    mp_exclude->setEnabled( false );
+    mp_include->setEnabled( false );
+    emit previewChanged();
+}
+
+bool
+BrushWidget::isPreviewActive() const
+{
+    return m_previewActive;
+}
+
+const Connector::selectionPreview&
+BrushWidget::preview() const
+{
+    return m_preview;
+}
+
+Connector::selectionPreview
+BrushWidget::selection( bool exclude ) const
+{
+    /*the exclusion preview carries the sizes of the new state*/
+    return exclude ? m_preview : mp_connection->previewKeys( m_brushed, false );
+}
+
+void
+BrushWidget::excludeClicked()
+{
+    if ( !m_brushed.isEmpty() )
+    {
+        emit changeRequested( true );
+    }
+}
+
+void
+BrushWidget::includeClicked()
+{
+    if ( !m_brushed.isEmpty() )
+    {
+        emit changeRequested( false );
+    }
+}
@@ -0,0 +1,99 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#ifndef BRUSHWIDGET_HPP
+#define BRUSHWIDGET_HPP
+
+#include <QWidget>
+#include <QLabel>
+#include <QPushButton>
+#include <QVBoxLayout>
+#include <QFutureWatcher>
+#include <QtConcurrentRun>
+
+#include "connector.hpp"
+#include "densitywidget.hpp"
+
+/*
+ * Density of visits against time per visit, built in the background for
+ * every new function snapshot. The exclusion of the functions inside the
+ * brushed rectangle is previewed until it is applied or the brush is
+ * removed.
+ */
+class BrushWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    BrushWidget( QWidget* parent = 0 );
+
+    /*bins the functions of connection, which must stay until clear()*/
+    void
+    setFunctions( Connector*                                            connection,
+                  QSharedPointer<const dataCenter::functionSnapshot> functions );
+    /*drops the map and the preview, to be called before the connector
+     * is deleted*/
+    void
+    clear();
+    /*recalculates an active preview for the current filter state*/
+    void
+    updatePreview();
+    /*removes the brush and its preview*/
+    void
+    clearBrush();
+    bool
+    isPreviewActive() const;
+    /*sizes with the brushed functions excluded*/
+    const Connector::selectionPreview&
+    preview() const;
+    /*the change of the brushed functions, to be applied by the caller*/
+    Connector::selectionPreview
+    selection( bool exclude ) const;
+
+signals:
+    /*the size table shows the preview or no longer*/
+    void
+    previewChanged();
+    void
+    changeRequested( bool exclude );
+
+private slots:
+    void
+    densityFinished();
+    void
+    brushChanged( double minVisits,
+                  double maxVisits,
+                  double minTime,
+                  double maxTime );
+    void
+    clearPreview();
+    void
+    excludeClicked();
+    void
+    includeClicked();
+
+private:
+    DensityWidget* mp_density;
+    QLabel*        mp_label;
+    QPushButton*   mp_exclude;
+    QPushButton*   mp_include;
+    Connector*     mp_connection;
+
+    QFutureWatcher<QSharedPointer<const DensityMap> >* mp_watcher;
+    QSharedPointer<const DensityMap>                   m_map;
+    bool                                               m_mapValid;
+    QVector<int>                                       m_brushed;
+    bool                                               m_previewActive;
+    Connector::selectionPreview                        m_preview;
+};
+
+#endif // BRUSHWIDGET_HPP
@@ -0,0 +1,206 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#include <algorithm>
+
+#include "calltree.hpp"
+
+namespace
+{
+/*larger subtrees first, ties keep the call order*/
+struct heavierSubtree
+{
+    const QVector<uint64_t>* subtree;
+
+    bool
+    operator()( int a, int b ) const
+    {
+        if ( ( *subtree )[ a ] != ( *subtree )[ b ] )
+        {
+            return ( *subtree )[ a ] > ( *subtree )[ b ];
+        }
+        return a < b;
+    }
+};
+}
+
+CallTree::CallTree()
+    : m_total( 0 )
+{
+}
+
+QSharedPointer<const CallTree>
+CallTree::build( const std::vector<uint64_t>&    regions,
+                 const std::vector<int64_t>&     parents,
+                 const std::vector<uint64_t>&    bytes,
+                 const std::vector<std::string>& names,
+                 const QVector<int>&             regionFunctions )
+{
+    QSharedPointer<CallTree> tree( new CallTree() );
+    int                      size = regions.size();
+    tree->m_regionFunctions = regionFunctions;
+    tree->m_names.resize( names.size() );
+    for ( size_t i = 0; i < names.size(); i++ )
+    {
+        tree->m_names[ i ] = QString::fromStdString( names[ i ] );
+    }
+    tree->m_region.resize( size );
+    tree->m_parent.resize( size );
+    tree->m_bytes.resize( size );
+    for ( int i = 0; i < size; i++ )
+    {
+        tree->m_region[ i ] = regions[ i ];
+        tree->m_parent[ i ] = parents[ i ];
+        tree->m_bytes[ i ]  = bytes[ i ];
+    }
+
+    /*children follow their parent in preorder, so one backward pass sums
+     * every subtree before its parent is reached*/
+    tree->m_subtree = tree->m_bytes;
+    QVector<int> count( size, 1 );
+    for ( int i = size - 1; i >= 0; i-- )
+    {
+        if ( tree->m_parent[ i ] >= 0 )
+        {
+            tree->m_subtree[ tree->m_parent[ i ] ] += tree->m_subtree[ i ];
+            count[ tree->m_parent[ i ] ]           += count[ i ];
+        }
+        else
+        {
+            tree->m_total += tree->m_subtree[ i ];
+        }
+    }
+    tree->m_end.resize( size );
+    for ( int i = 0; i < size; i++ )
+    {
+        tree->m_end[ i ] = i + count[ i ];
+    }
+
+    /*children per parent, the roots are the children of node size*/
+    tree->m_childOffset.fill( 0, size + 2 );
+    for ( int i = 0; i < size; i++ )
+    {
+        int parent = tree->m_parent[ i ] >= 0 ? tree->m_parent[ i ] : size;
+        tree->m_childOffset[ parent + 1 ]++;
+    }
+    for ( int i = 0; i <= size; i++ )
+    {
+        tree->m_childOffset[ i + 1 ] += tree->m_childOffset[ i ];
+    }
+    QVector<int> fill = tree->m_childOffset;
+    tree->m_children.resize( size );
+    for ( int i = 0; i < size; i++ )
+    {
+        int parent = tree->m_parent[ i ] >= 0 ? tree->m_parent[ i ] : size;
+        tree->m_children[ fill[ parent ]++ ] = i;
+    }
+    heavierSubtree less;
+    less.subtree = &tree->m_subtree;
+    tree->m_row.resize( size );
+    for ( int parent = 0; parent <= size; parent++ )
+    {
+        int* first = tree->m_children.data() + tree->m_childOffset[ parent ];
+        int* last  = tree->m_children.data() + tree->m_childOffset[ parent + 1 ];
+        std::sort( first, last, less );
+        for ( int* it = first; it != last; ++it )
+        {
+            tree->m_row[ *it ] = it - first;
+        }
+    }
+    return tree;
+}
+
+int
+CallTree::size() const
+{
+    return m_region.size();
+}
+
+int
+CallTree::childCount( int node ) const
+{
+    if ( node < 0 )
+    {
+        node = size();
+    }
+    return m_childOffset[ node + 1 ] - m_childOffset[ node ];
+}
+
+int
+CallTree::child( int node, int row ) const
+{
+    if ( node < 0 )
+    {
+        node = size();
+    }
+    return m_children[ m_childOffset[ node ] + row ];
+}
+
+int
+CallTree::parent( int node ) const
+{
+    return m_parent[ node ];
+}
+
+int
+CallTree::row( int node ) const
+{
+    return m_row[ node ];
+}
+
+uint64_t
+CallTree::bytes( int node ) const
+{
+    return m_bytes[ node ];
+}
+
+uint64_t
+CallTree::subtreeBytes( int node ) const
+{
+    return m_subtree[ node ];
+}
+
+uint64_t
+CallTree::totalBytes() const
+{
+    return m_total;
+}
+
+int
+CallTree::function( int node ) const
+{
+    int region = m_region[ node ];
+    return region < m_regionFunctions.size() ? m_regionFunctions[ region ] : -1;
+}
+
+QString
+CallTree::name( int node ) const
+{
+    int region = m_region[ node ];
+    return region < m_names.size() ? m_names[ region ] : QString();
+}
+
+QVector<int>
+CallTree::subtreeFunctions( int node ) const
+{
+    QVector<int> keys;
+    for ( int i = node; i < m_end[ node ]; i++ )
+    {
+        if ( function( i ) >= 0 )
+        {
+            keys.append( function( i ) );
+        }
+    }
+    std::sort( keys.begin(), keys.end() );
+    keys.erase( std::unique( keys.begin(), keys.end() ), keys.end() );
+    return keys;
+}
@@ -0,0 +1,89 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#ifndef CALLTREE_HPP
+#define CALLTREE_HPP
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <QtGlobal>
+#include <QVector>
+#include <QString>
+#include <QSharedPointer>
+
+/*
+ * Call tree of a profile with the estimated trace bytes of every call path.
+ * Nodes are numbered in preorder, so the subtree of a node is the range
+ * [node, end). The children of all nodes share one array and are sorted
+ * by their subtree bytes, every lookup of a tree view is O(1).
+ */
+class CallTree
+{
+public:
+    /*regions, parents and bytes per node in preorder, names per region,
+     * function key of every region or -1 if the region has no row*/
+    static QSharedPointer<const CallTree>
+    build( const std::vector<uint64_t>&    regions,
+           const std::vector<int64_t>&     parents,
+           const std::vector<uint64_t>&    bytes,
+           const std::vector<std::string>& names,
+           const QVector<int>&             regionFunctions );
+
+    int
+    size() const;
+    /*node -1 stands for the invisible root above all roots*/
+    int
+    childCount( int node ) const;
+    int
+    child( int node,
+           int row ) const;
+    /*-1 for the roots*/
+    int
+    parent( int node ) const;
+    /*position among the children of the parent*/
+    int
+    row( int node ) const;
+    uint64_t
+    bytes( int node ) const;
+    uint64_t
+    subtreeBytes( int node ) const;
+    uint64_t
+    totalBytes() const;
+    /*function key of the called region, -1 if it has no row*/
+    int
+    function( int node ) const;
+    QString
+    name( int node ) const;
+    /*sorted keys of all functions called in the subtree of node*/
+    QVector<int>
+    subtreeFunctions( int node ) const;
+
+private:
+    QVector<int>      m_region;
+    QVector<int>      m_parent;
+    QVector<int>      m_end;
+    QVector<int>      m_row;
+    QVector<uint64_t> m_bytes;
+    QVector<uint64_t> m_subtree;
+    uint64_t          m_total;
+    /*children of node n are m_children[ m_childOffset[ n ] ... m_childOffset[ n + 1 ] ),
+     * the roots are stored last, as the children of node size()*/
+    QVector<int>      m_childOffset;
+    QVector<int>      m_children;
+    QVector<QString>  m_names;
+    QVector<int>      m_regionFunctions;
+
+    CallTree();
+};
+
+#endif // CALLTREE_HPP
@@ -0,0 +1,228 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#include "calltreemodel.hpp"
+
+namespace
+{
+QString
+readable( double bytes )
+{
+    const char* units[] = { "B", "kB", "MB", "GB", "TB" };
+    int         unit    = 0;
+    while ( bytes >= 1024 && unit < 4 )
+    {
+        bytes /= 1024;
+        unit++;
+    }
+    return QString::number( bytes, 'f', unit == 0 ? 0 : 1 ) + units[ unit ];
+}
+}
+
+CallTreeModel::CallTreeModel( QObject* parent )
+    : QAbstractItemModel( parent )
+{
+    m_noFilter = dataCenter::noFilterTypes();
+}
+
+void
+CallTreeModel::setTree( QSharedPointer<const CallTree>                     tree,
+                        QSharedPointer<const dataCenter::functionSnapshot> functions,
+                        const FilterState&                                 state )
+{
+    beginResetModel();
+    m_tree      = tree;
+    m_functions = functions;
+    m_state     = state;
+    m_fetchedNodes.clear();
+    m_fetched.clear();
+    if ( m_tree )
+    {
+        /*the roots are shown right away*/
+        m_fetched.fill( 0, m_tree->size() + 1 );
+        m_fetched[ m_tree->size() ] = 1;
+        m_fetchedNodes.append( -1 );
+    }
+    endResetModel();
+}
+
+void
+CallTreeModel::setState( const FilterState& state )
+{
+    m_state = state;
+    if ( !m_tree )
+    {
+        return;
+    }
+    for ( int i = 0; i < m_fetchedNodes.size(); i++ )
+    {
+        int         node   = m_fetchedNodes[ i ];
+        int         count  = m_tree->childCount( node );
+        QModelIndex parent = node < 0 ? QModelIndex() : createIndex( m_tree->row( node ), 0, node );
+        if ( count > 0 )
+        {
+            emit dataChanged( index( 0, REGION, parent ), index( count - 1, REGION, parent ) );
+        }
+    }
+}
+
+int
+CallTreeModel::nodeAt( const QModelIndex& index ) const
+{
+    return index.isValid() ? ( int )index.internalId() : -1;
+}
+
+bool
+CallTreeModel::isFetched( int node ) const
+{
+    return m_fetched[ node < 0 ? m_tree->size() : node ];
+}
+
+QModelIndex
+CallTreeModel::index( int row, int column, const QModelIndex& parent ) const
+{
+    if ( !m_tree || row < 0 || column < 0 || column >= COLUMN_NUM ||
+         row >= m_tree->childCount( nodeAt( parent ) ) )
+    {
+        return QModelIndex();
+    }
+    return createIndex( row, column, m_tree->child( nodeAt( parent ), row ) );
+}
+
+QModelIndex
+CallTreeModel::parent( const QModelIndex& index ) const
+{
+    if ( !m_tree || !index.isValid() )
+    {
+        return QModelIndex();
+    }
+    int parent = m_tree->parent( nodeAt( index ) );
+    if ( parent < 0 )
+    {
+        return QModelIndex();
+    }
+    return createIndex( m_tree->row( parent ), 0, parent );
+}
+
+int
+CallTreeModel::rowCount( const QModelIndex& parent ) const
+{
+    if ( !m_tree || parent.column() > 0 || !isFetched( nodeAt( parent ) ) )
+    {
+        return 0;
+    }
+    return m_tree->childCount( nodeAt( parent ) );
+}
+
+int
+CallTreeModel::columnCount( const QModelIndex& parent ) const
+{
+    Q_UNUSED( parent );
+    return COLUMN_NUM;
+}
+
+bool
+CallTreeModel::hasChildren( const QModelIndex& parent ) const
+{
+    if ( !m_tree || parent.column() > 0 )
+    {
+        return false;
+    }
+    return m_tree->childCount( nodeAt( parent ) ) > 0;
+}
+
+bool
+CallTreeModel::canFetchMore( const QModelIndex& parent ) const
+{
+    return m_tree && parent.column() <= 0 && !isFetched( nodeAt( parent ) ) &&
+           m_tree->childCount( nodeAt( parent ) ) > 0;
+}
+
+void
+CallTreeModel::fetchMore( const QModelIndex& parent )
+{
+    if ( !canFetchMore( parent ) )
+    {
+        return;
+    }
+    int node = nodeAt( parent );
+    beginInsertRows( parent, 0, m_tree->childCount( node ) - 1 );
+    m_fetched[ node ] = 1;
+    m_fetchedNodes.append( node );
+    endInsertRows();
+}
+
+QVariant
+CallTreeModel::data( const QModelIndex& index, int role ) const
+{
+    if ( !m_tree || !index.isValid() )
+    {
+        return QVariant();
+    }
+    int node = nodeAt( index );
+    if ( role == Qt::CheckStateRole && index.column() == REGION )
+    {
+        int key = m_tree->function( node );
+        if ( key < 0 || m_noFilter.contains( QString::fromStdString( m_functions->rows[ key ].type ) ) )
+        {
+            return QVariant();
+        }
+        return m_state.isExcluded( key ) ? Qt::Unchecked : Qt::Checked;
+    }
+    if ( role == Qt::TextAlignmentRole && index.column() != REGION )
+    {
+        return int( Qt::AlignRight | Qt::AlignVCenter );
+    }
+    if ( role != Qt::DisplayRole && role != Qt::ToolTipRole )
+    {
+        return QVariant();
+    }
+    switch ( index.column() )
+    {
+        case REGION:
+            return m_tree->name( node );
+        case BYTES:
+            return readable( m_tree->bytes( node ) );
+        case SUBTREE_BYTES:
+            return readable( m_tree->subtreeBytes( node ) );
+        case SUBTREE_PERCENT:
+            if ( m_tree->totalBytes() == 0 )
+            {
+                return QVariant();
+            }
+            return QString::number( 100.0 * m_tree->subtreeBytes( node ) / m_tree->totalBytes(), 'f', 1 );
+        default:
+            return QVariant();
+    }
+}
+
+QVariant
+CallTreeModel::headerData( int section, Qt::Orientation orientation, int role ) const
+{
+    if ( orientation != Qt::Horizontal || role != Qt::DisplayRole )
+    {
+        return QVariant();
+    }
+    switch ( section )
+    {
+        case REGION:
+            return "call path";
+        case BYTES:
+            return "bytes";
+        case SUBTREE_BYTES:
+            return "subtree bytes";
+        case SUBTREE_PERCENT:
+            return "subtree[%]";
+        default:
+            return "";
+    }
+}
@@ -0,0 +1,88 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#ifndef CALLTREEMODEL_HPP
+#define CALLTREEMODEL_HPP
+
+#include <QAbstractItemModel>
+#include <QSharedPointer>
+#include <QStringList>
+
+#include "calltree.hpp"
+#include "data.hpp"
+#include "filterstate.hpp"
+
+/*
+ * Tree model over the call paths of a CallTree. Children are only handed
+ * to the view when it expands their parent, so the view never walks more
+ * nodes than the user opened. The checkbox shows whether the called region
+ * is filtered, the state itself is owned by the Connector.
+ */
+class CallTreeModel : public QAbstractItemModel
+{
+    Q_OBJECT
+
+public:
+    enum columns { REGION, BYTES, SUBTREE_BYTES, SUBTREE_PERCENT, COLUMN_NUM };
+
+    CallTreeModel( QObject* parent = 0 );
+
+    void
+    setTree( QSharedPointer<const CallTree>                     tree,
+             QSharedPointer<const dataCenter::functionSnapshot> functions,
+             const FilterState&                                 state );
+    /*only repaints the checkboxes of the expanded nodes*/
+    void
+    setState( const FilterState& state );
+    /*call tree node of index, -1 for the invisible root*/
+    int
+    nodeAt( const QModelIndex& index ) const;
+
+    QModelIndex
+    index( int                row,
+           int                column,
+           const QModelIndex& parent = QModelIndex() ) const;
+    QModelIndex
+    parent( const QModelIndex& index ) const;
+    int
+    rowCount( const QModelIndex& parent = QModelIndex() ) const;
+    int
+    columnCount( const QModelIndex& parent = QModelIndex() ) const;
+    bool
+    hasChildren( const QModelIndex& parent = QModelIndex() ) const;
+    bool
+    canFetchMore( const QModelIndex& parent ) const;
+    void
+    fetchMore( const QModelIndex& parent );
+    QVariant
+    data( const QModelIndex& index,
+          int                role = Qt::DisplayRole ) const;
+    QVariant
+    headerData( int             section,
+                Qt::Orientation orientation,
+                int             role = Qt::DisplayRole ) const;
+
+private:
+    QSharedPointer<const CallTree>                     m_tree;
+    QSharedPointer<const dataCenter::functionSnapshot> m_functions;
+    FilterState                                        m_state;
+    QStringList                                        m_noFilter;
+    /*flag per node whose children were handed to the view, the last
+     * entry belongs to the invisible root, and the flagged nodes*/
+    QVector<char> m_fetched;
+    QVector<int>  m_fetchedNodes;
+
+    bool
+    isFetched( int node ) const;
+};
+
+#endif // CALLTREEMODEL_HPP
@@ -0,0 +1,125 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#include <algorithm>
+
+#include "calltreewidget.hpp"
+
+CallTreeWidget::CallTreeWidget( QWidget* parent )
+    : QWidget( parent )
+    , mp_connection( 0 )
+    , m_cancel( 0 )
+{
+    mp_model = new CallTreeModel( this );
+    mp_view  = new QTreeView( this );
+    mp_view->setModel( mp_model );
+    mp_view->setSelectionMode( QAbstractItemView::ExtendedSelection );
+    mp_view->setSelectionBehavior( QAbstractItemView::SelectRows );
+    /*no row measuring, expanding large nodes stays cheap*/
+    mp_view->setUniformRowHeights( true );
+    mp_view->setColumnWidth( CallTreeModel::REGION, 400 );
+    mp_label   = new QLabel( this );
+    mp_exclude = new QPushButton( "Exclude subtrees", this );
+    mp_include = new QPushButton( "Include subtrees", this );
+    mp_watcher = new QFutureWatcher<QSharedPointer<const CallTree> >( this );
+
+    QVBoxLayout* layout = new QVBoxLayout( this );
+    QHBoxLayout* row    = new QHBoxLayout();
+    layout->setContentsMargins( 0, 0, 0, 0 );
+    row->addWidget( mp_label );
+    row->addStretch();
+    row->addWidget( mp_exclude );
+    row->addWidget( mp_include );
+    layout->addWidget( mp_view );
+    layout->addLayout( row );
+
+    connect( mp_watcher, SIGNAL( finished() ), this, SLOT( callTreeFinished() ) );
+    connect( mp_exclude, SIGNAL( clicked( bool ) ), this, SLOT( excludeClicked() ) );
+    connect( mp_include, SIGNAL( clicked( bool ) ), this, SLOT( includeClicked() ) );
+}
+
+void
+CallTreeWidget::load( Connector* connection )
+{
+    if ( m_tree || mp_watcher->isRunning() )
+    {
+        return;
+    }
+    mp_connection = connection;
+    mp_label->setText( "reading the call tree..." );
+    m_cancel.fetchAndStoreRelaxed( 0 );
+    mp_watcher->setFuture( QtConcurrent::run( &Connector::buildCallTree,
+                                              connection->getCallTreeRequest( &m_cancel ) ) );
+}
+
+void
+CallTreeWidget::cancel()
+{
+    /*the call tree is read from the profile of the connector*/
+    m_cancel.fetchAndStoreRelaxed( 1 );
+    mp_watcher->waitForFinished();
+    m_tree.clear();
+    mp_connection = 0;
+    mp_model->setTree( QSharedPointer<const CallTree>(),
+                       QSharedPointer<const dataCenter::functionSnapshot>(), FilterState() );
+    mp_label->clear();
+}
+
+void
+CallTreeWidget::setState( const FilterState& state )
+{
+    mp_model->setState( state );
+}
+
+QVector<int>
+CallTreeWidget::selectedFunctions() const
+{
+    QVector<int> keys;
+    if ( !m_tree )
+    {
+        return keys;
+    }
+    /*selected subtrees may contain each other or call the same regions*/
+    QModelIndexList selection = mp_view->selectionModel()->selectedRows();
+    for ( int i = 0; i < selection.size(); i++ )
+    {
+        keys += m_tree->subtreeFunctions( mp_model->nodeAt( selection[ i ] ) );
+    }
+    std::sort( keys.begin(), keys.end() );
+    keys.erase( std::unique( keys.begin(), keys.end() ), keys.end() );
+    return keys;
+}
+
+void
+CallTreeWidget::callTreeFinished()
+{
+    QSharedPointer<const CallTree> tree = mp_watcher->result();
+    if ( !tree || m_cancel.fetchAndAddRelaxed( 0 ) )
+    {
+        return;
+    }
+    m_tree = tree;
+    mp_model->setTree( tree, mp_connection->getFunctionData(), mp_connection->getFilterState() );
+    mp_label->setText( QString( "%1 call paths" ).arg( tree->size() ) );
+}
+
+void
+CallTreeWidget::excludeClicked()
+{
+    emit changeRequested( true );
+}
+
+void
+CallTreeWidget::includeClicked()
+{
+    emit changeRequested( false );
+}
@@ -0,0 +1,80 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#ifndef CALLTREEWIDGET_HPP
+#define CALLTREEWIDGET_HPP
+
+#include <QWidget>
+#include <QLabel>
+#include <QPushButton>
+#include <QTreeView>
+#include <QVBoxLayout>
+#include <QAtomicInt>
+#include <QFutureWatcher>
+#include <QtConcurrentRun>
+
+#include "connector.hpp"
+#include "calltreemodel.hpp"
+
+/*
+ * Call tree with the bytes of every call path, read from the profile in
+ * the background when it is shown for the first time. Selected subtrees
+ * can be excluded or included as a whole.
+ */
+class CallTreeWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    CallTreeWidget( QWidget* parent = 0 );
+
+    /*starts reading the tree of connection unless it is read or being
+     * read, connection must stay until cancel()*/
+    void
+    load( Connector* connection );
+    /*stops the reading and drops the tree, to be called before the
+     * connector is deleted*/
+    void
+    cancel();
+    /*repaints the checkboxes of the expanded nodes*/
+    void
+    setState( const FilterState& state );
+    /*sorted keys of the functions in the selected subtrees*/
+    QVector<int>
+    selectedFunctions() const;
+
+signals:
+    void
+    changeRequested( bool exclude );
+
+private slots:
+    void
+    callTreeFinished();
+    void
+    excludeClicked();
+    void
+    includeClicked();
+
+private:
+    QTreeView*     mp_view;
+    CallTreeModel* mp_model;
+    QLabel*        mp_label;
+    QPushButton*   mp_exclude;
+    QPushButton*   mp_include;
+    Connector*     mp_connection;
+
+    QFutureWatcher<QSharedPointer<const CallTree> >* mp_watcher;
+    QSharedPointer<const CallTree>                   m_tree;
+    QAtomicInt                                       m_cancel;
+};
+
+#endif // CALLTREEWIDGET_HPP
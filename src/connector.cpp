@@ -10,33 +10,118 @@
  *
  */
 
+#include <algorithm>
+
 #include "connector.hpp"
+#include "filterfile.hpp"
+#include "filtercompression.hpp"
+#include "filterexport.hpp"
 
 Connector::Connector() :
+    m_groupsDirty( true ),
+    m_version( 0 ),
+    m_stateVersion( 0 ),
+    mp_estimator( 0 ),
     m_traceSize( 0 ),
     m_maxBuf( 0 ),
-    m_totalMemory( 0 )
+    m_totalMemory( 0 ),
+    m_traceSizeFlt( 0 ),
+    m_maxBufFlt( 0 ),
+    m_totalMemoryFlt( 0 ),
+    m_fltMaxBuf( 0 ),
+    m_fltVisits( 0 ),
+    m_fltTimeS( 0 ),
+    m_fltTimeP( 0 )
 
 {
-    m_noFilter << "MPI" << "ALL" << "OMP" << "SHMEM";
+    m_noFilter = dataCenter::noFilterTypes();
+    m_changes.allFunctions = false;
 }
 
 Connector::~Connector()
 {
+    /*the profile is the largest part of a connector*/
+    delete mp_estimator;
 }
 
-void
-Connector::start( QString fileName )
+namespace
+{
+/*starts a stage of total steps, false if the loading was cancelled*/
+bool
+enterStage( Connector::loadProgress* progress, int stage, int total )
+{
+    if ( !progress )
+    {
+        return true;
+    }
+    progress->done.fetchAndStoreRelaxed( 0 );
+    progress->total.fetchAndStoreRelaxed( total );
+    progress->stage.fetchAndStoreRelaxed( stage );
+    return !progress->cancel.fetchAndAddRelaxed( 0 );
+}
+
+/*one step of the current stage, checks for cancellation every 1024 steps*/
+bool
+step( Connector::loadProgress* progress, int done )
+{
+    if ( !progress || ( done & 1023 ) != 0 )
+    {
+        return true;
+    }
+    progress->done.fetchAndStoreRelaxed( done );
+    return !progress->cancel.fetchAndAddRelaxed( 0 );
+}
+
+/*rules only change by appending or replacing, which detaches the copies*/
+bool
+sameRules( const QVector<FilterFile::rule>& a, const QVector<FilterFile::rule>& b )
+{
+    return a.size() == b.size() && ( a.isEmpty() || a.constData() == b.constData() );
+}
+
+/*a state of a session file must have been saved for this profile*/
+bool
+fitsProfile( const FilterState& state, int functionNum, int processNum )
+{
+    return state.functionNum() == functionNum &&
+           ( !state.hasProcessTotals() || state.processTotals().size() == processNum );
+}
+}
+
+bool
+Connector::start( QString fileName, loadProgress* progress )
 {
-    m_dataListFunction.clear();
     m_dataListGroup.clear();
+    m_loadError.clear();
+    m_fileName  = fileName;
+    m_functions = QSharedPointer<dataCenter::functionSnapshot>( new dataCenter::functionSnapshot() );
+    QVector<dataCenter::data>& functions = m_functions->rows;
 
+    /*reading the profile cannot be interrupted or measured*/
+    enterStage( progress, OPEN, 0 );
     mp_estimator = new SCOREP_Score_Estimator( fileName.toStdString(), 0 );
-    mp_estimator->calculate( true, true, &m_bufferData );
+    if ( !mp_estimator->isValid() )
+    {
+        m_loadError = "cannot read the profile " + fileName;
+        return false;
+    }
+    /*per process visits of every region ID*/
+    QVector<QHash<int, dataCenter::buffer> > regionBuffers;
+    if ( !enterStage( progress, CLASSIFY, mp_estimator->getRegionNum() ) ||
+         !mp_estimator->calculate( true, true, &regionBuffers,
+                                   progress ? &progress->done : 0,
+                                   progress ? &progress->cancel : 0 ) )
+    {
+        return false;
+    }
 
     mp_estimator->getSizes( &m_traceSize, &m_maxBuf, &m_totalMemory );
 
     /*get function group data*/
+    if ( !enterStage( progress, EXTRACT, mp_estimator->getRegionNum() ) )
+    {
+        return false;
+    }
     for ( uint64_t i = 0; i < mp_estimator->getTypeNum(); i++ )
     {
         if ( mp_estimator->getGroupInformation( i ).maxBuf != -1 )
@@ -59,12 +144,123 @@ Connector::start( QString fileName )
     /*get function data*/
     for ( uint64_t i = 0; i < mp_estimator->getRegionNum(); i++ )
     {
+        if ( !step( progress, ( int )i ) )
+        {
+            return false;
+        }
         dataCenter::data temp = mp_estimator->getRegionInformation( i );
         if ( temp.maxBuf != -1 )
         {
-            m_dataListFunction.append( temp );
+            functions.append( temp );
+        }
+    }
+
+    /*per process bytes of every function, also of functions sharing a name*/
+    if ( !enterStage( progress, AGGREGATE, functions.size() ) )
+    {
+        return false;
+    }
+    m_bufferData.clear();
+    m_bufferData.resize( functions.size() );
+    m_functionBytes.clear();
+    m_functionBytes.resize( functions.size() );
+    m_processTotals.fill( 0, mp_estimator->getProcessNum() );
+    for ( int i = 0; i < functions.size(); i++ )
+    {
+        if ( !step( progress, i ) )
+        {
+            return false;
+        }
+        m_bufferData[ i ] = regionBuffers[ mp_estimator->getRegionId( functions[ i ].key ) ];
+        QHashIterator<int, dataCenter::buffer> it( m_bufferData[ i ] );
+        while ( it.hasNext() )
+        {
+            it.next();
+            dataCenter::processBytes entry;
+            entry.process = it.key();
+            entry.bytes   = it.value().bytesPerVisit * it.value().numberOfVisits;
+            m_functionBytes[ i ].append( entry );
+            m_processTotals[ entry.process ] += entry.bytes;
+        }
+    }
+
+    /*lookup structures of the filter: selection columns, groups and state*/
+    if ( !enterStage( progress, RANK, 0 ) )
+    {
+        return false;
+    }
+    m_state.reset( functions.size() );
+    m_undo.clear();
+    m_redo.clear();
+    m_rules.reset( m_functions );
+    m_undoRules.clear();
+    m_redoRules.clear();
+    m_columns = RegionSelection::build( functions );
+
+    /*functions of every group, the FLT group has none*/
+    QHash<QString, int> groupIndex;
+    for ( int i = 0; i < m_dataListGroup.size() - 1; i++ )
+    {
+        groupIndex.insert( QString::fromStdString( m_dataListGroup[ i ].type ), i );
+    }
+    m_groupFunctions.clear();
+    m_groupFunctions.resize( m_dataListGroup.size() );
+    m_functionGroup.fill( -1, functions.size() );
+    for ( int i = 0; i < functions.size(); i++ )
+    {
+        int group = groupIndex.value( QString::fromStdString( functions[ i ].type ), -1 );
+        m_functionGroup[ i ] = group;
+        if ( group >= 0 )
+        {
+            m_groupFunctions[ group ].append( i );
         }
     }
+    recountFilter();
+
+    /*nothing is filtered yet*/
+    m_traceSizeFlt   = m_traceSize;
+    m_maxBufFlt      = m_maxBuf;
+    m_totalMemoryFlt = m_totalMemory;
+    m_changes.sizes.clear();
+    m_changes.sizes << 0 << 1 << 2;
+
+    /*the function data does not change until the next file is loaded*/
+    m_functions->version = ++m_version;
+    m_stateVersion       = ++m_version;
+    m_groupsDirty        = true;
+    return true;
+}
+
+bool
+Connector::load( Connector* connection, QString fileName, loadProgress* progress )
+{
+    return connection->start( fileName, progress );
+}
+
+QString
+Connector::getLoadError()
+{
+    return m_loadError;
+}
+
+QString
+Connector::stageName( int stage )
+{
+    switch ( stage )
+    {
+        case OPEN:
+            return "opening profile";
+        case CLASSIFY:
+            return "classifying regions";
+        case EXTRACT:
+            return "extracting region data";
+        case AGGREGATE:
+            return "aggregating process data";
+        case RANK:
+            return "preparing filter";
+        default:
+            return "";
+    }
 }
 
 dataCenter::sizes
@@ -87,20 +283,71 @@ Connector::getFilteredSizes()
     return tempSizes;
 }
 
-QList<dataCenter::groupData> Connector::getGroupData()
+QSharedPointer<const dataCenter::groupSnapshot>
+Connector::getGroupData()
+{
+    /*publish a new snapshot only if a group changed since the last one*/
+    if ( m_groupsDirty || !m_groups )
+    {
+        /*remember the changed rows for takeChanges, there are only a few groups*/
+        for ( int i = 0; i < m_dataListGroup.size(); i++ )
+        {
+            if ( !m_groups || m_groups->rows.size() != m_dataListGroup.size() )
+            {
+                m_changes.groups.append( i );
+                continue;
+            }
+            const dataCenter::groupData& before = m_groups->rows[ i ];
+            const dataCenter::groupData& after  = m_dataListGroup[ i ];
+            if ( before.state != after.state || before.maxBuf != after.maxBuf ||
+                 before.visits != after.visits || before.timeS != after.timeS ||
+                 before.timeP != after.timeP || before.timePerVisit != after.timePerVisit )
+            {
+                m_changes.groups.append( i );
+            }
+        }
+        QSharedPointer<dataCenter::groupSnapshot> groups( new dataCenter::groupSnapshot() );
+        groups->version = ++m_version;
+        groups->rows    = m_dataListGroup.toVector();
+        m_groups        = groups;
+        m_groupsDirty   = false;
+    }
+    return m_groups;
+}
+
+QSharedPointer<const dataCenter::functionSnapshot>
+Connector::getFunctionData()
+{
+    if ( !m_functions )
+    {
+        m_functions = QSharedPointer<dataCenter::functionSnapshot>( new dataCenter::functionSnapshot() );
+        m_functions->version = 0;
+    }
+    return m_functions;
+}
+
+bool
+Connector::isIncluded( int key )
 {
-    return m_dataListGroup;
+    return !m_state.isExcluded( key );
 }
 
-QList<dataCenter::data> Connector::getFunctionData()
+uint64_t
+Connector::getStateVersion()
 {
-    return m_dataListFunction;
+    return m_stateVersion;
+}
+
+FilterState
+Connector::getFilterState()
+{
+    return m_state;
 }
 
 bool
 Connector::hasFiltered()
 {
-    if ( m_excludedFunctions.size() == 0 )
+    if ( m_state.excludedCount() == 0 )
     {
         return false;
     }
@@ -161,9 +408,11 @@ Connector::changeState( QList<int> keys, bool groupTable )
 {
     /*instead of rows ->keys*/
     /*return type QString for error messages*/
-    bool               ret = true;
-    QListIterator<int> it( keys );
-    int                key;
+    bool                             ret       = true;
+    const QVector<dataCenter::data>& functions = m_functions->rows;
+    QListIterator<int>               it( keys );
+    int                              key;
+    pushUndo();
     while ( it.hasNext() )
     {
         key = it.next();
@@ -185,16 +434,11 @@ Connector::changeState( QList<int> keys, bool groupTable )
                     if ( tempData.type == "FLT" )
                     {
                         /*include all*/
-                        for ( int i = 0; i < m_dataListFunction.size(); i++ )
+                        for ( int i = 0; i < functions.size(); i++ )
                         {
-                            if ( !m_noFilter.contains( QString::fromStdString( m_dataListFunction[ i ].type ) ) )
+                            if ( !m_noFilter.contains( QString::fromStdString( functions[ i ].type ) ) )
                             {
-                                if ( m_dataListFunction[ i ].included == false )
-                                {
-                                    int index = m_excludedFunctions.indexOf( i );
-                                    m_dataListFunction[ i ].included = true;
-                                    m_excludedFunctions.removeAt( index );
-                                }
+                                setExcluded( i, false );
                             }
                         }
                         for ( int i = 0; i < m_dataListGroup.size(); i++ )
@@ -211,18 +455,10 @@ Connector::changeState( QList<int> keys, bool groupTable )
                     else
                     {
                         /*exclude all functions of this region*/
-                        for ( int i = 0; i < m_dataListFunction.size(); i++ )
+                        const QVector<int>& members = m_groupFunctions[ key ];
+                        for ( int i = 0; i < members.size(); i++ )
                         {
-                            if ( m_dataListFunction[ i ].type == tempData.type )
-                            {
-                                if ( m_dataListFunction[ i ].included == true )
-                                {
-                                    dataCenter::data temp = m_dataListFunction[ i ];
-                                    temp.included = false;
-                                    m_dataListFunction.replace( i, temp );
-                                    m_excludedFunctions.append( i );
-                                }
-                            }
+                            setExcluded( members[ i ], true );
                         }
                     }
                 }
@@ -231,15 +467,11 @@ Connector::changeState( QList<int> keys, bool groupTable )
                     if ( tempData.type == "FLT" )
                     {
                         /*exclude all*/
-                        for ( int i = 0; i < m_dataListFunction.size(); i++ )
+                        for ( int i = 0; i < functions.size(); i++ )
                         {
-                            if ( !m_noFilter.contains( QString::fromStdString( m_dataListFunction[ i ].type ) ) )
+                            if ( !m_noFilter.contains( QString::fromStdString( functions[ i ].type ) ) )
                             {
-                                if ( m_dataListFunction[ i ].included == true )
-                                {
-                                    m_dataListFunction[ i ].included = false;
-                                    m_excludedFunctions.append( i );
-                                }
+                                setExcluded( i, true );
                             }
                         }
                         for ( int i = 0; i < m_dataListGroup.size(); i++ )
@@ -256,19 +488,10 @@ Connector::changeState( QList<int> keys, bool groupTable )
                     else
                     {
                         /*include all functions of this region*/
-                        for ( int i = 0; i < m_dataListFunction.size(); i++ )
+                        const QVector<int>& members = m_groupFunctions[ key ];
+                        for ( int i = 0; i < members.size(); i++ )
                         {
-                            if ( m_dataListFunction[ i ].type == tempData.type )
-                            {
-                                if ( m_dataListFunction[ i ].included == false )
-                                {
-                                    dataCenter::data temp  = m_dataListFunction[ i ];
-                                    int              index = m_excludedFunctions.indexOf( i );
-                                    temp.included = true;
-                                    m_dataListFunction.replace( i, temp );
-                                    m_excludedFunctions.removeAt( index );
-                                }
-                            }
+                            setExcluded( members[ i ], false );
                         }
                     }
                 }
@@ -277,96 +500,433 @@ Connector::changeState( QList<int> keys, bool groupTable )
         else
         {
             /*function*/
-            if ( m_noFilter.contains( QString::fromStdString( m_dataListFunction.at( key ).type ) ) )
+            if ( m_noFilter.contains( QString::fromStdString( functions.at( key ).type ) ) )
             {
                 ret = false;
             }
             else
             {
-                bool same = true;
                 /*switch state*/
-                dataCenter::data tempData = m_dataListFunction.at( key );
-                tempData.included = !tempData.included;
-                m_dataListFunction.replace( key, tempData );
+                setExcluded( key, !m_state.isExcluded( key ) );
+            }
+        }
+    }
+    if ( !groupTable )
+    {
+        /*the groups follow from the number of their excluded functions*/
+        updateGroupStates();
+    }
+    finishEdit();
+    return ret;
+}
 
-                if ( tempData.included == false )
-                {
-                    /*excluded*/
-                    m_excludedFunctions.append( key );
-                }
-                else
-                {
-                    /*included*/
-                    int index = m_excludedFunctions.indexOf( key );
-                    m_excludedFunctions.removeAt( index );
-                }
-                /*check if all functions of this type has the same state*/
-                for ( int i = 0; i < m_dataListFunction.size(); i++ )
-                {
-                    if ( m_dataListFunction[ i ].type == tempData.type )
-                    {
-                        if ( m_dataListFunction[ i ].included != tempData.included )
-                        {
-                            same = false;
-                        }
-                    }
-                }
-                if ( same == true )
-                {
-                    /*all functions of this type has the same state->change group state*/
-                    for ( int i = 0; i < m_dataListGroup.size(); i++ )
-                    {
-                        if ( m_dataListGroup[ i ].type == tempData.type )
-                        {
-                            dataCenter::groupData temp = m_dataListGroup[ i ];
-                            if ( tempData.included )
-                            {
-                                temp.state = dataCenter::INCLUDED;
-                            }
-                            else
-                            {
-                                temp.state = dataCenter::EXCLUDED;
-                            }
+FilterFrontier::input
+Connector::getFrontierInput()
+{
+    FilterFrontier::input in;
+    in.totalTime     = 0;
+    in.processTotals = m_processTotals;
+    in.times.resize( m_functions->rows.size() );
+    in.rows = m_functionBytes;
+    for ( int i = 0; i < m_functions->rows.size(); i++ )
+    {
+        in.times[ i ]  = m_functions->rows[ i ].timeS;
+        in.totalTime  += m_functions->rows[ i ].timeS;
+        if ( !m_noFilter.contains( QString::fromStdString( m_functions->rows[ i ].type ) ) )
+        {
+            in.candidates.append( i );
+        }
+    }
+    return in;
+}
 
-                            m_dataListGroup.replace( i, temp );
-                        }
-                    }
-                }
-                else
-                {
-                    for ( int i = 0; i < m_dataListGroup.size(); i++ )
-                    {
-                        if ( m_dataListGroup[ i ].type == tempData.type )
-                        {
-                            dataCenter::groupData temp = m_dataListGroup[ i ];
-                            temp.state = dataCenter::PARTIAL;
-                            m_dataListGroup.replace( i, temp );
-                        }
-                    }
-                }
+ScalingModel::profile
+Connector::getScalingInput()
+{
+    ScalingModel::profile p;
+    p.fileName   = m_fileName;
+    p.processNum = m_processTotals.size();
+    p.functions  = m_functions;
+    p.rows       = m_functionBytes;
+    return p;
+}
+
+void
+Connector::setExcludedFunctions( const QList<int>& keys )
+{
+    pushUndo();
+    replaceExcluded( keys.toVector() );
+    finishEdit();
+}
+
+void
+Connector::replaceExcluded( const QVector<int>& keys )
+{
+    const QVector<dataCenter::data>& functions = m_functions->rows;
+    m_state.reset( functions.size() );
+    for ( int i = 0; i < keys.size(); i++ )
+    {
+        if ( !m_noFilter.contains( QString::fromStdString( functions[ keys[ i ] ].type ) ) )
+        {
+            m_state.setExcluded( keys[ i ], true );
+        }
+    }
+    recountFilter();
+    updateGroupStates();
+}
+
+int
+Connector::applyFilterFile( const QString& fileName, QString* error )
+{
+    FilterFile filter;
+    if ( !filter.load( fileName, error ) )
+    {
+        return -1;
+    }
+    /*the rules of the file replace the rules and the selection*/
+    pushUndo();
+    m_rules.reset( m_functions, filter.rules() );
+    replaceExcluded( m_rules.excludedKeys() );
+    finishEdit();
+    return m_state.excludedKeys().size();
+}
+
+int
+Connector::takeFilter( QSharedPointer<const dataCenter::functionSnapshot> functions,
+                       const FilterState& state, const QVector<FilterFile::rule>& rules )
+{
+    /*whether any function of a name was excluded, the keys refer to the
+     * strings of the snapshot*/
+    const QVector<dataCenter::data>& old = functions->rows;
+    QHash<QByteArray, bool>          excludedByName;
+    excludedByName.reserve( old.size() );
+    for ( int key = 0; key < old.size(); key++ )
+    {
+        const std::string& name = FilterCompression::matchName( old[ key ] );
+        bool&              e    = excludedByName[ QByteArray::fromRawData( name.data(), ( int )name.size() ) ];
+        e = e || state.isExcluded( key );
+    }
+
+    m_rules.reset( m_functions, rules );
+    const QVector<dataCenter::data>& rows = m_functions->rows;
+    QVector<int>                     keys;
+    for ( int key = 0; key < rows.size(); key++ )
+    {
+        const std::string&                      name = FilterCompression::matchName( rows[ key ] );
+        QHash<QByteArray, bool>::const_iterator it   = excludedByName.constFind( QByteArray::fromRawData( name.data(), ( int )name.size() ) );
+        if ( it == excludedByName.constEnd() ? m_rules.isExcluded( key ) : it.value() )
+        {
+            keys.append( key );
+        }
+    }
+    replaceExcluded( keys );
+    calculateFilter();
+    m_stateVersion = ++m_version;
+    return m_state.excludedKeys().size();
+}
+
+int
+Connector::addFilterRules( const QVector<FilterFile::rule>& rules )
+{
+    const QVector<dataCenter::data>& functions = m_functions->rows;
+    int                              changed   = 0;
+    pushUndo();
+    for ( int i = 0; i < rules.size(); i++ )
+    {
+        /*only the functions whose verdict changed, other edits stay*/
+        QVector<int> keys = m_rules.append( rules[ i ] );
+        for ( int j = 0; j < keys.size(); j++ )
+        {
+            if ( !m_noFilter.contains( QString::fromStdString( functions[ keys[ j ] ].type ) ) &&
+                 setExcluded( keys[ j ], m_rules.isExcluded( keys[ j ] ) ) )
+            {
+                changed++;
+            }
+        }
+    }
+    updateGroupStates();
+    finishEdit();
+    return changed;
+}
+
+QVector<FilterFile::rule>
+Connector::getFilterRules()
+{
+    return m_rules.rules();
+}
+
+QVector<Connector::fileSummary>
+Connector::getFileSummaries()
+{
+    QVector<fileSummary> files( m_rules.fileNum() );
+    for ( int file = 0; file < files.size(); file++ )
+    {
+        const QVector<int>& keys = m_rules.fileFunctions( file );
+        fileSummary&        f    = files[ file ];
+        f.name        = QString::fromStdString( m_rules.fileName( file ) );
+        f.functionNum = keys.size();
+        f.excludedNum = 0;
+        f.maxBuf      = 0;
+        for ( int i = 0; i < keys.size(); i++ )
+        {
+            f.maxBuf += m_functions->rows[ keys[ i ] ].maxBuf;
+            if ( m_state.isExcluded( keys[ i ] ) )
+            {
+                f.excludedNum++;
             }
         }
     }
+    return files;
+}
+
+Connector::history
+Connector::getHistory()
+{
+    history h;
+    h.state     = m_state;
+    h.rules     = m_rules.rules();
+    h.undo      = m_undo;
+    h.redo      = m_redo;
+    h.undoRules = m_undoRules;
+    h.redoRules = m_redoRules;
+    return h;
+}
+
+bool
+Connector::restoreHistory( const history& h )
+{
+    int  functionNum = m_functions->rows.size();
+    bool fits        = fitsProfile( h.state, functionNum, m_processTotals.size() ) &&
+                       h.undo.size() == h.undoRules.size() && h.redo.size() == h.redoRules.size();
+    for ( int i = 0; fits && i < h.undo.size(); i++ )
+    {
+        fits = fitsProfile( h.undo[ i ], functionNum, m_processTotals.size() );
+    }
+    for ( int i = 0; fits && i < h.redo.size(); i++ )
+    {
+        fits = fitsProfile( h.redo[ i ], functionNum, m_processTotals.size() );
+    }
+    if ( !fits )
+    {
+        return false;
+    }
+    m_state     = h.state;
+    m_undo      = h.undo;
+    m_redo      = h.redo;
+    m_undoRules = h.undoRules;
+    m_redoRules = h.redoRules;
+    restoreRules( h.rules );
+    restoreState();
+    return true;
+}
+
+void
+Connector::applyFrontierPoint( const FilterFrontier::result& frontier, int index )
+{
+    /*sizes are taken from the precomputed point, no recalculation needed*/
+    const FilterFrontier::point& p = frontier.points.at( index );
+    QList<int>                   keys;
+    for ( int i = 0; i < p.excludedCount; i++ )
+    {
+        keys.append( frontier.order[ i ] );
+    }
+    setExcludedFunctions( keys );
+    m_state.setSizes( p.traceSize, p.maxBuf );
+    setFilteredValues( p.traceSize, p.maxBuf );
+}
+
+void
+Connector::pushUndo()
+{
+    /*a copy only shares the chunks, see FilterState*/
+    m_undo.append( m_state );
+    m_undoRules.append( m_rules.rules() );
+}
+
+void
+Connector::finishEdit()
+{
+    if ( m_state.sameSelection( m_undo.last() ) && sameRules( m_rules.rules(), m_undoRules.last() ) )
+    {
+        /*nothing changed, keep the sizes and forget the entry*/
+        m_state = m_undo.takeLast();
+        m_undoRules.removeLast();
+    }
+    else
+    {
+        m_redo.clear();
+        m_redoRules.clear();
+    }
     calculateFilter();
-    calculateFilteredSizes();
-    return ret;
+    m_stateVersion = ++m_version;
+}
+
+bool
+Connector::undo()
+{
+    if ( m_undo.isEmpty() )
+    {
+        return false;
+    }
+    m_redo.append( m_state );
+    m_redoRules.append( m_rules.rules() );
+    m_state = m_undo.takeLast();
+    restoreRules( m_undoRules.takeLast() );
+    restoreState();
+    return true;
+}
+
+bool
+Connector::redo()
+{
+    if ( m_redo.isEmpty() )
+    {
+        return false;
+    }
+    m_undo.append( m_state );
+    m_undoRules.append( m_rules.rules() );
+    m_state = m_redo.takeLast();
+    restoreRules( m_redoRules.takeLast() );
+    restoreState();
+    return true;
+}
+
+bool
+Connector::canUndo()
+{
+    return !m_undo.isEmpty();
+}
+
+bool
+Connector::canRedo()
+{
+    return !m_redo.isEmpty();
+}
+
+bool
+Connector::hasFilteredSizes()
+{
+    return m_state.hasSizes();
+}
+
+void
+Connector::restoreRules( const QVector<FilterFile::rule>& rules )
+{
+    if ( !sameRules( rules, m_rules.rules() ) )
+    {
+        m_rules.reset( m_functions, rules );
+    }
+}
+
+void
+Connector::restoreState()
+{
+    recountFilter();
+    updateGroupStates();
+    calculateFilter();
+    m_stateVersion = ++m_version;
+    if ( m_state.hasSizes() )
+    {
+        setFilteredValues( m_state.traceSize(), m_state.maxBuf() );
+    }
+}
+
+void
+Connector::updateGroupStates()
+{
+    /*derive the state of every group from the number of its excluded functions*/
+    for ( int i = 0; i < m_dataListGroup.size(); i++ )
+    {
+        QString type = QString::fromStdString( m_dataListGroup[ i ].type );
+        if ( type == "FLT" || m_noFilter.contains( type ) )
+        {
+            continue;
+        }
+        if ( m_groupExcluded[ i ] == 0 )
+        {
+            m_dataListGroup[ i ].state = dataCenter::INCLUDED;
+        }
+        else if ( m_groupExcluded[ i ] == m_groupFunctions[ i ].size() )
+        {
+            m_dataListGroup[ i ].state = dataCenter::EXCLUDED;
+        }
+        else
+        {
+            m_dataListGroup[ i ].state = dataCenter::PARTIAL;
+        }
+    }
+}
+
+bool
+Connector::setExcluded( int key, bool excluded )
+{
+    if ( !m_state.setExcluded( key, excluded ) )
+    {
+        return false;
+    }
+    /*keep the counters of the groups and the FLT sums up to date*/
+    const dataCenter::data& row  = m_functions->rows[ key ];
+    int                     sign = excluded ? 1 : -1;
+    if ( excluded )
+    {
+        m_fltMaxBuf += row.maxBuf;
+        m_fltVisits += row.visits;
+    }
+    else
+    {
+        m_fltMaxBuf -= row.maxBuf;
+        m_fltVisits -= row.visits;
+    }
+    m_fltTimeS += sign * row.timeS;
+    m_fltTimeP += sign * row.timeP;
+    if ( m_functionGroup[ key ] >= 0 )
+    {
+        m_groupExcluded[ m_functionGroup[ key ] ] += sign;
+    }
+    if ( !m_changes.allFunctions )
+    {
+        m_changes.functions.append( key );
+    }
+    return true;
+}
+
+void
+Connector::recountFilter()
+{
+    /*after the whole state was replaced*/
+    m_groupExcluded.fill( 0, m_dataListGroup.size() );
+    m_fltMaxBuf = 0;
+    m_fltVisits = 0;
+    m_fltTimeS  = 0;
+    m_fltTimeP  = 0;
+    QVector<int> excludedKeys = m_state.excludedKeys();
+    for ( int i = 0; i < excludedKeys.size(); i++ )
+    {
+        const dataCenter::data& row = m_functions->rows[ excludedKeys[ i ] ];
+        m_fltMaxBuf += row.maxBuf;
+        m_fltVisits += row.visits;
+        m_fltTimeS  += row.timeS;
+        m_fltTimeP  += row.timeP;
+        if ( m_functionGroup[ excludedKeys[ i ] ] >= 0 )
+        {
+            m_groupExcluded[ m_functionGroup[ excludedKeys[ i ] ] ]++;
+        }
+    }
+    m_changes.allFunctions = true;
+    m_changes.functions.clear();
 }
 
 void
 Connector::calculateFilter()
 {
-    /*calculates group FLT*/
-    dataCenter::groupData groupFlt;
-    groupFlt.state        = m_dataListGroup.at( m_dataListGroup.size() - 1 ).state;
-    groupFlt.type         = "FLT";
-    groupFlt.maxBuf       = 0;
-    groupFlt.visits       = 0;
-    groupFlt.timeP        = 0;
-    groupFlt.timeS        = 0;
-    groupFlt.timePerVisit = 0;
-    /*delete row filter*/
-    m_dataListGroup.pop_back();
-    if ( m_excludedFunctions.size() == 0 )
+    /*calculates group FLT from the sums kept by setExcluded*/
+    dataCenter::groupData& groupFlt = m_dataListGroup.last();
+    groupFlt.maxBuf       = m_fltMaxBuf;
+    groupFlt.visits       = m_fltVisits;
+    groupFlt.timeP        = m_fltTimeP;
+    groupFlt.timeS        = m_fltTimeS;
+    groupFlt.timePerVisit = m_fltVisits > 0 ? m_fltTimeS / m_fltVisits * 1000000 : 0;
+    if ( m_state.excludedCount() == 0 )
     {
         groupFlt.state = dataCenter::EXCLUDED;
     }
@@ -374,7 +934,7 @@ Connector::calculateFilter()
     {
         bool allExcluded = true;
         /*check if everything possible is excluded or not*/
-        for ( int i = 0; i < m_dataListGroup.size(); i++ )
+        for ( int i = 0; i < m_dataListGroup.size() - 1; i++ )
         {
             if ( m_noFilter.contains( QString::fromStdString( m_dataListGroup[ i ].type ) ) )
             {
@@ -398,86 +958,399 @@ Connector::calculateFilter()
             groupFlt.state = dataCenter::PARTIAL;
         }
     }
-    for ( int i = 0; i < m_excludedFunctions.size(); i++ )
+    m_groupsDirty = true;
+}
+
+void
+Connector::setFilteredValues( uint64_t traceSize, uint64_t maxBuf )
+{
+    /*rows of the size table: trace size, max_buf, total memory*/
+    uint64_t totalMemory = mp_estimator->updateMemory( maxBuf );
+    if ( traceSize != m_traceSizeFlt )
+    {
+        m_changes.sizes.append( 0 );
+    }
+    if ( maxBuf != m_maxBufFlt )
+    {
+        m_changes.sizes.append( 1 );
+    }
+    if ( totalMemory != m_totalMemoryFlt )
     {
-        dataCenter::data temp = m_dataListFunction[ m_excludedFunctions[ i ] ];
-        groupFlt.maxBuf      += temp.maxBuf;
-        groupFlt.visits      += temp.visits;
-        groupFlt.timeP       += temp.timeP;
-        groupFlt.timeS       += temp.timeS;
-        groupFlt.timePerVisit = groupFlt.timeS / groupFlt.visits * 1000000;
+        m_changes.sizes.append( 2 );
     }
-    /*add row filter*/
-    m_dataListGroup.append( groupFlt );
+    m_traceSizeFlt   = traceSize;
+    m_maxBufFlt      = maxBuf;
+    m_totalMemoryFlt = totalMemory;
+}
+
+Connector::changeSet
+Connector::takeChanges()
+{
+    /*publishing the groups records the changed group rows*/
+    getGroupData();
+
+    changeSet changes = m_changes;
+    m_changes.allFunctions = false;
+    m_changes.functions.clear();
+    m_changes.groups.clear();
+    m_changes.sizes.clear();
+    return changes;
 }
 
 bool
-Connector::createFilterFile( QString fileName )
-{
-    bool ret = false;
-    if ( m_excludedFunctions.size() != 0 )
-    {
-        QFile file( fileName );
-        ret = file.open( QIODevice::WriteOnly );
-        QTextStream stream( &file );
-        stream << "#this file is generated bei scorep-score-gui" << endl;
-        stream << "SCOREP_REGION_NAMES_BEGIN" << endl;
-        stream << "    EXCLUDE MANGLED" << endl;
-        for ( int i = 0; i < m_excludedFunctions.size(); i++ )
+Connector::exportFilter( const QString& fileName, bool compress, int* ruleNum, bool* compressed, QString* error )
+{
+    FilterExport::input in;
+    in.functions    = m_functions;
+    in.excludedKeys = m_state.excludedKeys();
+    in.profile      = m_fileName;
+    in.before       = getSizes();
+    bool verified = false;
+    if ( compress )
+    {
+        FilterCompression::result patterns = FilterCompression::compute( m_functions->rows, in.excludedKeys );
+        in.patterns = patterns.patterns;
+        verified    = patterns.verified;
+    }
+    if ( ruleNum )
+    {
+        /*without patterns the filter lists every excluded function*/
+        *ruleNum = in.patterns.isEmpty() ? in.excludedKeys.size() : in.patterns.size();
+    }
+    if ( compressed )
+    {
+        *compressed = verified;
+    }
+    if ( m_state.hasSizes() )
+    {
+        in.after.traceSize = m_state.traceSize();
+        in.after.maxBuf    = m_state.maxBuf();
+    }
+    else
+    {
+        /*the filtered sizes are still on their way*/
+        sizeResult after = computeSizes( m_state );
+        in.after.traceSize = after.traceSize;
+        in.after.maxBuf    = after.maxBuf;
+    }
+    in.after.totalMemory = mp_estimator->updateMemory( in.after.maxBuf );
+    return FilterExport::write( fileName, FilterExport::render( FilterExport::formatOf( fileName ), in ), error );
+}
+
+Connector::sizeRequest
+Connector::getSizeRequest( QAtomicInt* latest )
+{
+    sizeRequest request;
+    request.generation    = latest->fetchAndAddRelaxed( 0 );
+    request.latest        = latest;
+    request.processTotals = m_processTotals;
+    request.rows          = m_functionBytes;
+    request.excluded      = m_state.excludedKeys();
+    return request;
+}
+
+Connector::sizeResult
+Connector::computeFilteredSizes( sizeRequest request )
+{
+    /*runs in a worker thread, gives up as soon as a newer request exists*/
+    sizeResult result;
+    result.generation = request.generation;
+    result.cancelled  = false;
+    result.traceSize  = 0;
+    result.maxBuf     = 0;
+
+    /*start with the unfiltered totals and remove the excluded functions*/
+    QVector<uint64_t>& totals = request.processTotals;
+    for ( int i = 0; i < request.excluded.size(); i++ )
+    {
+        if ( ( i & 1023 ) == 0 &&
+             request.latest->fetchAndAddRelaxed( 0 ) != request.generation )
+        {
+            result.cancelled = true;
+            return result;
+        }
+        const QVector<dataCenter::processBytes>& row = request.rows[ request.excluded[ i ] ];
+        for ( int j = 0; j < row.size(); j++ )
         {
-            stream << "        " << QString::fromStdString( m_dataListFunction[ m_excludedFunctions[ i ] ].mangledName ) << endl;
+            totals[ row[ j ].process ] -= row[ j ].bytes;
         }
-        stream << "SCOREP_REGION_NAMES_END" << endl;
-        file.close();
     }
-    return ret;
+    for ( int i = 0; i < totals.size(); i++ )
+    {
+        result.traceSize += totals[ i ];
+        result.maxBuf     = qMax( result.maxBuf, totals[ i ] );
+    }
+    result.processTotals = totals;
+    return result;
+}
+
+void
+Connector::setFilteredSizes( const sizeResult& result )
+{
+    /*share unchanged chunks of the totals with the previous history entry*/
+    const FilterState* previous = 0;
+    if ( !m_undo.isEmpty() && m_undo.last().hasProcessTotals() )
+    {
+        previous = &m_undo.last();
+    }
+    m_state.setSizes( result.processTotals, result.traceSize, result.maxBuf, previous );
+    setFilteredValues( result.traceSize, result.maxBuf );
+}
+
+Connector::sizeResult
+Connector::computeSizes( const FilterState& state )
+{
+    /*synchronous, the generation never changes*/
+    QAtomicInt  latest( 0 );
+    sizeRequest request;
+    request.generation    = 0;
+    request.latest        = &latest;
+    request.processTotals = m_processTotals;
+    request.rows          = m_functionBytes;
+    request.excluded      = state.excludedKeys();
+    return computeFilteredSizes( request );
+}
+
+Connector::selectionPreview
+Connector::previewSelection( const QList<RegionSelection::rule>& rules, bool exclude )
+{
+    return previewKeys( RegionSelection::evaluate( m_columns, rules ), exclude );
+}
+
+Connector::selectionPreview
+Connector::previewKeys( const QVector<int>& keys, bool exclude )
+{
+    const QVector<dataCenter::data>& functions = m_functions->rows;
+    selectionPreview                 preview;
+    preview.keys    = keys;
+    preview.exclude = exclude;
+    preview.changed = 0;
+
+    /*the copy shares all chunks the selection does not touch*/
+    FilterState state = m_state;
+    for ( int i = 0; i < preview.keys.size(); i++ )
+    {
+        int key = preview.keys[ i ];
+        if ( !m_noFilter.contains( QString::fromStdString( functions[ key ].type ) ) &&
+             state.setExcluded( key, exclude ) )
+        {
+            preview.changed++;
+        }
+    }
+    if ( m_state.hasSizes() )
+    {
+        preview.before.generation = 0;
+        preview.before.cancelled  = false;
+        preview.before.traceSize  = m_state.traceSize();
+        preview.before.maxBuf     = m_state.maxBuf();
+    }
+    else
+    {
+        preview.before = computeSizes( m_state );
+    }
+    preview.after = preview.changed > 0 ? computeSizes( state ) : preview.before;
+    return preview;
+}
+
+uint64_t
+Connector::getTotalMemory( uint64_t maxBuf )
+{
+    return mp_estimator->updateMemory( maxBuf );
 }
 
 void
-Connector::calculateFilteredSizes()
+Connector::applySelection( const selectionPreview& preview )
 {
-    uint64_t                                                traceSize = 0;
-    QHashIterator<QString, QHash<int, dataCenter::buffer> > it( m_bufferData );
-    QList <int>                                             procList;
-    bool                                                    included;
+    excludeFunctions( preview.keys, preview.exclude );
+    if ( preview.changed > 0 && !preview.after.processTotals.isEmpty() )
+    {
+        /*the preview already calculated the sizes of exactly this state*/
+        setFilteredSizes( preview.after );
+    }
+}
+
+bool
+Connector::getProcessBytes( int key, QVector<uint64_t>* bytes )
+{
+    if ( key >= 0 )
+    {
+        /*only the processes that visited the function have an entry*/
+        const QVector<dataCenter::processBytes>& row = m_functionBytes[ key ];
+        bytes->fill( 0, m_processTotals.size() );
+        for ( int i = 0; i < row.size(); i++ )
+        {
+            ( *bytes )[ row[ i ].process ] = row[ i ].bytes;
+        }
+        return true;
+    }
+    if ( m_state.excludedCount() == 0 )
+    {
+        *bytes = m_processTotals;
+        return true;
+    }
+    if ( m_state.hasProcessTotals() )
+    {
+        *bytes = m_state.processTotals();
+        return true;
+    }
+    return false;
+}
+
+Connector::detailRequest
+Connector::getDetailRequest( int key, int topNum, QAtomicInt* latest )
+{
+    detailRequest request;
+    request.key        = key;
+    request.generation = latest->fetchAndAddRelaxed( 0 );
+    request.latest     = latest;
+    request.estimator  = mp_estimator;
+    request.region     = m_functions->rows[ key ].key;
+    request.visits     = m_bufferData[ key ];
+    request.processNum = m_processTotals.size();
+    request.topNum     = topNum;
+    return request;
+}
+
+namespace
+{
+bool
+moreBytes( const dataCenter::regionProcess& a, const dataCenter::regionProcess& b )
+{
+    if ( a.bytes != b.bytes )
+    {
+        return a.bytes > b.bytes;
+    }
+    return a.process < b.process;
+}
+}
+
+Connector::regionDetail
+Connector::computeRegionDetail( detailRequest request )
+{
+    /*runs in a worker thread, gives up as soon as another function is selected*/
+    regionDetail result;
+    result.key         = request.key;
+    result.generation  = request.generation;
+    result.cancelled   = false;
+    result.processNum  = request.processNum;
+    result.visitingNum = request.visits.size();
+    result.maxVisits   = 0;
+    result.maxBytes    = 0;
+    result.maxTime     = 0;
+    result.meanVisits  = 0;
+    result.meanBytes   = 0;
+    result.meanTime    = 0;
+
+    /*only the sparse row of this function is read from the profile*/
+    QVector<dataCenter::regionProcess> processes;
+    processes.reserve( request.visits.size() );
+    QHashIterator<int, dataCenter::buffer> it( request.visits );
     while ( it.hasNext() )
     {
-        it.next();
-        /*check state, only calculate included*/
-        included = true;
-        for ( int i = 0; i < m_excludedFunctions.size(); i++ )
+        if ( ( processes.size() & 255 ) == 0 &&
+             request.latest->fetchAndAddRelaxed( 0 ) != request.generation )
         {
-            if ( it.key() == QString::fromStdString( m_dataListFunction[ m_excludedFunctions[ i ] ].region ) )
-            {
-                included = false;
-            }
+            result.cancelled = true;
+            return result;
         }
-        if ( included )
+        it.next();
+        dataCenter::regionProcess entry;
+        entry.process = it.key();
+        entry.visits  = it.value().numberOfVisits;
+        entry.bytes   = it.value().numberOfVisits * it.value().bytesPerVisit;
+        entry.time    = request.estimator->getRegionTime( request.region, entry.process );
+        processes.append( entry );
+
+        result.maxVisits   = qMax( result.maxVisits, entry.visits );
+        result.maxBytes    = qMax( result.maxBytes, entry.bytes );
+        result.maxTime     = qMax( result.maxTime, entry.time );
+        result.meanVisits += entry.visits;
+        result.meanBytes  += entry.bytes;
+        result.meanTime   += entry.time;
+    }
+    if ( result.processNum > 0 )
+    {
+        result.meanVisits /= result.processNum;
+        result.meanBytes  /= result.processNum;
+        result.meanTime   /= result.processNum;
+    }
+
+    int topNum = qMin( request.topNum, processes.size() );
+    std::partial_sort( processes.begin(), processes.begin() + topNum, processes.end(), moreBytes );
+    result.top = processes.mid( 0, topNum );
+    return result;
+}
+
+bool
+Connector::getMaxBufProcess( int key, int* process, uint64_t* total, uint64_t* bytes )
+{
+    QVector<uint64_t> totals;
+    if ( !getProcessBytes( -1, &totals ) || totals.isEmpty() )
+    {
+        return false;
+    }
+    *process = 0;
+    for ( int i = 1; i < totals.size(); i++ )
+    {
+        if ( totals[ i ] > totals[ *process ] )
         {
-            /*iterate through processes of this function*/
-            QHashIterator<int, dataCenter::buffer> innerIt( it.value() );
-            while ( innerIt.hasNext() )
-            {
-                innerIt.next();
-                traceSize += innerIt.value().bytesPerVisit * innerIt.value().numberOfVisits;
-                while ( innerIt.key() > procList.size() - 1 )
-                {
-                    procList.append( 0 );
-                }
-                procList[ innerIt.key() ] += innerIt.value().bytesPerVisit * innerIt.value().numberOfVisits;
-            }
+            *process = i;
         }
     }
-    int tempMaxBuf = 0;
-    for ( int i = 0; i < procList.size(); i++ )
+    *total = totals[ *process ];
+    dataCenter::buffer b = m_bufferData[ key ].value( *process, dataCenter::buffer() );
+    *bytes = b.numberOfVisits * b.bytesPerVisit;
+    return true;
+}
+
+Connector::callTreeRequest
+Connector::getCallTreeRequest( QAtomicInt* cancel )
+{
+    callTreeRequest request;
+    request.estimator = mp_estimator;
+    request.cancel    = cancel;
+    request.regionFunctions.fill( -1, mp_estimator->getRegionNum() );
+    const QVector<dataCenter::data>& functions = m_functions->rows;
+    for ( int i = 0; i < functions.size(); i++ )
     {
-        tempMaxBuf = qMax( tempMaxBuf, procList[ i ] );
+        request.regionFunctions[ mp_estimator->getRegionId( functions[ i ].key ) ] = i;
     }
-    m_maxBufFlt      = tempMaxBuf;
-    m_traceSizeFlt   = traceSize;
-    m_totalMemoryFlt = mp_estimator->updateMemory( m_maxBufFlt );
+    return request;
+}
+
+QSharedPointer<const CallTree>
+Connector::buildCallTree( callTreeRequest request )
+{
+    std::vector<uint64_t>    regions;
+    std::vector<int64_t>     parents;
+    std::vector<uint64_t>    bytes;
+    std::vector<std::string> names;
+    if ( !request.estimator->getCallTree( &regions, &parents, &bytes, &names, request.cancel ) )
+    {
+        return QSharedPointer<const CallTree>();
+    }
+    return CallTree::build( regions, parents, bytes, names, request.regionFunctions );
 }
 
+int
+Connector::excludeFunctions( const QVector<int>& keys, bool exclude )
+{
+    const QVector<dataCenter::data>& functions = m_functions->rows;
+    int                              changed   = 0;
+    pushUndo();
+    for ( int i = 0; i < keys.size(); i++ )
+    {
+        int key = keys[ i ];
+        if ( !m_noFilter.contains( QString::fromStdString( functions[ key ].type ) ) &&
+             setExcluded( key, exclude ) )
+        {
+            changed++;
+        }
+    }
+    updateGroupStates();
+    finishEdit();
+    return changed;
+}
 
 QString
 Connector::seperate( int number )
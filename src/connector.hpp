@@ -19,8 +19,18 @@
 #include <QDebug>
 #include <QProcess>
 #include <QFile>
+#include <QSet>
+#include <QVector>
+#include <QAtomicInt>
+#include <QSharedPointer>
 
 #include "score/SCOREP_Score_Estimator.hpp"
+#include "frontier.hpp"
+#include "filterstate.hpp"
+#include "regionselection.hpp"
+#include "calltree.hpp"
+#include "filterrules.hpp"
+#include "scalingmodel.hpp"
 
 class SCOREP_Score_Estimator;
 
@@ -28,36 +38,301 @@ class SCOREP_Score_Estimator;
 class Connector
 {
 public:
+    /*everything the filtered size calculation needs, detached from the connector*/
+    struct sizeRequest
+    {
+        int                                         generation;
+        QAtomicInt*                                 latest;
+        QVector<uint64_t>                           processTotals;
+        QVector<int>                                excluded;
+        QVector<QVector<dataCenter::processBytes> > rows;
+    };
+    struct sizeResult
+    {
+        int               generation;
+        bool              cancelled;
+        uint64_t          traceSize;
+        uint64_t          maxBuf;
+        QVector<uint64_t> processTotals;
+    };
+    /*rows and cells that changed since the last takeChanges()*/
+    struct changeSet
+    {
+        /*the whole state was replaced, e.g. by undo*/
+        bool         allFunctions;
+        QVector<int> functions;
+        QVector<int> groups;
+        /*rows of the size table: trace size, max_buf, total memory*/
+        QVector<int> sizes;
+    };
+    /*outcome of a rule based selection before it is applied*/
+    struct selectionPreview
+    {
+        QVector<int> keys;
+        bool         exclude;
+        /*number of functions whose state would change*/
+        int          changed;
+        sizeResult   before;
+        sizeResult   after;
+    };
+
+    /*per process data of one function, fetched on demand in a worker thread*/
+    struct detailRequest
+    {
+        int                            key;
+        int                            generation;
+        QAtomicInt*                    latest;
+        SCOREP_Score_Estimator*        estimator;
+        /*index of the function in the estimator*/
+        int                            region;
+        /*only the processes that visited the function*/
+        QHash<int, dataCenter::buffer> visits;
+        int                            processNum;
+        int                            topNum;
+    };
+    struct regionDetail
+    {
+        int                                key;
+        int                                generation;
+        bool                               cancelled;
+        int                                processNum;
+        int                                visitingNum;
+        /*processes with the most bytes, largest first*/
+        QVector<dataCenter::regionProcess> top;
+        uint64_t                           maxVisits;
+        uint64_t                           maxBytes;
+        double                             maxTime;
+        /*means over all processes, including the ones without visits*/
+        double                             meanVisits;
+        double                             meanBytes;
+        double                             meanTime;
+    };
+
+    /*functions of one source file*/
+    struct fileSummary
+    {
+        QString  name;
+        int      functionNum;
+        int      excludedNum;
+        uint64_t maxBuf;
+    };
+
+    /*filter and history of a session, see SessionFile*/
+    struct history
+    {
+        FilterState                       state;
+        QVector<FilterFile::rule>         rules;
+        QList<FilterState>                undo;
+        QList<FilterState>                redo;
+        QList<QVector<FilterFile::rule> > undoRules;
+        QList<QVector<FilterFile::rule> > redoRules;
+    };
+
+    /*the call tree is read from the shared estimator in a worker thread*/
+    struct callTreeRequest
+    {
+        SCOREP_Score_Estimator* estimator;
+        /*function key of every region ID of the profile, -1 if it has none*/
+        QVector<int>            regionFunctions;
+        QAtomicInt*             cancel;
+    };
+
+    enum loadStage { OPEN, CLASSIFY, EXTRACT, AGGREGATE, RANK, LOAD_STAGE_NUM };
+    /*written by the loading thread and polled by the GUI, done counts
+     * the steps of the current stage, total is 0 if it cannot be measured*/
+    struct loadProgress
+    {
+        QAtomicInt stage;
+        QAtomicInt done;
+        QAtomicInt total;
+        QAtomicInt cancel;
+    };
+
     Connector();
     ~Connector();
 
-    void
-    start( QString fileName );
+    /*false if the loading was cancelled through progress or the profile
+     * could not be opened, getLoadError() tells which*/
+    bool
+    start( QString       fileName,
+           loadProgress* progress = 0 );
+    /*why start() failed, empty if it succeeded or was cancelled*/
+    QString
+    getLoadError();
+    /*runs in a worker thread, nothing else may use connection meanwhile*/
+    static bool
+    load( Connector*    connection,
+          QString       fileName,
+          loadProgress* progress );
+    static QString
+    stageName( int stage );
     dataCenter::sizes
     getSizes();
 
-    QList<dataCenter::groupData>
+    /*snapshots are shared, callers must not keep references across a reload*/
+    QSharedPointer<const dataCenter::groupSnapshot>
     getGroupData();
 
-    QList<dataCenter::data>
+    QSharedPointer<const dataCenter::functionSnapshot>
     getFunctionData();
     bool
+    isIncluded( int key );
+    /*changes whenever a function is included or excluded*/
+    uint64_t
+    getStateVersion();
+    /*cheap copy, shares the chunks with the connector*/
+    FilterState
+    getFilterState();
+    /*also publishes the group snapshot the changed group rows refer to*/
+    changeSet
+    takeChanges();
+    bool
     changeState( QList<int> keys,
                  bool       groupTable );
     bool
     hasFiltered();
     dataCenter::sizes
     getFilteredSizes();
+    /*writes the excluded functions as a filter, a region list or a JSON
+     * report depending on the suffix, see FilterExport. compress writes
+     * verified wildcard patterns instead of one line per function,
+     * ruleNum returns the number of written lines and compressed whether
+     * they are patterns, false if compress fell back to the names*/
     bool
-    createFilterFile( QString fileName );
+    exportFilter( const QString& fileName,
+                  bool           compress,
+                  int*           ruleNum,
+                  bool*          compressed,
+                  QString*       error );
     QString
     getReadableByteNo( uint64_t bytes );
+    FilterFrontier::input
+    getFrontierInput();
+    /*shares the snapshot and the per process bytes*/
+    ScalingModel::profile
+    getScalingInput();
+    void
+    setExcludedFunctions( const QList<int>& keys );
+    /*replaces the state by the functions a Score-P filter file excludes,
+     * returns the number of excluded functions or -1 on errors*/
+    int
+    applyFilterFile( const QString& fileName,
+                     QString*       error );
+    /*appends file or region rules as one edit, only the functions whose
+     * verdict changed are updated, returns their number*/
+    int
+    addFilterRules( const QVector<FilterFile::rule>& rules );
+    QVector<FilterFile::rule>
+    getFilterRules();
+    QVector<fileSummary>
+    getFileSummaries();
+    /*takes the filter of another profile of the program, e.g. of the file
+     * before it was rewritten. Functions of a name excluded there are
+     * excluded, functions new to this profile follow the rules. Starts
+     * without history, returns the number of excluded functions*/
+    int
+    takeFilter( QSharedPointer<const dataCenter::functionSnapshot> functions,
+                const FilterState&                                 state,
+                const QVector<FilterFile::rule>&                   rules );
+    history
+    getHistory();
+    /*replaces filter, rules and history, the stored filtered sizes are
+     * taken over without calculation. false if h does not fit the
+     * functions of the profile*/
+    bool
+    restoreHistory( const history& h );
+    void
+    applyFrontierPoint( const FilterFrontier::result& frontier,
+                        int                           index );
+    sizeRequest
+    getSizeRequest( QAtomicInt* latest );
+    static sizeResult
+    computeFilteredSizes( sizeRequest request );
+    void
+    setFilteredSizes( const sizeResult& result );
+    /*false if the sizes of the current state still have to be calculated*/
+    bool
+    hasFilteredSizes();
+    bool
+    undo();
+    bool
+    redo();
+    bool
+    canUndo();
+    bool
+    canRedo();
+    selectionPreview
+    previewSelection( const QList<RegionSelection::rule>& rules,
+                      bool                                exclude );
+    /*preview of changing an explicit set of keys*/
+    selectionPreview
+    previewKeys( const QVector<int>& keys,
+                 bool                exclude );
+    /*SCOREP_TOTAL_MEMORY needed for a max_buf*/
+    uint64_t
+    getTotalMemory( uint64_t maxBuf );
+    /*one filter update and one history entry for the whole selection*/
+    void
+    applySelection( const selectionPreview& preview );
+    /*bytes per process of one function or of all included functions if
+     * key < 0, false while the filtered totals are not calculated yet*/
+    bool
+    getProcessBytes( int                key,
+                     QVector<uint64_t>* bytes );
+    /*everything computeRegionDetail needs, the estimator is shared and must
+     * not be used by anyone else while the request is computed*/
+    detailRequest
+    getDetailRequest( int         key,
+                      int         topNum,
+                      QAtomicInt* latest );
+    static regionDetail
+    computeRegionDetail( detailRequest request );
+    /*process defining the current max_buf and the bytes of function key
+     * on it, false while the filtered totals are not calculated yet*/
+    bool
+    getMaxBufProcess( int       key,
+                      int*      process,
+                      uint64_t* total,
+                      uint64_t* bytes );
+    callTreeRequest
+    getCallTreeRequest( QAtomicInt* cancel );
+    /*null if the request was cancelled*/
+    static QSharedPointer<const CallTree>
+    buildCallTree( callTreeRequest request );
+    /*excludes or includes all keys as one edit, returns the number of changed functions*/
+    int
+    excludeFunctions( const QVector<int>& keys,
+                      bool                exclude );
 
 private:
-    QHash<QString, QHash<int, dataCenter::buffer> > m_bufferData;//QHash<functionName, QHash<procNr, buffer> >
-    QList<int>                                      m_excludedFunctions;
+    QString                                         m_fileName;
+    QString                                         m_loadError;
+    QVector<QHash<int, dataCenter::buffer> >        m_bufferData;//QVector<QHash<procNr, buffer> > by function key
     QList<dataCenter::groupData>                    m_dataListGroup;
-    QList<dataCenter::data>                         m_dataListFunction;
+    QSharedPointer<dataCenter::functionSnapshot>    m_functions;
+    QSharedPointer<const dataCenter::groupSnapshot> m_groups;
+    bool                                            m_groupsDirty;
+    FilterState                                     m_state;
+    QList<FilterState>                              m_undo;
+    QList<FilterState>                              m_redo;
+    /*rules added in the GUI or loaded from a file, their history follows m_undo*/
+    FilterRules                                     m_rules;
+    QList<QVector<FilterFile::rule> >               m_undoRules;
+    QList<QVector<FilterFile::rule> >               m_redoRules;
+    uint64_t                                        m_version;
+    uint64_t                                        m_stateVersion;
+    /*per process bytes of every function, indexed by key*/
+    QVector<QVector<dataCenter::processBytes> >     m_functionBytes;
+    /*unfiltered bytes per process*/
+    QVector<uint64_t>                               m_processTotals;
+    /*column wise copy of the function data for the selection rules*/
+    RegionSelection::columns                        m_columns;
+    /*group index of every function and functions of every group*/
+    QVector<int>                                    m_functionGroup;
+    QVector<QVector<int> >                          m_groupFunctions;
+    /*number of excluded functions per group*/
+    QVector<int>                                    m_groupExcluded;
+    changeSet                                       m_changes;
 
     /*instance of estimator*/
     SCOREP_Score_Estimator* mp_estimator;
@@ -70,6 +345,12 @@ private:
     uint64_t m_maxBufFlt;
     uint64_t m_totalMemoryFlt;
 
+    /*sums of the excluded functions, the values of group FLT*/
+    uint64_t m_fltMaxBuf;
+    uint64_t m_fltVisits;
+    double   m_fltTimeS;
+    double   m_fltTimeP;
+
     QStringList m_noFilter;
 
     dataCenter::groupData
@@ -77,7 +358,28 @@ private:
     void
     calculateFilter();
     void
-    calculateFilteredSizes();
+    updateGroupStates();
+    bool
+    setExcluded( int  key,
+                 bool excluded );
+    void
+    recountFilter();
+    /*replaces the state, without history*/
+    void
+    replaceExcluded( const QVector<int>& keys );
+    void
+    restoreRules( const QVector<FilterFile::rule>& rules );
+    void
+    setFilteredValues( uint64_t traceSize,
+                       uint64_t maxBuf );
+    void
+    pushUndo();
+    void
+    finishEdit();
+    void
+    restoreState();
+    sizeResult
+    computeSizes( const FilterState& state );
     QString
     seperate( int number );
     uint64_t
@@ -13,13 +13,17 @@
 #ifndef DATA_HPP
 #define DATA_HPP
 
+#include <stdint.h>
+#include <string>
+#include <QVector>
+#include <QStringList>
+
 class dataCenter
 {
 public:
     enum states { INCLUDED, EXCLUDED, PARTIAL };
     struct data
     {
-        bool        included;
         int         key;
         std::string type;
         int         maxBuf;
@@ -29,6 +33,7 @@ public:
         double      timePerVisit;
         std::string region;
         std::string mangledName;
+        std::string fileName;
     };
     struct groupData
     {
@@ -53,6 +58,36 @@ public:
         uint64_t maxBuf;
         uint64_t totalMemory;
     };
+    struct processBytes
+    {
+        int      process;
+        uint64_t bytes;
+    };
+    struct regionProcess
+    {
+        int      process;
+        uint64_t visits;
+        uint64_t bytes;
+        double   time;
+    };
+    /*published data is never modified, a change creates a new version*/
+    struct functionSnapshot
+    {
+        uint64_t      version;
+        QVector<data> rows;
+    };
+    struct groupSnapshot
+    {
+        uint64_t           version;
+        QVector<groupData> rows;
+    };
+
+    /*types of the groups and functions that Score-P never filters*/
+    static QStringList
+    noFilterTypes()
+    {
+        return QStringList() << "MPI" << "ALL" << "OMP" << "SHMEM";
+    }
 };
 
 
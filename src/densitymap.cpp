@@ -0,0 +1,183 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#include <math.h>
+#include <algorithm>
+
+#include <QStringList>
+
+#include "densitymap.hpp"
+
+namespace
+{
+struct fewerVisits
+{
+    const QVector<dataCenter::data>* rows;
+
+    bool
+    operator()( int a, int b ) const
+    {
+        if ( ( *rows )[ a ].visits != ( *rows )[ b ].visits )
+        {
+            return ( *rows )[ a ].visits < ( *rows )[ b ].visits;
+        }
+        return a < b;
+    }
+};
+
+/*bin of value in [min, max] divided into num bins*/
+int
+bin( double value, double min, double max, int num )
+{
+    int result = ( int )( ( value - min ) / ( max - min ) * num );
+    return qBound( 0, result, num - 1 );
+}
+}
+
+DensityMap::DensityMap()
+    : m_maxCount( 0 )
+    , m_minLogVisits( 0 )
+    , m_maxLogVisits( 1 )
+    , m_minLogTime( 0 )
+    , m_maxLogTime( 1 )
+{
+}
+
+QSharedPointer<const DensityMap>
+DensityMap::build( QSharedPointer<const dataCenter::functionSnapshot> functions )
+{
+    QSharedPointer<DensityMap>       map( new DensityMap() );
+    const QVector<dataCenter::data>& rows = functions->rows;
+    QStringList                      noFilter = dataCenter::noFilterTypes();
+
+    /*only functions that were visited and may be filtered*/
+    for ( int i = 0; i < rows.size(); i++ )
+    {
+        if ( rows[ i ].visits > 0 && !noFilter.contains( QString::fromStdString( rows[ i ].type ) ) )
+        {
+            map->m_keys.append( i );
+        }
+    }
+    fewerVisits less;
+    less.rows = &rows;
+    std::sort( map->m_keys.begin(), map->m_keys.end(), less );
+
+    /*functions without measurable time go into the lowest time bin*/
+    double minTime = 0;
+    map->m_visits.resize( map->m_keys.size() );
+    map->m_times.resize( map->m_keys.size() );
+    for ( int i = 0; i < map->m_keys.size(); i++ )
+    {
+        const dataCenter::data& row = rows[ map->m_keys[ i ] ];
+        map->m_visits[ i ] = row.visits;
+        map->m_times[ i ]  = row.timePerVisit;
+        if ( row.timePerVisit > 0 && ( minTime == 0 || row.timePerVisit < minTime ) )
+        {
+            minTime = row.timePerVisit;
+        }
+    }
+    if ( map->m_keys.isEmpty() )
+    {
+        map->m_counts.fill( 0, X_BINS * Y_BINS );
+        return map;
+    }
+    double maxTime = *std::max_element( map->m_times.begin(), map->m_times.end() );
+    if ( minTime == 0 )
+    {
+        minTime = maxTime = 1;
+    }
+    map->m_minLogVisits = log10( map->m_visits.first() );
+    map->m_maxLogVisits = log10( map->m_visits.last() );
+    map->m_minLogTime   = log10( minTime );
+    map->m_maxLogTime   = log10( maxTime );
+    /*a single value still gets a visible range*/
+    if ( map->m_maxLogVisits - map->m_minLogVisits < 1 )
+    {
+        map->m_minLogVisits -= 0.5;
+        map->m_maxLogVisits += 0.5;
+    }
+    if ( map->m_maxLogTime - map->m_minLogTime < 1 )
+    {
+        map->m_minLogTime -= 0.5;
+        map->m_maxLogTime += 0.5;
+    }
+
+    map->m_counts.fill( 0, X_BINS * Y_BINS );
+    for ( int i = 0; i < map->m_keys.size(); i++ )
+    {
+        int x = bin( log10( map->m_visits[ i ] ), map->m_minLogVisits, map->m_maxLogVisits, X_BINS );
+        int y = bin( log10( qMax( map->m_times[ i ], minTime ) ), map->m_minLogTime, map->m_maxLogTime, Y_BINS );
+        int c = ++map->m_counts[ y * X_BINS + x ];
+        map->m_maxCount = qMax( map->m_maxCount, c );
+    }
+    return map;
+}
+
+int
+DensityMap::count( int x, int y ) const
+{
+    return m_counts[ y * X_BINS + x ];
+}
+
+int
+DensityMap::maxCount() const
+{
+    return m_maxCount;
+}
+
+int
+DensityMap::functionNum() const
+{
+    return m_keys.size();
+}
+
+double
+DensityMap::minLogVisits() const
+{
+    return m_minLogVisits;
+}
+
+double
+DensityMap::maxLogVisits() const
+{
+    return m_maxLogVisits;
+}
+
+double
+DensityMap::minLogTime() const
+{
+    return m_minLogTime;
+}
+
+double
+DensityMap::maxLogTime() const
+{
+    return m_maxLogTime;
+}
+
+QVector<int>
+DensityMap::select( double minVisits, double maxVisits, double minTime, double maxTime ) const
+{
+    /*the visit range is contiguous, only its functions are checked*/
+    const double* first = std::lower_bound( m_visits.constData(), m_visits.constData() + m_visits.size(), minVisits );
+    const double* last  = std::upper_bound( first, m_visits.constData() + m_visits.size(), maxVisits );
+    QVector<int>  keys;
+    for ( int i = first - m_visits.constData(); i < last - m_visits.constData(); i++ )
+    {
+        if ( m_times[ i ] >= minTime && m_times[ i ] <= maxTime )
+        {
+            keys.append( m_keys[ i ] );
+        }
+    }
+    std::sort( keys.begin(), keys.end() );
+    return keys;
+}
@@ -0,0 +1,77 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#ifndef DENSITYMAP_HPP
+#define DENSITYMAP_HPP
+
+#include <QtGlobal>
+#include <QVector>
+#include <QSharedPointer>
+
+#include "data.hpp"
+
+/*
+ * Number of filterable functions per bin of log10( visits ) against
+ * log10( time per visit ), and the functions sorted by their visits. A
+ * rectangle of the plot finds its visit range by binary search and only
+ * checks the time per visit of the functions inside it. Immutable after
+ * build() and shared between threads.
+ */
+class DensityMap
+{
+public:
+    enum { X_BINS = 64, Y_BINS = 40 };
+
+    DensityMap();
+
+    /*runs in a worker thread*/
+    static QSharedPointer<const DensityMap>
+    build( QSharedPointer<const dataCenter::functionSnapshot> functions );
+
+    /*number of functions in the bin, y grows with the time per visit*/
+    int
+    count( int x,
+           int y ) const;
+    int
+    maxCount() const;
+    int
+    functionNum() const;
+    /*log10 ranges covered by the bins*/
+    double
+    minLogVisits() const;
+    double
+    maxLogVisits() const;
+    double
+    minLogTime() const;
+    double
+    maxLogTime() const;
+    /*sorted keys with visits and time per visit [us] in both closed ranges*/
+    QVector<int>
+    select( double minVisits,
+            double maxVisits,
+            double minTime,
+            double maxTime ) const;
+
+private:
+    QVector<int> m_counts;
+    int          m_maxCount;
+    double       m_minLogVisits;
+    double       m_maxLogVisits;
+    double       m_minLogTime;
+    double       m_maxLogTime;
+    /*parallel arrays in ascending order of the visits*/
+    QVector<int>    m_keys;
+    QVector<double> m_visits;
+    QVector<double> m_times;
+};
+
+#endif // DENSITYMAP_HPP
@@ -0,0 +1,225 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#include <math.h>
+#include <limits>
+
+#include "densitywidget.hpp"
+
+DensityWidget::DensityWidget( QWidget* parent )
+    : QWidget( parent )
+    , m_hasBrush( false )
+    , m_brushing( false )
+{
+    setMinimumHeight( 200 );
+    setMouseTracking( true );
+}
+
+void
+DensityWidget::setMap( QSharedPointer<const DensityMap> map )
+{
+    m_map      = map;
+    m_hasBrush = false;
+    m_brushing = false;
+    update();
+}
+
+void
+DensityWidget::clear( const QString& message )
+{
+    m_map.clear();
+    m_message  = message;
+    m_hasBrush = false;
+    m_brushing = false;
+    update();
+}
+
+void
+DensityWidget::clearBrush()
+{
+    m_hasBrush = false;
+    m_brushing = false;
+    update();
+}
+
+QRect
+DensityWidget::plotArea() const
+{
+    /*room for the title above, the time axis left and the visit axis below*/
+    int line = fontMetrics().height();
+    return rect().adjusted( 50, line + 4, -8, -line - 6 );
+}
+
+QRect
+DensityWidget::brushRect() const
+{
+    return QRect( m_brushStart, m_brushEnd ).normalized().intersected( plotArea() );
+}
+
+double
+DensityWidget::logVisitsAt( int x ) const
+{
+    QRect area = plotArea();
+    return m_map->minLogVisits() +
+           ( m_map->maxLogVisits() - m_map->minLogVisits() ) * ( x - area.left() ) / area.width();
+}
+
+double
+DensityWidget::logTimeAt( int y ) const
+{
+    QRect area = plotArea();
+    return m_map->minLogTime() +
+           ( m_map->maxLogTime() - m_map->minLogTime() ) * ( area.bottom() + 1 - y ) / area.height();
+}
+
+void
+DensityWidget::paintEvent( QPaintEvent* event )
+{
+    Q_UNUSED( event );
+    QPainter painter( this );
+    QRect    area = plotArea();
+    painter.fillRect( rect(), palette().base() );
+    painter.setPen( palette().text().color() );
+    if ( !m_map || m_map->functionNum() == 0 || area.width() <= 0 || area.height() <= 0 )
+    {
+        painter.drawText( rect().adjusted( 6, 2, -6, 0 ), Qt::AlignLeft | Qt::AlignTop,
+                          m_map ? QString( "No filterable regions" ) : m_message );
+        return;
+    }
+    painter.drawText( rect().adjusted( 6, 2, -6, 0 ), Qt::AlignLeft | Qt::AlignTop,
+                      QString( "time/visit [us] against visits of %1 filterable regions, "
+                               "drag to brush, click to clear" ).arg( m_map->functionNum() ) );
+
+    /*bins, the color grows with the log of the count*/
+    double binWidth  = ( double )area.width() / DensityMap::X_BINS;
+    double binHeight = ( double )area.height() / DensityMap::Y_BINS;
+    double logMax    = log( 1.0 + m_map->maxCount() );
+    for ( int x = 0; x < DensityMap::X_BINS; x++ )
+    {
+        for ( int y = 0; y < DensityMap::Y_BINS; y++ )
+        {
+            int count = m_map->count( x, y );
+            if ( count == 0 )
+            {
+                continue;
+            }
+            double share = log( 1.0 + count ) / logMax;
+            QRectF bin( area.left() + x * binWidth, area.bottom() + 1 - ( y + 1 ) * binHeight,
+                        binWidth, binHeight );
+            painter.fillRect( bin, QColor::fromHsvF( ( 1 - share ) * 0.66, 0.85, 0.95 ) );
+        }
+    }
+
+    /*one tick per decade*/
+    painter.setPen( palette().mid().color() );
+    painter.drawRect( area.adjusted( 0, 0, -1, -1 ) );
+    painter.setPen( palette().text().color() );
+    int line = fontMetrics().height();
+    for ( int k = ( int )ceil( m_map->minLogVisits() ); k <= m_map->maxLogVisits(); k++ )
+    {
+        int x = area.left() + ( int )( area.width() * ( k - m_map->minLogVisits() ) /
+                                       ( m_map->maxLogVisits() - m_map->minLogVisits() ) );
+        painter.drawLine( x, area.bottom(), x, area.bottom() + 3 );
+        painter.drawText( QRect( x - 30, area.bottom() + 4, 60, line ), Qt::AlignCenter,
+                          QString( "1e%1" ).arg( k ) );
+    }
+    for ( int k = ( int )ceil( m_map->minLogTime() ); k <= m_map->maxLogTime(); k++ )
+    {
+        int y = area.bottom() - ( int )( area.height() * ( k - m_map->minLogTime() ) /
+                                         ( m_map->maxLogTime() - m_map->minLogTime() ) );
+        painter.drawLine( area.left() - 3, y, area.left(), y );
+        painter.drawText( QRect( 0, y - line / 2, area.left() - 5, line ), Qt::AlignRight | Qt::AlignVCenter,
+                          QString( "1e%1" ).arg( k ) );
+    }
+
+    if ( m_hasBrush || m_brushing )
+    {
+        QColor fill = palette().highlight().color();
+        fill.setAlpha( 60 );
+        painter.fillRect( brushRect(), fill );
+        painter.setPen( palette().highlight().color() );
+        painter.drawRect( brushRect().adjusted( 0, 0, -1, -1 ) );
+    }
+}
+
+void
+DensityWidget::mousePressEvent( QMouseEvent* event )
+{
+    if ( !m_map || event->button() != Qt::LeftButton )
+    {
+        return;
+    }
+    m_brushing   = true;
+    m_brushStart = event->pos();
+    m_brushEnd   = event->pos();
+    update();
+}
+
+void
+DensityWidget::mouseMoveEvent( QMouseEvent* event )
+{
+    if ( !m_map || m_map->functionNum() == 0 )
+    {
+        return;
+    }
+    if ( m_brushing )
+    {
+        m_brushEnd = event->pos();
+        update();
+        return;
+    }
+    QRect area = plotArea();
+    if ( !area.contains( event->pos() ) )
+    {
+        QToolTip::hideText();
+        return;
+    }
+    int x = qBound( 0, ( event->pos().x() - area.left() ) * DensityMap::X_BINS / area.width(), DensityMap::X_BINS - 1 );
+    int y = qBound( 0, ( area.bottom() - event->pos().y() ) * DensityMap::Y_BINS / area.height(), DensityMap::Y_BINS - 1 );
+    QToolTip::showText( event->globalPos(),
+                        QString( "%1 regions\nvisits %2\ntime/visit %3 us" )
+                        .arg( m_map->count( x, y ) )
+                        .arg( pow( 10, logVisitsAt( event->pos().x() ) ), 0, 'g', 3 )
+                        .arg( pow( 10, logTimeAt( event->pos().y() ) ), 0, 'g', 3 ), this );
+}
+
+void
+DensityWidget::mouseReleaseEvent( QMouseEvent* event )
+{
+    if ( !m_brushing )
+    {
+        return;
+    }
+    m_brushing = false;
+    m_brushEnd = event->pos();
+    QRect brush = brushRect();
+    if ( brush.width() < 3 && brush.height() < 3 )
+    {
+        m_hasBrush = false;
+        update();
+        emit brushCleared();
+        return;
+    }
+    m_hasBrush = true;
+    update();
+
+    /*a border of the plot includes everything beyond it, e.g. regions
+     * without measurable time in the lowest row*/
+    QRect  area      = plotArea();
+    double huge      = std::numeric_limits<double>::max();
+    double minTime   = brush.bottom() >= area.bottom() ? 0 : pow( 10, logTimeAt( brush.bottom() + 1 ) );
+    double maxTime   = brush.top() <= area.top() ? huge : pow( 10, logTimeAt( brush.top() ) );
+    double minVisits = brush.left() <= area.left() ? 0 : pow( 10, logVisitsAt( brush.left() ) );
+    double maxVisits = brush.right() >= area.right() ? huge : pow( 10, logVisitsAt( brush.right() + 1 ) );
+
+    emit brushed( minVisits, maxVisits, minTime, maxTime );
+}
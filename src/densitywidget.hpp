@@ -0,0 +1,84 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#ifndef DENSITYWIDGET_HPP
+#define DENSITYWIDGET_HPP
+
+#include <QWidget>
+#include <QPainter>
+#include <QMouseEvent>
+#include <QToolTip>
+
+#include "densitymap.hpp"
+
+/*
+ * Density of the filterable functions over visits and time per visit,
+ * both on a log scale. Dragging a rectangle brushes the functions inside,
+ * a click without dragging removes the brush.
+ */
+class DensityWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    DensityWidget( QWidget* parent = 0 );
+
+    void
+    setMap( QSharedPointer<const DensityMap> map );
+    void
+    clear( const QString& message = QString() );
+    /*removes the brush without emitting brushCleared*/
+    void
+    clearBrush();
+
+signals:
+    /*closed ranges of visits and time per visit [us], a brush touching
+     * the border of the plot is open to that side*/
+    void
+    brushed( double minVisits,
+             double maxVisits,
+             double minTime,
+             double maxTime );
+    void
+    brushCleared();
+
+protected:
+    void
+    paintEvent( QPaintEvent* event );
+    void
+    mousePressEvent( QMouseEvent* event );
+    void
+    mouseMoveEvent( QMouseEvent* event );
+    void
+    mouseReleaseEvent( QMouseEvent* event );
+
+private:
+    QSharedPointer<const DensityMap> m_map;
+    QString                          m_message;
+    /*brush in widget coordinates, m_brushing while the mouse is down*/
+    bool   m_hasBrush;
+    bool   m_brushing;
+    QPoint m_brushStart;
+    QPoint m_brushEnd;
+
+    QRect
+    plotArea() const;
+    QRect
+    brushRect() const;
+    /*log10 values at a widget position*/
+    double
+    logVisitsAt( int x ) const;
+    double
+    logTimeAt( int y ) const;
+};
+
+#endif // DENSITYWIDGET_HPP
@@ -0,0 +1,165 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#include <algorithm>
+
+#include "fileswidget.hpp"
+#include "filtercompression.hpp"
+
+namespace
+{
+QTableWidgetItem*
+numberItem( const QString& text )
+{
+    QTableWidgetItem* item = new QTableWidgetItem( text );
+    item->setTextAlignment( Qt::AlignRight | Qt::AlignVCenter );
+    return item;
+}
+}
+
+FilesWidget::FilesWidget( QWidget* parent )
+    : QWidget( parent )
+    , mp_connection( 0 )
+    , m_version( 0 )
+{
+    mp_table = new QTableWidget( 0, 4, this );
+    QStringList headers;
+    headers << "File" << "Regions" << "Excluded" << "max_buf";
+    mp_table->setHorizontalHeaderLabels( headers );
+    mp_table->setEditTriggers( QAbstractItemView::NoEditTriggers );
+    mp_table->setSelectionBehavior( QAbstractItemView::SelectRows );
+    mp_table->setSelectionMode( QAbstractItemView::ExtendedSelection );
+    mp_table->verticalHeader()->hide();
+    mp_table->setColumnWidth( 0, 400 );
+    mp_pattern = new QLineEdit( this );
+    mp_pattern->setPlaceholderText( "file pattern, like */src/io/* or a directory ending in /" );
+    mp_rulesLabel = new QLabel( this );
+    mp_exclude    = new QPushButton( "Exclude files", this );
+    mp_include    = new QPushButton( "Include files", this );
+
+    QVBoxLayout* layout = new QVBoxLayout( this );
+    QHBoxLayout* row    = new QHBoxLayout();
+    layout->setContentsMargins( 0, 0, 0, 0 );
+    row->addWidget( mp_pattern );
+    row->addWidget( mp_exclude );
+    row->addWidget( mp_include );
+    layout->addWidget( mp_table );
+    layout->addLayout( row );
+    layout->addWidget( mp_rulesLabel );
+
+    connect( mp_exclude, SIGNAL( clicked( bool ) ), this, SLOT( excludeClicked() ) );
+    connect( mp_include, SIGNAL( clicked( bool ) ), this, SLOT( includeClicked() ) );
+}
+
+void
+FilesWidget::setFiles( Connector* connection )
+{
+    if ( mp_connection == connection && m_version == connection->getStateVersion() )
+    {
+        return;
+    }
+    mp_connection = connection;
+    m_version     = connection->getStateVersion();
+
+    /*largest files first, a file without name holds the regions without one*/
+    QVector<Connector::fileSummary> files = connection->getFileSummaries();
+    QVector<QPair<uint64_t, int> >  order( files.size() );
+    for ( int i = 0; i < files.size(); i++ )
+    {
+        order[ i ] = qMakePair( files[ i ].maxBuf, i );
+    }
+    std::sort( order.begin(), order.end() );
+    mp_table->setRowCount( files.size() );
+    for ( int row = 0; row < files.size(); row++ )
+    {
+        const Connector::fileSummary& f     = files[ order[ files.size() - 1 - row ].second ];
+        QTableWidgetItem*             items[ 4 ];
+        items[ 0 ] = new QTableWidgetItem( f.name.isEmpty() ? QString( "(unknown)" ) : f.name );
+        items[ 0 ]->setData( Qt::UserRole, f.name );
+        items[ 1 ] = numberItem( QString::number( f.functionNum ) );
+        items[ 2 ] = numberItem( QString::number( f.excludedNum ) );
+        items[ 3 ] = numberItem( connection->getReadableByteNo( f.maxBuf ) );
+        for ( int column = 0; column < 4; column++ )
+        {
+            mp_table->setItem( row, column, items[ column ] );
+        }
+    }
+
+    QVector<FilterFile::rule> rules = connection->getFilterRules();
+    if ( rules.isEmpty() )
+    {
+        mp_rulesLabel->setText( "no filter rules, later rules override earlier ones" );
+    }
+    else
+    {
+        const FilterFile::rule& last = rules.last();
+        mp_rulesLabel->setText( QString( "%1 filter rules, last: %2 %3 %4" )
+                                .arg( rules.size() )
+                                .arg( last.exclude ? "EXCLUDE" : "INCLUDE" )
+                                .arg( last.target == FilterFile::FILE_NAMES ? "file" : "region" )
+                                .arg( last.pattern ) );
+    }
+}
+
+void
+FilesWidget::clear()
+{
+    mp_connection = 0;
+    m_version     = 0;
+    mp_table->setRowCount( 0 );
+    mp_rulesLabel->clear();
+}
+
+QVector<FilterFile::rule>
+FilesWidget::rules( bool exclude ) const
+{
+    /*like the Score-P filter a directory glob has to match the whole path*/
+    QStringList patterns;
+    QString     typed = mp_pattern->text().trimmed();
+    if ( !typed.isEmpty() )
+    {
+        patterns << ( typed.endsWith( '/' ) ? typed + "*" : typed );
+    }
+    else
+    {
+        QModelIndexList selection = mp_table->selectionModel()->selectedRows();
+        for ( int i = 0; i < selection.size(); i++ )
+        {
+            QString name = mp_table->item( selection[ i ].row(), 0 )->data( Qt::UserRole ).toString();
+            patterns << FilterCompression::escape( name.toUtf8().constData() );
+        }
+    }
+    QVector<FilterFile::rule> rules;
+    for ( int i = 0; i < patterns.size(); i++ )
+    {
+        FilterFile::rule r;
+        r.target  = FilterFile::FILE_NAMES;
+        r.exclude = exclude;
+        r.mangled = false;
+        r.pattern = patterns[ i ];
+        r.line    = 0;
+        rules.append( r );
+    }
+    return rules;
+}
+
+void
+FilesWidget::excludeClicked()
+{
+    emit changeRequested( true );
+}
+
+void
+FilesWidget::includeClicked()
+{
+    emit changeRequested( false );
+}
@@ -0,0 +1,71 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#ifndef FILESWIDGET_HPP
+#define FILESWIDGET_HPP
+
+#include <QWidget>
+#include <QLabel>
+#include <QLineEdit>
+#include <QPushButton>
+#include <QTableWidget>
+#include <QHeaderView>
+#include <QVBoxLayout>
+
+#include "connector.hpp"
+#include "filterfile.hpp"
+
+/*
+ * Source files of the regions, largest max_buf first, with the rules
+ * for a typed file pattern or the selected files. As in Score-P, the
+ * last matching rule decides.
+ */
+class FilesWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    FilesWidget( QWidget* parent = 0 );
+
+    /*lists the files unless the state of connection did not change since
+     * the last call*/
+    void
+    setFiles( Connector* connection );
+    void
+    clear();
+    /*FILE_NAMES rules for the typed pattern, which wins over the
+     * selection, or the selected files, empty without both*/
+    QVector<FilterFile::rule>
+    rules( bool exclude ) const;
+
+signals:
+    void
+    changeRequested( bool exclude );
+
+private slots:
+    void
+    excludeClicked();
+    void
+    includeClicked();
+
+private:
+    QTableWidget* mp_table;
+    QLineEdit*    mp_pattern;
+    QLabel*       mp_rulesLabel;
+    QPushButton*  mp_exclude;
+    QPushButton*  mp_include;
+    /*connector and state version shown*/
+    Connector*    mp_connection;
+    uint64_t      m_version;
+};
+
+#endif // FILESWIDGET_HPP
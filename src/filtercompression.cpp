@@ -0,0 +1,322 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#include <algorithm>
+#include <vector>
+
+#include "filtercompression.hpp"
+#include "filterfile.hpp"
+
+namespace
+{
+/*a head*tail candidate is dropped if more names share its head*/
+const int MAX_SCAN = 1024;
+
+struct entry
+{
+    std::string name;
+    bool        excluded;
+};
+
+/*characters used in a [class] without quoting*/
+inline bool
+isClassChar( char c )
+{
+    return ( c >= 'a' && c <= 'z' ) || ( c >= 'A' && c <= 'Z' ) || ( c >= '0' && c <= '9' ) || c == '_';
+}
+
+bool
+entryLess( const entry& a, const entry& b )
+{
+    return a.name < b.name;
+}
+
+inline size_t
+commonPrefix( const std::string& a, const std::string& b )
+{
+    size_t n   = 0;
+    size_t max = std::min( a.size(), b.size() );
+    while ( n < max && a[ n ] == b[ n ] )
+    {
+        n++;
+    }
+    return n;
+}
+
+inline size_t
+commonSuffix( const std::string& a, const std::string& b )
+{
+    size_t n   = 0;
+    size_t max = std::min( a.size(), b.size() );
+    while ( n < max && a[ a.size() - 1 - n ] == b[ b.size() - 1 - n ] )
+    {
+        n++;
+    }
+    return n;
+}
+
+/*length of the shortest prefix of entry i no kept name has, 0 if the
+ * name itself is the prefix of a kept name*/
+size_t
+shortestPure( const std::vector<entry>& entries, int i, int prevKept, int nextKept )
+{
+    const std::string& name = entries[ i ].name;
+    size_t             need = 0;
+    if ( prevKept >= 0 )
+    {
+        need = std::max( need, commonPrefix( name, entries[ prevKept ].name ) );
+    }
+    if ( nextKept >= 0 )
+    {
+        need = std::max( need, commonPrefix( name, entries[ nextKept ].name ) );
+    }
+    return need < name.size() ? need + 1 : 0;
+}
+
+/*true if no kept name matches head*tail*/
+bool
+pureWildcard( const std::vector<entry>& entries, const std::string& head, const std::string& tail )
+{
+    entry key;
+    key.name = head;
+    std::vector<entry>::const_iterator it = std::lower_bound( entries.begin(), entries.end(), key, entryLess );
+    for ( int scanned = 0; it != entries.end() && it->name.compare( 0, head.size(), head ) == 0; ++it, scanned++ )
+    {
+        if ( scanned == MAX_SCAN )
+        {
+            return false;
+        }
+        if ( !it->excluded && it->name.size() >= head.size() + tail.size() &&
+             it->name.compare( it->name.size() - tail.size(), tail.size(), tail ) == 0 )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+QString
+filterText( const QStringList& patterns )
+{
+    return "SCOREP_REGION_NAMES_BEGIN\nEXCLUDE MANGLED\n" + patterns.join( "\n" ) +
+           "\nSCOREP_REGION_NAMES_END\n";
+}
+}
+
+const std::string&
+FilterCompression::matchName( const dataCenter::data& row )
+{
+    return row.mangledName.empty() ? row.region : row.mangledName;
+}
+
+QString
+FilterCompression::escape( const std::string& name )
+{
+    QByteArray escaped;
+    escapeTo( name, &escaped );
+    return QString::fromUtf8( escaped.constData(), escaped.size() );
+}
+
+void
+FilterCompression::escapeTo( const std::string& name, QByteArray* out )
+{
+    size_t run = 0;
+    for ( size_t i = 0; i < name.size(); i++ )
+    {
+        switch ( name[ i ] )
+        {
+            case '*':
+            case '?':
+            case '[':
+            case ']':
+            case '\\':
+                out->append( name.data() + run, ( int )( i - run ) );
+                out->append( '\\' );
+                run = i;
+                break;
+            default:
+                break;
+        }
+    }
+    out->append( name.data() + run, ( int )( name.size() - run ) );
+}
+
+FilterCompression::result
+FilterCompression::compute( const QVector<dataCenter::data>& rows, const QVector<int>& excludedKeys )
+{
+    result r;
+    r.wildcardNum = 0;
+    r.verified    = true;
+
+    /*distinct names, a name is excluded if any of its functions is*/
+    std::vector<entry> entries( rows.size() );
+    for ( int i = 0; i < rows.size(); i++ )
+    {
+        entries[ i ].name     = matchName( rows[ i ] );
+        entries[ i ].excluded = false;
+    }
+    for ( int i = 0; i < excludedKeys.size(); i++ )
+    {
+        entries[ excludedKeys[ i ] ].excluded = true;
+    }
+    std::sort( entries.begin(), entries.end(), entryLess );
+    int n = 0;
+    for ( size_t i = 0; i < entries.size(); i++ )
+    {
+        if ( n > 0 && entries[ n - 1 ].name == entries[ i ].name )
+        {
+            entries[ n - 1 ].excluded = entries[ n - 1 ].excluded || entries[ i ].excluded;
+        }
+        else
+        {
+            entries[ n++ ] = entries[ i ];
+        }
+    }
+    entries.resize( n );
+
+    /*nearest kept names around every name, the longest prefix an excluded
+     * name shares with any kept name is the one shared with them*/
+    std::vector<int> prevKept( n );
+    std::vector<int> nextKept( n );
+    for ( int i = 0, last = -1; i < n; i++ )
+    {
+        prevKept[ i ] = last;
+        last          = entries[ i ].excluded ? last : i;
+    }
+    for ( int i = n - 1, last = -1; i >= 0; i-- )
+    {
+        nextKept[ i ] = last;
+        last          = entries[ i ].excluded ? last : i;
+    }
+
+    /*the names with a pure prefix follow each other and are all excluded*/
+    QStringList      plain;
+    std::vector<int> leftovers;
+    for ( int i = 0; i < n; )
+    {
+        if ( !entries[ i ].excluded )
+        {
+            i++;
+            continue;
+        }
+        size_t pure = shortestPure( entries, i, prevKept[ i ], nextKept[ i ] );
+        int    end  = i + 1;
+        while ( pure > 0 && end < n && entries[ end ].name.compare( 0, pure, entries[ i ].name, 0, pure ) == 0 )
+        {
+            end++;
+        }
+        for ( int j = i; j < end; j++ )
+        {
+            plain.append( escape( entries[ j ].name ) );
+        }
+        if ( end - i >= 2 )
+        {
+            /*the longest common prefix matches the same names, but fewer unknown ones*/
+            const std::string& first = entries[ i ].name;
+            r.patterns.append( escape( first.substr( 0, commonPrefix( first, entries[ end - 1 ].name ) ) ) + "*" );
+            r.wildcardNum++;
+        }
+        else
+        {
+            leftovers.push_back( i );
+        }
+        i = end;
+    }
+    r.nameNum = plain.size();
+
+    /*neighbouring leftovers sharing a head and a tail*/
+    for ( size_t k = 0; k < leftovers.size(); )
+    {
+        const std::string& first  = entries[ leftovers[ k ] ].name;
+        size_t             head   = first.size();
+        size_t             tail   = 0;
+        size_t             suffix = first.size();
+        size_t             minLen = first.size();
+        size_t             end    = k + 1;
+        for ( ; end < leftovers.size(); end++ )
+        {
+            const std::string& name = entries[ leftovers[ end ] ].name;
+            size_t             h    = commonPrefix( first, name );
+            size_t             len  = std::min( minLen, name.size() );
+            size_t             s    = std::min( suffix, commonSuffix( first, name ) );
+            size_t             t    = std::min( s, len - h );
+            if ( h == 0 || t == 0 ||
+                 !pureWildcard( entries, first.substr( 0, h ), first.substr( first.size() - t ) ) )
+            {
+                break;
+            }
+            head   = h;
+            tail   = t;
+            suffix = s;
+            minLen = len;
+        }
+        if ( end - k >= 2 )
+        {
+            r.patterns.append( escape( first.substr( 0, head ) ) + "*" +
+                               escape( first.substr( first.size() - tail ) ) );
+            r.wildcardNum++;
+            k = end;
+            continue;
+        }
+
+        /*names differing in one character only, like instantiations with
+         * different template arguments, the class cannot match kept names*/
+        std::string chars;
+        size_t      at = 0;
+        for ( end = k + 1; end < leftovers.size(); end++ )
+        {
+            const std::string& name = entries[ leftovers[ end ] ].name;
+            size_t             h    = commonPrefix( first, name );
+            if ( name.size() != first.size() || h == first.size() || ( end > k + 1 && h != at ) ||
+                 !isClassChar( name[ h ] ) || !isClassChar( first[ h ] ) ||
+                 name.compare( h + 1, std::string::npos, first, h + 1, std::string::npos ) != 0 )
+            {
+                break;
+            }
+            at     = h;
+            chars += name[ h ];
+        }
+        if ( end - k >= 2 )
+        {
+            r.patterns.append( escape( first.substr( 0, at ) ) + "[" +
+                               escape( first.substr( at, 1 ) + chars ) + "]" +
+                               escape( first.substr( at + 1 ) ) );
+            r.wildcardNum++;
+        }
+        else
+        {
+            r.patterns.append( escape( first ) );
+        }
+        k = end;
+    }
+
+    /*the written text must exclude exactly the rows the plain list does*/
+    QVector<int> expected;
+    for ( int i = 0; i < rows.size(); i++ )
+    {
+        entry key;
+        key.name = matchName( rows[ i ] );
+        if ( std::lower_bound( entries.begin(), entries.end(), key, entryLess )->excluded )
+        {
+            expected.append( i );
+        }
+    }
+    FilterFile filter;
+    QString    error;
+    if ( !filter.parse( filterText( r.patterns ).toUtf8(), &error ) || filter.evaluate( rows ) != expected )
+    {
+        r.patterns    = plain;
+        r.wildcardNum = 0;
+        r.verified    = false;
+    }
+    return r;
+}
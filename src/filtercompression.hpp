@@ -0,0 +1,68 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#ifndef FILTERCOMPRESSION_HPP
+#define FILTERCOMPRESSION_HPP
+
+#include <QtGlobal>
+#include <QVector>
+#include <QStringList>
+#include <QByteArray>
+
+#include "data.hpp"
+
+/*
+ * Replaces the EXCLUDE MANGLED list of the excluded functions by fewer
+ * wildcard patterns. Names are matched as the filter does, by their
+ * mangled name or by the region name if there is none.
+ *
+ * The sorted names are split into blocks sharing the shortest prefix no
+ * kept name has, every block of two or more names becomes the pattern
+ * "common prefix*", which covers namespaces and classes. Names left over
+ * are grouped into "head*tail" patterns, which covers template
+ * instantiations that differ in the middle. Every pattern is checked
+ * against the kept names, and the result against the whole table.
+ */
+class FilterCompression
+{
+public:
+    struct result
+    {
+        /*escaped for a filter file, literal names and wildcards*/
+        QStringList patterns;
+        /*distinct excluded names*/
+        int         nameNum;
+        int         wildcardNum;
+        /*the patterns exclude exactly the rows the plain list does,
+         * if not, patterns is the plain list*/
+        bool        verified;
+    };
+
+    /*excludedKeys are indices into rows*/
+    static result
+    compute( const QVector<dataCenter::data>& rows,
+             const QVector<int>&              excludedKeys );
+
+    /*name the filter matches a function by*/
+    static const std::string&
+    matchName( const dataCenter::data& row );
+
+    /*quotes the wildcard characters of a literal name*/
+    static QString
+    escape( const std::string& name );
+    /*appends the quoted name to out*/
+    static void
+    escapeTo( const std::string& name,
+              QByteArray*        out );
+};
+
+#endif // FILTERCOMPRESSION_HPP
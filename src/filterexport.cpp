@@ -0,0 +1,266 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryFile>
+
+#include "filterexport.hpp"
+#include "filtercompression.hpp"
+
+namespace
+{
+/*appends to one buffer, numbers are formatted without temporary strings*/
+struct writer
+{
+    QByteArray* out;
+
+    void
+    text( const char* s )
+    {
+        out->append( s );
+    }
+    void
+    text( const std::string& s )
+    {
+        out->append( s.data(), ( int )s.size() );
+    }
+    void
+    number( int64_t value )
+    {
+        if ( value < 0 )
+        {
+            out->append( '-' );
+            value = -value;
+        }
+        number( ( uint64_t )value );
+    }
+    void
+    number( uint64_t value )
+    {
+        char digits[ 20 ];
+        int  first = 20;
+        do
+        {
+            digits[ --first ] = '0' + value % 10;
+            value            /= 10;
+        }
+        while ( value > 0 );
+        out->append( digits + first, 20 - first );
+    }
+    void
+    number( double value )
+    {
+        /*not printf, the locale of the GUI may use decimal commas*/
+        out->append( QByteArray::number( value, 'g', 9 ) );
+    }
+    void
+    json( const std::string& s )
+    {
+        FilterExport::appendJson( s, out );
+    }
+    void
+    sizes( const char* name, const dataCenter::sizes& s )
+    {
+        text( "  \"" );
+        text( name );
+        text( "\": { \"trace_size\": " );
+        number( s.traceSize );
+        text( ", \"max_buf\": " );
+        number( s.maxBuf );
+        text( ", \"total_memory\": " );
+        number( s.totalMemory );
+        text( " },\n" );
+    }
+};
+
+void
+renderFilter( writer& w, const FilterExport::input& in )
+{
+    const QVector<dataCenter::data>& rows = in.functions->rows;
+    w.text( "#this file is generated by scorep-score-gui\n"
+            "SCOREP_REGION_NAMES_BEGIN\n"
+            "    EXCLUDE MANGLED\n" );
+    for ( int i = 0; i < in.patterns.size(); i++ )
+    {
+        w.text( "        " );
+        w.out->append( in.patterns[ i ].toUtf8() );
+        w.text( "\n" );
+    }
+    for ( int i = 0; in.patterns.isEmpty() && i < in.excludedKeys.size(); i++ )
+    {
+        w.text( "        " );
+        FilterCompression::escapeTo( FilterCompression::matchName( rows[ in.excludedKeys[ i ] ] ), w.out );
+        w.text( "\n" );
+    }
+    w.text( "SCOREP_REGION_NAMES_END\n" );
+}
+
+void
+renderList( writer& w, const FilterExport::input& in )
+{
+    const QVector<dataCenter::data>& rows = in.functions->rows;
+    for ( int i = 0; i < in.excludedKeys.size(); i++ )
+    {
+        w.text( rows[ in.excludedKeys[ i ] ].region );
+        w.text( "\n" );
+    }
+}
+
+void
+renderReport( writer& w, const FilterExport::input& in )
+{
+    const QVector<dataCenter::data>& rows = in.functions->rows;
+    w.text( "{\n  \"profile\": " );
+    w.json( in.profile.toUtf8().constData() );
+    w.text( ",\n  \"excluded_regions\": " );
+    w.number( ( int64_t )in.excludedKeys.size() );
+    w.text( ",\n" );
+    w.sizes( "before", in.before );
+    w.sizes( "after", in.after );
+    w.text( "  \"regions\": [" );
+    for ( int i = 0; i < in.excludedKeys.size(); i++ )
+    {
+        const dataCenter::data& row = rows[ in.excludedKeys[ i ] ];
+        w.text( i == 0 ? "\n    { \"region\": " : ",\n    { \"region\": " );
+        w.json( row.region );
+        w.text( ", \"mangled\": " );
+        w.json( row.mangledName );
+        w.text( ", \"file\": " );
+        w.json( row.fileName );
+        w.text( ", \"type\": " );
+        w.json( row.type );
+        w.text( ", \"max_buf\": " );
+        w.number( ( int64_t )row.maxBuf );
+        w.text( ", \"visits\": " );
+        w.number( ( int64_t )row.visits );
+        w.text( ", \"time\": " );
+        w.number( row.timeS );
+        w.text( " }" );
+    }
+    w.text( "\n  ]\n}\n" );
+}
+}
+
+void
+FilterExport::appendJson( const std::string& s, QByteArray* out )
+{
+    static const char hex[] = "0123456789abcdef";
+    out->append( '"' );
+    /*names rarely need quoting, copy the runs in between at once*/
+    size_t run = 0;
+    for ( size_t i = 0; i < s.size(); i++ )
+    {
+        unsigned char c = s[ i ];
+        if ( c != '"' && c != '\\' && c >= 0x20 )
+        {
+            continue;
+        }
+        out->append( s.data() + run, ( int )( i - run ) );
+        run = i + 1;
+        if ( c < 0x20 )
+        {
+            out->append( "\\u00" );
+            out->append( hex[ c >> 4 ] );
+            out->append( hex[ c & 15 ] );
+        }
+        else
+        {
+            out->append( '\\' );
+            out->append( ( char )c );
+        }
+    }
+    out->append( s.data() + run, ( int )( s.size() - run ) );
+    out->append( '"' );
+}
+
+FilterExport::format
+FilterExport::formatOf( const QString& fileName )
+{
+    if ( fileName.endsWith( ".txt" ) )
+    {
+        return REGION_LIST;
+    }
+    if ( fileName.endsWith( ".json" ) )
+    {
+        return JSON_REPORT;
+    }
+    return SCOREP_FILTER;
+}
+
+QByteArray
+FilterExport::render( format f, const input& in )
+{
+    /*one allocation for the usual lengths of the lines*/
+    const QVector<dataCenter::data>& rows = in.functions->rows;
+    int                              size = 256;
+    for ( int i = 0; i < in.excludedKeys.size(); i++ )
+    {
+        const dataCenter::data& row = rows[ in.excludedKeys[ i ] ];
+        size += 16 + ( int )FilterCompression::matchName( row ).size();
+        if ( f == JSON_REPORT )
+        {
+            size += 128 + ( int )( row.region.size() + row.mangledName.size() + row.fileName.size() );
+        }
+    }
+    QByteArray text;
+    text.reserve( size );
+    writer w;
+    w.out = &text;
+    switch ( f )
+    {
+        case SCOREP_FILTER:
+            renderFilter( w, in );
+            break;
+        case REGION_LIST:
+            renderList( w, in );
+            break;
+        case JSON_REPORT:
+            renderReport( w, in );
+            break;
+    }
+    return text;
+}
+
+bool
+FilterExport::write( const QString& fileName, const QByteArray& text, QString* error )
+{
+    QFileInfo      info( fileName );
+    QTemporaryFile file( info.absoluteFilePath() + ".XXXXXX" );
+    if ( !file.open() )
+    {
+        *error = "cannot create a file next to " + fileName + ", " + file.errorString();
+        return false;
+    }
+    if ( file.write( text ) != text.size() || !file.flush() || fsync( file.handle() ) != 0 )
+    {
+        *error = "writing " + file.fileName() + " failed, " + file.errorString();
+        return false;
+    }
+    /*temporary files are private, a replaced file keeps its permissions*/
+    file.setPermissions( info.exists() ? info.permissions() :
+                         QFile::ReadOwner | QFile::WriteOwner | QFile::ReadUser | QFile::WriteUser |
+                         QFile::ReadGroup | QFile::ReadOther );
+    file.close();
+    /*replaces the old file in one step, unlike QFile::rename*/
+    if ( rename( QFile::encodeName( file.fileName() ).constData(), QFile::encodeName( fileName ).constData() ) != 0 )
+    {
+        *error = "replacing " + fileName + " failed, " + QString::fromLocal8Bit( strerror( errno ) );
+        return false;
+    }
+    file.setAutoRemove( false );
+    return true;
+}
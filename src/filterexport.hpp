@@ -0,0 +1,77 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#ifndef FILTEREXPORT_HPP
+#define FILTEREXPORT_HPP
+
+#include <QtGlobal>
+#include <QVector>
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QSharedPointer>
+
+#include "data.hpp"
+
+/*
+ * Writes the excluded functions as a Score-P filter, as a plain list of
+ * region names or as a JSON report with the estimated sizes before and
+ * after filtering.
+ *
+ * All formats are rendered into one buffer and written with a single
+ * call into a temporary file next to the target, which is renamed over
+ * the target once everything reached the disk. A failed export never
+ * leaves a truncated file behind.
+ */
+class FilterExport
+{
+public:
+    enum format
+    {
+        SCOREP_FILTER,
+        REGION_LIST,
+        JSON_REPORT
+    };
+
+    struct input
+    {
+        QSharedPointer<const dataCenter::functionSnapshot> functions;
+        QVector<int>                                       excludedKeys;
+        /*escaped patterns of the filter, written instead of the names
+         * of the excluded functions if not empty*/
+        QStringList                                        patterns;
+        QString                                            profile;
+        dataCenter::sizes                                  before;
+        dataCenter::sizes                                  after;
+    };
+
+    /*.txt is a region list, .json a report, everything else a filter*/
+    static format
+    formatOf( const QString& fileName );
+
+    static QByteArray
+    render( format       f,
+            const input& in );
+
+    /*appends s as a quoted JSON string*/
+    static void
+    appendJson( const std::string& s,
+                QByteArray*        out );
+
+    /*replaces fileName atomically, error describes the failed step*/
+    static bool
+    write( const QString&    fileName,
+           const QByteArray& text,
+           QString*          error );
+};
+
+#endif // FILTEREXPORT_HPP
@@ -0,0 +1,386 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#include <algorithm>
+#include <fnmatch.h>
+#include <string.h>
+#include <QFile>
+#include <QList>
+#include <QThread>
+#include <QtConcurrentMap>
+
+#include "filterfile.hpp"
+
+namespace
+{
+/*characters that end the literal head and tail of a pattern, ']' and the
+ * escape only make the literal parts shorter than necessary*/
+inline bool
+isSpecial( char c )
+{
+    switch ( c )
+    {
+        case '*':
+        case '?':
+        case '[':
+        case ']':
+        case '\\':
+            return true;
+        default:
+            return false;
+    }
+}
+
+struct chunk
+{
+    const FilterFile*                filter;
+    const QVector<dataCenter::data>* rows;
+    int                              first;
+    int                              last;
+    QVector<int>                     keys;
+};
+
+void
+evaluateChunk( chunk& c )
+{
+    for ( int i = c.first; i < c.last; i++ )
+    {
+        const dataCenter::data& row = ( *c.rows )[ i ];
+        if ( c.filter->excludes( row.fileName, row.region, row.mangledName ) )
+        {
+            c.keys.append( i );
+        }
+    }
+}
+}
+
+FilterFile::FilterFile()
+{
+}
+
+bool
+FilterFile::parse( const QByteArray& text, QString* error )
+{
+    bool  inBlock      = false;
+    block target       = REGION_NAMES;
+    int   beginLine    = 0;
+    /*-1 until the first INCLUDE or EXCLUDE of a block*/
+    int   mode         = -1;
+    bool  mangled      = false;
+    bool  afterKeyword = false;
+
+    QList<QByteArray> lines = text.split( '\n' );
+    for ( int l = 0; l < lines.size(); l++ )
+    {
+        QByteArray line    = lines[ l ];
+        int        comment = line.indexOf( '#' );
+        if ( comment >= 0 )
+        {
+            line.truncate( comment );
+        }
+        QList<QByteArray> tokens = line.simplified().split( ' ' );
+        for ( int t = 0; t < tokens.size(); t++ )
+        {
+            const QByteArray& token = tokens[ t ];
+            if ( token.isEmpty() )
+            {
+                continue;
+            }
+            if ( token == "SCOREP_REGION_NAMES_BEGIN" || token == "SCOREP_FILE_NAMES_BEGIN" )
+            {
+                if ( inBlock )
+                {
+                    *error = QString( "line %1: %2 inside the block opened in line %3" )
+                             .arg( l + 1 ).arg( QString( token ) ).arg( beginLine );
+                    return false;
+                }
+                inBlock   = true;
+                target    = token == "SCOREP_FILE_NAMES_BEGIN" ? FILE_NAMES : REGION_NAMES;
+                beginLine = l + 1;
+                mode      = -1;
+            }
+            else if ( token == "SCOREP_REGION_NAMES_END" || token == "SCOREP_FILE_NAMES_END" )
+            {
+                block ending = token == "SCOREP_FILE_NAMES_END" ? FILE_NAMES : REGION_NAMES;
+                if ( !inBlock || ending != target )
+                {
+                    *error = QString( "line %1: %2 without matching begin" )
+                             .arg( l + 1 ).arg( QString( token ) );
+                    return false;
+                }
+                inBlock = false;
+            }
+            else if ( !inBlock )
+            {
+                *error = QString( "line %1: '%2' outside of a block" )
+                         .arg( l + 1 ).arg( QString( token ) );
+                return false;
+            }
+            else if ( token == "INCLUDE" || token == "EXCLUDE" )
+            {
+                mode         = token == "EXCLUDE" ? 1 : 0;
+                mangled      = false;
+                afterKeyword = true;
+                continue;
+            }
+            else if ( token == "MANGLED" && afterKeyword )
+            {
+                if ( target == FILE_NAMES )
+                {
+                    *error = QString( "line %1: MANGLED is only allowed for region names" ).arg( l + 1 );
+                    return false;
+                }
+                mangled = true;
+            }
+            else if ( mode < 0 )
+            {
+                *error = QString( "line %1: pattern '%2' before INCLUDE or EXCLUDE" )
+                         .arg( l + 1 ).arg( QString( token ) );
+                return false;
+            }
+            else
+            {
+                rule r;
+                r.target  = target;
+                r.exclude = mode == 1;
+                r.mangled = mangled;
+                r.pattern = QString::fromUtf8( token.constData(), token.size() );
+                r.line    = l + 1;
+                append( r );
+            }
+            afterKeyword = false;
+        }
+    }
+    if ( inBlock )
+    {
+        *error = QString( "line %1: block is not closed" ).arg( beginLine );
+        return false;
+    }
+    return true;
+}
+
+bool
+FilterFile::load( const QString& fileName, QString* error )
+{
+    QFile file( fileName );
+    if ( !file.open( QIODevice::ReadOnly ) )
+    {
+        *error = "cannot open " + fileName;
+        return false;
+    }
+    return parse( file.readAll(), error );
+}
+
+void
+FilterFile::append( const rule& r )
+{
+    m_rules.append( r );
+    patternSet* set = r.target == FILE_NAMES ? &m_fileNames :
+                      r.mangled ? &m_mangledNames : &m_regionNames;
+    addPattern( set, r.pattern.toUtf8(), m_rules.size() - 1 );
+}
+
+void
+FilterFile::clear()
+{
+    m_rules.clear();
+    m_regionNames  = patternSet();
+    m_mangledNames = patternSet();
+    m_fileNames    = patternSet();
+}
+
+const QVector<FilterFile::rule>&
+FilterFile::rules() const
+{
+    return m_rules;
+}
+
+bool
+FilterFile::isEmpty() const
+{
+    return m_rules.isEmpty();
+}
+
+int
+FilterFile::lastFileRule( const std::string& fileName ) const
+{
+    /*regions without a file are never filtered by the file rules*/
+    return fileName.empty() ? -1 : lastMatch( m_fileNames, fileName );
+}
+
+int
+FilterFile::lastRegionRule( const std::string& region, const std::string& mangledName ) const
+{
+    return qMax( lastMatch( m_regionNames, region ),
+                 lastMatch( m_mangledNames, mangledName.empty() ? region : mangledName ) );
+}
+
+bool
+FilterFile::excludesFile( const std::string& fileName ) const
+{
+    int index = lastFileRule( fileName );
+    return index >= 0 && m_rules[ index ].exclude;
+}
+
+bool
+FilterFile::excludesRegion( const std::string& region, const std::string& mangledName ) const
+{
+    int index = lastRegionRule( region, mangledName );
+    return index >= 0 && m_rules[ index ].exclude;
+}
+
+bool
+FilterFile::excludes( const std::string& fileName, const std::string& region, const std::string& mangledName ) const
+{
+    return excludesFile( fileName ) || excludesRegion( region, mangledName );
+}
+
+QVector<int>
+FilterFile::evaluate( const QVector<dataCenter::data>& rows ) const
+{
+    /*small tables are not worth the threads*/
+    int chunkNum = qMax( 1, qMin( QThread::idealThreadCount(), rows.size() / 4096 ) );
+    int size     = ( rows.size() + chunkNum - 1 ) / chunkNum;
+
+    QVector<chunk> chunks;
+    for ( int first = 0; first < rows.size(); first += size )
+    {
+        chunk c;
+        c.filter = this;
+        c.rows   = &rows;
+        c.first  = first;
+        c.last   = qMin( first + size, rows.size() );
+        chunks.append( c );
+    }
+    if ( chunks.size() == 1 )
+    {
+        evaluateChunk( chunks.first() );
+    }
+    else
+    {
+        QtConcurrent::blockingMap( chunks, evaluateChunk );
+    }
+
+    /*the chunks are in order, so are the joined keys*/
+    QVector<int> keys;
+    for ( int i = 0; i < chunks.size(); i++ )
+    {
+        keys += chunks[ i ].keys;
+    }
+    return keys;
+}
+
+bool
+FilterFile::matches( const QByteArray& pattern, const std::string& name )
+{
+    return fnmatch( pattern.constData(), name.c_str(), 0 ) == 0;
+}
+
+int
+FilterFile::literalHead( const QByteArray& pattern )
+{
+    int head = 0;
+    while ( head < pattern.size() && !isSpecial( pattern[ head ] ) )
+    {
+        head++;
+    }
+    return head;
+}
+
+void
+FilterFile::addPattern( patternSet* set, const QByteArray& pattern, int index )
+{
+    int head = literalHead( pattern );
+    if ( head == pattern.size() )
+    {
+        /*a later rule for the same literal overrides the earlier one*/
+        set->literals.insert( pattern, index );
+        return;
+    }
+    int tail = pattern.size();
+    while ( tail > head && !isSpecial( pattern[ tail - 1 ] ) )
+    {
+        tail--;
+    }
+    wildcard w;
+    w.pattern = pattern;
+    w.tail    = pattern.mid( tail );
+    w.index   = index;
+    w.simple  = tail == head + 1 && pattern[ head ] == '*';
+    set->heads[ pattern.left( head ) ].append( w );
+
+    QVector<int>::iterator length = std::lower_bound( set->headLengths.begin(), set->headLengths.end(), head );
+    if ( length == set->headLengths.end() || *length != head )
+    {
+        set->headLengths.insert( length, head );
+    }
+}
+
+int
+FilterFile::lastMatch( const patternSet& set, const std::string& name )
+{
+    int                                    best    = -1;
+    int                                    size    = ( int )name.size();
+    QHash<QByteArray, int>::const_iterator literal = set.literals.find( QByteArray::fromRawData( name.data(), size ) );
+    if ( literal != set.literals.end() )
+    {
+        best = literal.value();
+    }
+    for ( int i = 0; i < set.headLengths.size() && set.headLengths[ i ] <= size; i++ )
+    {
+        int                                                   head    = set.headLengths[ i ];
+        QHash<QByteArray, QVector<wildcard> >::const_iterator bucket  = set.heads.find( QByteArray::fromRawData( name.data(), head ) );
+        if ( bucket == set.heads.end() )
+        {
+            continue;
+        }
+        /*only rules after the best match so far can change the result*/
+        const QVector<wildcard>& patterns = bucket.value();
+        for ( int j = patterns.size() - 1; j >= 0 && patterns[ j ].index > best; j-- )
+        {
+            const wildcard& w = patterns[ j ];
+            if ( w.tail.size() > size - head ||
+                 memcmp( name.data() + size - w.tail.size(), w.tail.constData(), w.tail.size() ) != 0 )
+            {
+                continue;
+            }
+            if ( w.simple || fnmatch( w.pattern.constData(), name.c_str(), 0 ) == 0 )
+            {
+                best = w.index;
+                break;
+            }
+        }
+    }
+    return best;
+}
+
+QDataStream&
+operator<<( QDataStream& out, const FilterFile::rule& r )
+{
+    out << ( qint32 )r.target << r.exclude << r.mangled << r.pattern << ( qint32 )r.line;
+    return out;
+}
+
+QDataStream&
+operator>>( QDataStream& in, FilterFile::rule& r )
+{
+    qint32 target = 0;
+    qint32 line   = 0;
+    in >> target >> r.exclude >> r.mangled >> r.pattern >> line;
+    if ( target != FilterFile::REGION_NAMES && target != FilterFile::FILE_NAMES )
+    {
+        in.setStatus( QDataStream::ReadCorruptData );
+    }
+    r.target = ( FilterFile::block )target;
+    r.line   = line;
+    return in;
+}
@@ -0,0 +1,140 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#ifndef FILTERFILE_HPP
+#define FILTERFILE_HPP
+
+#include <QtGlobal>
+#include <QVector>
+#include <QHash>
+#include <QByteArray>
+#include <QString>
+#include <QDataStream>
+
+#include "data.hpp"
+
+/*
+ * Rules of a Score-P filter file: INCLUDE and EXCLUDE rules with shell
+ * wildcards in a SCOREP_REGION_NAMES block, optionally matching the
+ * mangled names, and in a SCOREP_FILE_NAMES block. As in Score-P the last
+ * matching rule of a block decides and a region is filtered if its file
+ * or its name is excluded.
+ *
+ * The patterns are compiled on insertion: literal patterns are looked up
+ * in a hash, the others are bucketed by their literal head and rejected
+ * by their literal tail before fnmatch() is called, so a name only meets
+ * the few patterns that can match it. Matching is const and thread safe.
+ */
+class FilterFile
+{
+public:
+    enum block { REGION_NAMES, FILE_NAMES };
+    /*one rule per pattern, in the order of the file*/
+    struct rule
+    {
+        block   target;
+        bool    exclude;
+        bool    mangled;
+        QString pattern;
+        /*line in the file, 0 for rules not read from a file*/
+        int     line;
+    };
+
+    FilterFile();
+
+    /*false and a message naming the line on syntax errors, the rules
+     * read so far are kept*/
+    bool
+    parse( const QByteArray& text,
+           QString*          error );
+    bool
+    load( const QString& fileName,
+          QString*       error );
+    void
+    append( const rule& r );
+    void
+    clear();
+    const QVector<rule>&
+    rules() const;
+    bool
+    isEmpty() const;
+
+    /*index of the last rule matching, -1 if none does*/
+    int
+    lastFileRule( const std::string& fileName ) const;
+    int
+    lastRegionRule( const std::string& region,
+                    const std::string& mangledName ) const;
+    bool
+    excludesFile( const std::string& fileName ) const;
+    bool
+    excludesRegion( const std::string& region,
+                    const std::string& mangledName ) const;
+    bool
+    excludes( const std::string& fileName,
+              const std::string& region,
+              const std::string& mangledName ) const;
+    /*a single pattern, without compiling it*/
+    static bool
+    matches( const QByteArray&  pattern,
+             const std::string& name );
+    /*length of the text every match starts with*/
+    static int
+    literalHead( const QByteArray& pattern );
+    /*sorted indices of the filtered rows, evaluated in parallel*/
+    QVector<int>
+    evaluate( const QVector<dataCenter::data>& rows ) const;
+
+private:
+    struct wildcard
+    {
+        QByteArray pattern;
+        /*literal text every match ends with*/
+        QByteArray tail;
+        int        index;
+        /*head*tail, matched without fnmatch()*/
+        bool       simple;
+    };
+    /*patterns of one kind of name, each with the index of its rule*/
+    struct patternSet
+    {
+        QHash<QByteArray, int>                literals;
+        /*wildcards by their literal head, in rule order*/
+        QHash<QByteArray, QVector<wildcard> > heads;
+        /*distinct lengths of the heads, ascending*/
+        QVector<int>                          headLengths;
+    };
+
+    QVector<rule> m_rules;
+    patternSet    m_regionNames;
+    patternSet    m_mangledNames;
+    patternSet    m_fileNames;
+
+    static void
+    addPattern( patternSet*       set,
+                const QByteArray& pattern,
+                int               index );
+    /*index of the last rule of set matching name, -1 if none does*/
+    static int
+    lastMatch( const patternSet&  set,
+               const std::string& name );
+};
+
+/*rules are stored in session files*/
+QDataStream&
+operator<<( QDataStream&            out,
+            const FilterFile::rule& r );
+QDataStream&
+operator>>( QDataStream&      in,
+            FilterFile::rule& r );
+
+#endif // FILTERFILE_HPP
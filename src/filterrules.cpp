@@ -0,0 +1,247 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#include <algorithm>
+#include <QHash>
+#include <QByteArray>
+#include <QThread>
+#include <QtConcurrentMap>
+
+#include "filterrules.hpp"
+#include "filtercompression.hpp"
+
+namespace
+{
+struct chunk
+{
+    const FilterFile*                filter;
+    const QVector<dataCenter::data>* rows;
+    int*                             fileRule;
+    int*                             regionRule;
+    int                              first;
+    int                              last;
+};
+
+void
+evaluateChunk( chunk& c )
+{
+    for ( int i = c.first; i < c.last; i++ )
+    {
+        const dataCenter::data& row = ( *c.rows )[ i ];
+        c.fileRule[ i ]   = c.filter->lastFileRule( row.fileName );
+        c.regionRule[ i ] = c.filter->lastRegionRule( row.region, row.mangledName );
+    }
+}
+
+/*orders keys by the name a region rule matches*/
+struct nameLess
+{
+    const QVector<dataCenter::data>* rows;
+    bool                             mangled;
+
+    const std::string&
+    name( int key ) const
+    {
+        const dataCenter::data& row = ( *rows )[ key ];
+        return mangled ? FilterCompression::matchName( row ) : row.region;
+    }
+    bool
+    operator()( int a, int b ) const
+    {
+        return name( a ) < name( b );
+    }
+    bool
+    operator()( int key, const std::string& head ) const
+    {
+        return name( key ) < head;
+    }
+};
+}
+
+FilterRules::FilterRules()
+{
+}
+
+void
+FilterRules::reset( QSharedPointer<const dataCenter::functionSnapshot> functions,
+                    const QVector<FilterFile::rule>&                   rules )
+{
+    m_filter.clear();
+    for ( int i = 0; i < rules.size(); i++ )
+    {
+        m_filter.append( rules[ i ] );
+    }
+    const QVector<dataCenter::data>& rows = functions->rows;
+    m_fileRule.fill( -1, rows.size() );
+    m_regionRule.fill( -1, rows.size() );
+    if ( functions != m_functions )
+    {
+        m_functions = functions;
+        indexNames();
+    }
+
+    if ( rules.isEmpty() )
+    {
+        return;
+    }
+    /*small tables are not worth the threads*/
+    int            chunkNum = qMax( 1, qMin( QThread::idealThreadCount(), rows.size() / 4096 ) );
+    int            size     = ( rows.size() + chunkNum - 1 ) / chunkNum;
+    QVector<chunk> chunks;
+    for ( int first = 0; first < rows.size(); first += size )
+    {
+        chunk c;
+        c.filter     = &m_filter;
+        c.rows       = &rows;
+        c.fileRule   = m_fileRule.data();
+        c.regionRule = m_regionRule.data();
+        c.first      = first;
+        c.last       = qMin( first + size, rows.size() );
+        chunks.append( c );
+    }
+    QtConcurrent::blockingMap( chunks, evaluateChunk );
+}
+
+void
+FilterRules::indexNames()
+{
+    /*the files and orders only depend on the names, which never change*/
+    const QVector<dataCenter::data>& rows = m_functions->rows;
+    m_files.clear();
+    m_fileFunctions.clear();
+    QHash<QByteArray, int> files;
+    for ( int key = 0; key < rows.size(); key++ )
+    {
+        QByteArray name( rows[ key ].fileName.data(), ( int )rows[ key ].fileName.size() );
+        int        file = files.value( name, -1 );
+        if ( file < 0 )
+        {
+            file = m_files.size();
+            files.insert( name, file );
+            m_files.append( rows[ key ].fileName );
+            m_fileFunctions.append( QVector<int>() );
+        }
+        m_fileFunctions[ file ].append( key );
+    }
+    m_byRegion.resize( rows.size() );
+    for ( int key = 0; key < rows.size(); key++ )
+    {
+        m_byRegion[ key ] = key;
+    }
+    m_byMangled = m_byRegion;
+    nameLess less;
+    less.rows    = &rows;
+    less.mangled = false;
+    std::sort( m_byRegion.begin(), m_byRegion.end(), less );
+    less.mangled = true;
+    std::sort( m_byMangled.begin(), m_byMangled.end(), less );
+}
+
+QVector<int>
+FilterRules::append( const FilterFile::rule& r )
+{
+    int index = m_filter.rules().size();
+    m_filter.append( r );
+    QByteArray   pattern = r.pattern.toUtf8();
+    QVector<int> changed;
+    if ( r.target == FilterFile::FILE_NAMES )
+    {
+        for ( int file = 0; file < m_files.size(); file++ )
+        {
+            if ( m_files[ file ].empty() || !FilterFile::matches( pattern, m_files[ file ] ) )
+            {
+                continue;
+            }
+            const QVector<int>& keys = m_fileFunctions[ file ];
+            for ( int i = 0; i < keys.size(); i++ )
+            {
+                bool before = isExcluded( keys[ i ] );
+                m_fileRule[ keys[ i ] ] = index;
+                if ( isExcluded( keys[ i ] ) != before )
+                {
+                    changed.append( keys[ i ] );
+                }
+            }
+        }
+        std::sort( changed.begin(), changed.end() );
+        return changed;
+    }
+
+    /*every match starts with the literal head of the pattern*/
+    const QVector<int>& order = r.mangled ? m_byMangled : m_byRegion;
+    nameLess            less;
+    less.rows    = &m_functions->rows;
+    less.mangled = r.mangled;
+    std::string                  head( pattern.constData(), FilterFile::literalHead( pattern ) );
+    QVector<int>::const_iterator it = std::lower_bound( order.begin(), order.end(), head, less );
+    for ( ; it != order.end() && less.name( *it ).compare( 0, head.size(), head ) == 0; ++it )
+    {
+        if ( !FilterFile::matches( pattern, less.name( *it ) ) )
+        {
+            continue;
+        }
+        bool before = isExcluded( *it );
+        m_regionRule[ *it ] = index;
+        if ( isExcluded( *it ) != before )
+        {
+            changed.append( *it );
+        }
+    }
+    std::sort( changed.begin(), changed.end() );
+    return changed;
+}
+
+bool
+FilterRules::isExcluded( int key ) const
+{
+    const QVector<FilterFile::rule>& rules = m_filter.rules();
+    return ( m_fileRule[ key ] >= 0 && rules[ m_fileRule[ key ] ].exclude ) ||
+           ( m_regionRule[ key ] >= 0 && rules[ m_regionRule[ key ] ].exclude );
+}
+
+QVector<int>
+FilterRules::excludedKeys() const
+{
+    QVector<int> keys;
+    for ( int key = 0; key < m_fileRule.size(); key++ )
+    {
+        if ( isExcluded( key ) )
+        {
+            keys.append( key );
+        }
+    }
+    return keys;
+}
+
+const QVector<FilterFile::rule>&
+FilterRules::rules() const
+{
+    return m_filter.rules();
+}
+
+int
+FilterRules::fileNum() const
+{
+    return m_files.size();
+}
+
+const std::string&
+FilterRules::fileName( int file ) const
+{
+    return m_files[ file ];
+}
+
+const QVector<int>&
+FilterRules::fileFunctions( int file ) const
+{
+    return m_fileFunctions[ file ];
+}
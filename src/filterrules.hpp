@@ -0,0 +1,80 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#ifndef FILTERRULES_HPP
+#define FILTERRULES_HPP
+
+#include <QtGlobal>
+#include <QVector>
+#include <QSharedPointer>
+
+#include "data.hpp"
+#include "filterfile.hpp"
+
+/*
+ * Filter rules built up in the GUI, evaluated with the precedence of
+ * Score-P: the last matching file rule and the last matching region rule
+ * decide, and a function is excluded if either of them excludes it.
+ *
+ * The last matching rule of both kinds is kept for every function. A new
+ * rule is the last one, so it only changes the functions it matches. A
+ * file rule is matched against the distinct file names, a region rule
+ * only against the functions whose name starts with its literal head,
+ * found in the functions sorted by name.
+ */
+class FilterRules
+{
+public:
+    FilterRules();
+
+    /*evaluates all rules for every function in parallel, the names are
+     * only indexed again for another snapshot*/
+    void
+    reset( QSharedPointer<const dataCenter::functionSnapshot> functions,
+           const QVector<FilterFile::rule>&                   rules = QVector<FilterFile::rule>() );
+    /*appends r as the last rule, returns the sorted keys whose verdict changed*/
+    QVector<int>
+    append( const FilterFile::rule& r );
+
+    bool
+    isExcluded( int key ) const;
+    QVector<int>
+    excludedKeys() const;
+    /*shared, unchanged rules keep the same data*/
+    const QVector<FilterFile::rule>&
+    rules() const;
+
+    int
+    fileNum() const;
+    const std::string&
+    fileName( int file ) const;
+    const QVector<int>&
+    fileFunctions( int file ) const;
+
+private:
+    QSharedPointer<const dataCenter::functionSnapshot> m_functions;
+    FilterFile                                         m_filter;
+    /*last matching file and region rule of every function, -1 for none*/
+    QVector<int>                                       m_fileRule;
+    QVector<int>                                       m_regionRule;
+    /*distinct file names and the keys of their functions*/
+    QVector<std::string>                               m_files;
+    QVector<QVector<int> >                             m_fileFunctions;
+    /*keys sorted by region name and by the name MANGLED rules match*/
+    QVector<int>                                       m_byRegion;
+    QVector<int>                                       m_byMangled;
+
+    void
+    indexNames();
+};
+
+#endif // FILTERRULES_HPP
@@ -0,0 +1,154 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#include "filtersaver.hpp"
+
+FilterSaver::FilterSaver( QWidget* parent )
+    : QObject( parent )
+    , mp_parent( parent )
+{
+    mp_compress = new QAction( "Compress with wildcards", this );
+    mp_compress->setCheckable( true );
+    mp_compress->setToolTip( "Save the excluded regions as few wildcard patterns" );
+}
+
+QAction*
+FilterSaver::compressAction()
+{
+    return mp_compress;
+}
+
+QString
+FilterSaver::fileName() const
+{
+    return m_fileName;
+}
+
+void
+FilterSaver::setFileName( const QString& fileName )
+{
+    m_fileName = fileName;
+}
+
+void
+FilterSaver::save( Connector* connection )
+{
+    emit message( QString() );
+    if ( !connection->hasFiltered() )
+    {
+        emit message( "Error: No functions to filter" );
+        return;
+    }
+    if ( m_fileName.isEmpty() )
+    {
+        QString fileName = askFileName();
+        if ( fileName.isEmpty() )
+        {
+            return;
+        }
+        m_fileName = fileName;
+    }
+    write( connection, m_fileName );
+}
+
+void
+FilterSaver::saveAs( Connector* connection )
+{
+    emit message( QString() );
+    if ( !connection->hasFiltered() )
+    {
+        emit message( "Error: No functions to filter" );
+        return;
+    }
+    QString fileName = askFileName();
+    if ( fileName.isEmpty() )
+    {
+        return;
+    }
+    m_fileName = fileName;
+    write( connection, m_fileName );
+}
+
+void
+FilterSaver::exportFilter( Connector* connection )
+{
+    emit message( QString() );
+    if ( !connection->hasFiltered() )
+    {
+        emit message( "Error: No functions to filter" );
+        return;
+    }
+    QString selected;
+    QString fileName = QFileDialog::getSaveFileName( mp_parent, tr( "Export filter" ), QDir::currentPath(),
+                                                     tr( "Region lists (*.txt);;JSON reports (*.json);;Filter files (*.filter)" ),
+                                                     &selected );
+    if ( fileName.isEmpty() )
+    {
+        return;
+    }
+    /*the suffix chooses the format, the chosen file type adds a missing one*/
+    QString suffix = selected.section( '*', 1 ).section( ')', 0, 0 );
+    if ( !fileName.endsWith( ".txt" ) && !fileName.endsWith( ".json" ) && !fileName.endsWith( ".filter" ) )
+    {
+        fileName += suffix.isEmpty() ? QString( ".txt" ) : suffix;
+    }
+    QElapsedTimer timer;
+    timer.start();
+    QString error;
+    if ( !connection->exportFilter( fileName, mp_compress->isChecked(), 0, 0, &error ) )
+    {
+        emit message( "Error: Export failed, " + error );
+        return;
+    }
+    emit message( "Exported to " + fileName );
+    emit timed( "export", timer.elapsed() );
+}
+
+QString
+FilterSaver::askFileName()
+{
+    QString fileName = QFileDialog::getSaveFileName( mp_parent, tr( "Save filter file" ), QDir::currentPath(),
+                                                     tr( "Filter files (*.filter)" ) );
+    if ( !fileName.isEmpty() && !fileName.endsWith( ".filter" ) )
+    {
+        fileName += ".filter";
+    }
+    return fileName;
+}
+
+void
+FilterSaver::write( Connector* connection, const QString& fileName )
+{
+    int     ruleNum    = 0;
+    bool    compressed = false;
+    QString error;
+    if ( !connection->exportFilter( fileName, mp_compress->isChecked(), &ruleNum, &compressed, &error ) )
+    {
+        emit message( "Error: Saving filter file failed, " + error );
+        return;
+    }
+    if ( compressed )
+    {
+        emit message( QString( "Filter file saved at %1 with %2 patterns" ).arg( fileName ).arg( ruleNum ) );
+    }
+    else if ( mp_compress->isChecked() )
+    {
+        emit message( QString( "Filter file saved at %1 with %2 region names, "
+                               "no patterns matched exactly the excluded regions" )
+                      .arg( fileName ).arg( ruleNum ) );
+    }
+    else
+    {
+        emit message( QString( "Filter file saved at %1 with %2 regions" ).arg( fileName ).arg( ruleNum ) );
+    }
+    emit saved();
+}
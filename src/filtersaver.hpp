@@ -0,0 +1,81 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#ifndef FILTERSAVER_HPP
+#define FILTERSAVER_HPP
+
+#include <QObject>
+#include <QWidget>
+#include <QAction>
+#include <QString>
+#include <QFileDialog>
+#include <QElapsedTimer>
+
+#include "connector.hpp"
+
+/*
+ * Saving the excluded functions of a connector: to the filter file, to
+ * a newly chosen one, or as an export whose suffix chooses the format,
+ * see FilterExport. The outcome is reported as a message for the status
+ * bar.
+ */
+class FilterSaver : public QObject
+{
+    Q_OBJECT
+
+public:
+    /*parent owns the file dialogs*/
+    FilterSaver( QWidget* parent );
+
+    /*checkable, the filter file gets wildcard patterns instead of the
+     * plain list*/
+    QAction*
+    compressAction();
+    /*empty until the filter was saved or a session set it*/
+    QString
+    fileName() const;
+    void
+    setFileName( const QString& fileName );
+
+    /*asks for a file name before the first save*/
+    void
+    save( Connector* connection );
+    void
+    saveAs( Connector* connection );
+    /*does not change the filter file*/
+    void
+    exportFilter( Connector* connection );
+
+signals:
+    void
+    message( QString text );
+    /*the filter file was written*/
+    void
+    saved();
+    void
+    timed( QString what,
+           qint64  milliseconds );
+
+private:
+    QWidget* mp_parent;
+    QAction* mp_compress;
+    QString  m_fileName;
+
+    /*empty if the dialog was cancelled*/
+    QString
+    askFileName();
+    void
+    write( Connector*     connection,
+           const QString& fileName );
+};
+
+#endif // FILTERSAVER_HPP
@@ -0,0 +1,311 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#include <algorithm>
+
+#include "filterstate.hpp"
+
+/*64 words, 4096 functions per bit chunk*/
+#define FILTERSTATE_BIT_CHUNK 64
+/*processes per chunk of filtered totals*/
+#define FILTERSTATE_TOTAL_CHUNK 1024
+
+FilterState::FilterState() :
+    m_functionNum( 0 ),
+    m_processNum( 0 ),
+    m_excludedCount( 0 ),
+    m_hasSizes( false ),
+    m_traceSize( 0 ),
+    m_maxBuf( 0 )
+{
+}
+
+void
+FilterState::reset( int functionNum )
+{
+    int words  = ( functionNum + 63 ) / 64;
+    int chunks = ( words + FILTERSTATE_BIT_CHUNK - 1 ) / FILTERSTATE_BIT_CHUNK;
+    m_bits.clear();
+    m_totals.clear();
+    for ( int i = 0; i < chunks; i++ )
+    {
+        m_bits.append( QVector<quint64>( qMin( FILTERSTATE_BIT_CHUNK, words - i * FILTERSTATE_BIT_CHUNK ), 0 ) );
+    }
+    m_functionNum   = functionNum;
+    m_processNum    = 0;
+    m_excludedCount = 0;
+    m_hasSizes      = false;
+    m_traceSize     = 0;
+    m_maxBuf        = 0;
+}
+
+int
+FilterState::functionNum() const
+{
+    return m_functionNum;
+}
+
+bool
+FilterState::isExcluded( int key ) const
+{
+    int word = key / 64;
+    return ( m_bits.at( word / FILTERSTATE_BIT_CHUNK ).at( word % FILTERSTATE_BIT_CHUNK ) >> ( key % 64 ) ) & 1;
+}
+
+bool
+FilterState::setExcluded( int key, bool excluded )
+{
+    if ( isExcluded( key ) == excluded )
+    {
+        return false;
+    }
+    /*non-const access detaches only the touched chunk*/
+    int      word = key / 64;
+    quint64& bits = m_bits[ word / FILTERSTATE_BIT_CHUNK ][ word % FILTERSTATE_BIT_CHUNK ];
+    bits            ^= Q_UINT64_C( 1 ) << ( key % 64 );
+    m_excludedCount += excluded ? 1 : -1;
+    m_hasSizes       = false;
+    m_totals.clear();
+    m_processNum = 0;
+    return true;
+}
+
+int
+FilterState::excludedCount() const
+{
+    return m_excludedCount;
+}
+
+bool
+FilterState::sameSelection( const FilterState& other ) const
+{
+    return m_excludedCount == other.m_excludedCount && m_bits == other.m_bits;
+}
+
+QVector<int>
+FilterState::excludedKeys() const
+{
+    QVector<int> keys;
+    keys.reserve( m_excludedCount );
+    for ( int c = 0; c < m_bits.size(); c++ )
+    {
+        const QVector<quint64>& chunk = m_bits[ c ];
+        for ( int w = 0; w < chunk.size(); w++ )
+        {
+            quint64 bits = chunk[ w ];
+            int     base = ( c * FILTERSTATE_BIT_CHUNK + w ) * 64;
+            for ( int b = 0; bits != 0; b++, bits >>= 1 )
+            {
+                if ( bits & 1 )
+                {
+                    keys.append( base + b );
+                }
+            }
+        }
+    }
+    return keys;
+}
+
+QVector<int>
+FilterState::changedKeys( const FilterState& other ) const
+{
+    QVector<int> keys;
+    for ( int c = 0; c < m_bits.size(); c++ )
+    {
+        const QVector<quint64>& chunk = m_bits[ c ];
+        const QVector<quint64>& old   = other.m_bits[ c ];
+        if ( chunk.constData() == old.constData() )
+        {
+            continue;
+        }
+        for ( int w = 0; w < chunk.size(); w++ )
+        {
+            quint64 bits = chunk[ w ] ^ old[ w ];
+            int     base = ( c * FILTERSTATE_BIT_CHUNK + w ) * 64;
+            for ( int b = 0; bits != 0; b++, bits >>= 1 )
+            {
+                if ( bits & 1 )
+                {
+                    keys.append( base + b );
+                }
+            }
+        }
+    }
+    return keys;
+}
+
+bool
+FilterState::hasSizes() const
+{
+    return m_hasSizes;
+}
+
+void
+FilterState::setSizes( const QVector<uint64_t>& processTotals, uint64_t traceSize,
+                       uint64_t maxBuf, const FilterState* previous )
+{
+    m_totals.clear();
+    m_processNum = processTotals.size();
+    for ( int begin = 0; begin < processTotals.size(); begin += FILTERSTATE_TOTAL_CHUNK )
+    {
+        int c    = begin / FILTERSTATE_TOTAL_CHUNK;
+        int size = qMin( FILTERSTATE_TOTAL_CHUNK, processTotals.size() - begin );
+        if ( previous && c < previous->m_totals.size() &&
+             previous->m_totals[ c ].size() == size &&
+             std::equal( previous->m_totals[ c ].constBegin(), previous->m_totals[ c ].constEnd(),
+                         processTotals.constBegin() + begin ) )
+        {
+            m_totals.append( previous->m_totals[ c ] );
+        }
+        else
+        {
+            QVector<uint64_t> chunk( size );
+            std::copy( processTotals.constBegin() + begin, processTotals.constBegin() + begin + size,
+                       chunk.begin() );
+            m_totals.append( chunk );
+        }
+    }
+    m_hasSizes  = true;
+    m_traceSize = traceSize;
+    m_maxBuf    = maxBuf;
+}
+
+void
+FilterState::setSizes( uint64_t traceSize, uint64_t maxBuf )
+{
+    m_totals.clear();
+    m_processNum = 0;
+    m_hasSizes   = true;
+    m_traceSize  = traceSize;
+    m_maxBuf     = maxBuf;
+}
+
+uint64_t
+FilterState::traceSize() const
+{
+    return m_traceSize;
+}
+
+uint64_t
+FilterState::maxBuf() const
+{
+    return m_maxBuf;
+}
+
+bool
+FilterState::hasProcessTotals() const
+{
+    return m_hasSizes && m_processNum > 0;
+}
+
+QVector<uint64_t>
+FilterState::processTotals() const
+{
+    QVector<uint64_t> totals;
+    totals.reserve( m_processNum );
+    for ( int c = 0; c < m_totals.size(); c++ )
+    {
+        totals += m_totals[ c ];
+    }
+    return totals;
+}
+
+QDataStream&
+operator<<( QDataStream& out, const FilterState& state )
+{
+    out << ( qint32 )state.m_functionNum << ( qint32 )state.m_excludedCount;
+    for ( int c = 0; c < state.m_bits.size(); c++ )
+    {
+        for ( int w = 0; w < state.m_bits[ c ].size(); w++ )
+        {
+            out << state.m_bits[ c ][ w ];
+        }
+    }
+    out << state.m_hasSizes << ( quint64 )state.m_traceSize << ( quint64 )state.m_maxBuf
+        << ( qint32 )state.m_processNum;
+    for ( int c = 0; c < state.m_totals.size(); c++ )
+    {
+        for ( int i = 0; i < state.m_totals[ c ].size(); i++ )
+        {
+            out << ( quint64 )state.m_totals[ c ][ i ];
+        }
+    }
+    return out;
+}
+
+QDataStream&
+operator>>( QDataStream& in, FilterState& state )
+{
+    qint32 functionNum   = 0;
+    qint32 excludedCount = 0;
+    in >> functionNum >> excludedCount;
+    if ( functionNum < 0 || excludedCount < 0 || excludedCount > functionNum )
+    {
+        in.setStatus( QDataStream::ReadCorruptData );
+    }
+    if ( in.status() != QDataStream::Ok )
+    {
+        return in;
+    }
+    state.reset( functionNum );
+    int count = 0;
+    for ( int c = 0; c < state.m_bits.size() && in.status() == QDataStream::Ok; c++ )
+    {
+        QVector<quint64>& chunk = state.m_bits[ c ];
+        for ( int w = 0; w < chunk.size(); w++ )
+        {
+            in >> chunk[ w ];
+            for ( quint64 bits = chunk[ w ]; bits != 0; bits &= bits - 1 )
+            {
+                count++;
+            }
+        }
+    }
+    /*bits past the last function would be counted but never shown*/
+    int last = state.m_bits.isEmpty() ? 0 : state.m_bits.last().size();
+    if ( count != excludedCount || ( functionNum % 64 != 0 && last > 0 &&
+                                     state.m_bits.last()[ last - 1 ] >> ( functionNum % 64 ) != 0 ) )
+    {
+        in.setStatus( QDataStream::ReadCorruptData );
+    }
+    state.m_excludedCount = excludedCount;
+
+    bool    hasSizes   = false;
+    quint64 traceSize  = 0;
+    quint64 maxBuf     = 0;
+    qint32  processNum = 0;
+    in >> hasSizes >> traceSize >> maxBuf >> processNum;
+    if ( processNum < 0 || ( processNum > 0 && !hasSizes ) )
+    {
+        in.setStatus( QDataStream::ReadCorruptData );
+    }
+    QVector<uint64_t> totals;
+    for ( int i = 0; i < processNum && in.status() == QDataStream::Ok; i++ )
+    {
+        quint64 total = 0;
+        in >> total;
+        totals.append( total );
+    }
+    if ( in.status() != QDataStream::Ok || !hasSizes )
+    {
+        return in;
+    }
+    if ( processNum > 0 )
+    {
+        state.setSizes( totals, traceSize, maxBuf, 0 );
+    }
+    else
+    {
+        state.setSizes( traceSize, maxBuf );
+    }
+    return in;
+}
@@ -0,0 +1,97 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#ifndef FILTERSTATE_HPP
+#define FILTERSTATE_HPP
+
+#include <QtGlobal>
+#include <QVector>
+#include <QDataStream>
+#include <stdint.h>
+
+/*
+ * Excluded functions plus the filtered sizes belonging to them.
+ * Both are stored in chunks of implicitly shared QVectors, so a copy of a
+ * state is cheap and two states only differ in the chunks that were
+ * written after the copy. This is what makes the undo history small.
+ */
+class FilterState
+{
+public:
+    FilterState();
+
+    void
+    reset( int functionNum );
+    int
+    functionNum() const;
+
+    bool
+    isExcluded( int key ) const;
+    /*returns false if the state did not change*/
+    bool
+    setExcluded( int  key,
+                 bool excluded );
+    int
+    excludedCount() const;
+    /*cheap if the states share their chunks*/
+    bool
+    sameSelection( const FilterState& other ) const;
+    QVector<int>
+    excludedKeys() const;
+    /*keys excluded in only one of the states, both must have the same
+     * number of functions, shared chunks are skipped*/
+    QVector<int>
+    changedKeys( const FilterState& other ) const;
+
+    /*sizes are only valid until the next call of setExcluded*/
+    bool
+    hasSizes() const;
+    /*chunks that are equal to the ones of previous are shared with it*/
+    void
+    setSizes( const QVector<uint64_t>& processTotals,
+              uint64_t                 traceSize,
+              uint64_t                 maxBuf,
+              const FilterState*       previous );
+    /*sizes known without per process data, e.g. from the frontier*/
+    void
+    setSizes( uint64_t traceSize,
+              uint64_t maxBuf );
+    uint64_t
+    traceSize() const;
+    uint64_t
+    maxBuf() const;
+    bool
+    hasProcessTotals() const;
+    QVector<uint64_t>
+    processTotals() const;
+
+    /*the excluded functions and the sizes, the stream status tells
+     * whether reading succeeded*/
+    friend QDataStream&
+    operator<<( QDataStream&       out,
+                const FilterState& state );
+    friend QDataStream&
+    operator>>( QDataStream& in,
+                FilterState& state );
+
+private:
+    QVector<QVector<quint64> >  m_bits;
+    QVector<QVector<uint64_t> > m_totals;
+    int                         m_functionNum;
+    int                         m_processNum;
+    int                         m_excludedCount;
+    bool                        m_hasSizes;
+    uint64_t                    m_traceSize;
+    uint64_t                    m_maxBuf;
+};
+
+#endif // FILTERSTATE_HPP
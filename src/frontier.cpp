@@ -0,0 +1,151 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#include <algorithm>
+
+#include "frontier.hpp"
+
+/*processes per block, the max of a block is only recalculated if it changed*/
+#define FRONTIER_BLOCK_SIZE 1024
+
+namespace
+{
+struct candidate
+{
+    int    key;
+    double ratio;
+};
+
+bool
+higherRatio( const candidate& a, const candidate& b )
+{
+    if ( a.ratio != b.ratio )
+    {
+        return a.ratio > b.ratio;
+    }
+    return a.key < b.key;
+}
+
+uint64_t
+blockMax( const QVector<uint64_t>& totals, int block )
+{
+    uint64_t max   = 0;
+    int      begin = block * FRONTIER_BLOCK_SIZE;
+    int      end   = qMin( begin + FRONTIER_BLOCK_SIZE, totals.size() );
+    for ( int i = begin; i < end; i++ )
+    {
+        max = qMax( max, totals[ i ] );
+    }
+    return max;
+}
+}
+
+FilterFrontier::result
+FilterFrontier::compute( const input& in )
+{
+    result res;
+    res.totalTime = in.totalTime;
+
+    QVector<uint64_t> totals    = in.processTotals;
+    uint64_t          traceSize = 0;
+    for ( int i = 0; i < totals.size(); i++ )
+    {
+        traceSize += totals[ i ];
+    }
+
+    /*greedy order: most bytes saved per excluded second first*/
+    QVector<candidate> ranked;
+    ranked.reserve( in.candidates.size() );
+    for ( int i = 0; i < in.candidates.size(); i++ )
+    {
+        int      key   = in.candidates[ i ];
+        uint64_t bytes = 0;
+        const QVector<dataCenter::processBytes>& row = in.rows[ key ];
+        for ( int j = 0; j < row.size(); j++ )
+        {
+            bytes += row[ j ].bytes;
+        }
+        if ( bytes == 0 )
+        {
+            continue;
+        }
+        candidate c;
+        c.key   = key;
+        c.ratio = bytes / ( in.times[ key ] + 1e-9 );
+        ranked.append( c );
+    }
+    std::sort( ranked.begin(), ranked.end(), higherRatio );
+
+    int               blockNum = ( totals.size() + FRONTIER_BLOCK_SIZE - 1 ) / FRONTIER_BLOCK_SIZE;
+    QVector<uint64_t> blocks( blockNum );
+    QVector<bool>     dirty( blockNum, false );
+    QVector<int>      dirtyList;
+    uint64_t          maxBuf = 0;
+    for ( int b = 0; b < blockNum; b++ )
+    {
+        blocks[ b ] = blockMax( totals, b );
+        maxBuf      = qMax( maxBuf, blocks[ b ] );
+    }
+
+    point start;
+    start.excludedCount = 0;
+    start.excludedTime  = 0;
+    start.traceSize     = traceSize;
+    start.maxBuf        = maxBuf;
+    res.points.append( start );
+
+    double excludedTime = 0;
+    res.order.reserve( ranked.size() );
+    for ( int i = 0; i < ranked.size(); i++ )
+    {
+        int key = ranked[ i ].key;
+        res.order.append( key );
+        excludedTime += in.times[ key ];
+
+        const QVector<dataCenter::processBytes>& row = in.rows[ key ];
+        for ( int j = 0; j < row.size(); j++ )
+        {
+            int process = row[ j ].process;
+            totals[ process ] -= row[ j ].bytes;
+            traceSize         -= row[ j ].bytes;
+            int block = process / FRONTIER_BLOCK_SIZE;
+            if ( !dirty[ block ] )
+            {
+                dirty[ block ] = true;
+                dirtyList.append( block );
+            }
+        }
+        for ( int j = 0; j < dirtyList.size(); j++ )
+        {
+            blocks[ dirtyList[ j ] ] = blockMax( totals, dirtyList[ j ] );
+            dirty[ dirtyList[ j ] ]  = false;
+        }
+        dirtyList.clear();
+        maxBuf = 0;
+        for ( int b = 0; b < blockNum; b++ )
+        {
+            maxBuf = qMax( maxBuf, blocks[ b ] );
+        }
+
+        /*only keep points that are not dominated by a cheaper one*/
+        if ( maxBuf < res.points.last().maxBuf )
+        {
+            point p;
+            p.excludedCount = i + 1;
+            p.excludedTime  = excludedTime;
+            p.traceSize     = traceSize;
+            p.maxBuf        = maxBuf;
+            res.points.append( p );
+        }
+    }
+    return res;
+}
@@ -0,0 +1,57 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#ifndef FRONTIER_HPP
+#define FRONTIER_HPP
+
+#include <QtGlobal>
+#include <QVector>
+#include <stdint.h>
+
+#include "data.hpp"
+
+/*trade-off curve between excluded time and the remaining max_buf*/
+class FilterFrontier
+{
+public:
+    struct input
+    {
+        /*unfiltered bytes per process*/
+        QVector<uint64_t>                           processTotals;
+        /*keys of the functions that can be filtered*/
+        QVector<int>                                candidates;
+        /*time[s] and per process bytes, indexed by function key*/
+        QVector<double>                             times;
+        QVector<QVector<dataCenter::processBytes> > rows;
+        double                                      totalTime;
+    };
+    struct point
+    {
+        /*the first excludedCount keys of the order are excluded*/
+        int      excludedCount;
+        double   excludedTime;
+        uint64_t traceSize;
+        uint64_t maxBuf;
+    };
+    struct result
+    {
+        QVector<int>   order;
+        QVector<point> points;
+        double         totalTime;
+    };
+
+    /*runs in a worker thread, only touches its input*/
+    static result
+    compute( const input& in );
+};
+
+#endif // FRONTIER_HPP
@@ -0,0 +1,151 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#include "frontierwidget.hpp"
+
+FrontierPlot::FrontierPlot( QWidget* parent )
+    : QWidget( parent )
+    , m_current( 0 )
+{
+    setFixedHeight( 90 );
+}
+
+void
+FrontierPlot::setFrontier( const FilterFrontier::result& frontier )
+{
+    m_frontier = frontier;
+    m_current  = 0;
+    update();
+}
+
+void
+FrontierPlot::setCurrent( int index )
+{
+    m_current = index;
+    update();
+}
+
+QPointF
+FrontierPlot::map( const FilterFrontier::point& p, const QRectF& area )
+{
+    /*x: share of excluded time, y: max_buf relative to the unfiltered one*/
+    double x = 0;
+    double y = 0;
+    if ( m_frontier.totalTime > 0 )
+    {
+        x = p.excludedTime / m_frontier.totalTime;
+    }
+    if ( m_frontier.points.first().maxBuf > 0 )
+    {
+        y = ( double )p.maxBuf / m_frontier.points.first().maxBuf;
+    }
+    return QPointF( area.left() + x * area.width(), area.bottom() - y * area.height() );
+}
+
+void
+FrontierPlot::paintEvent( QPaintEvent* event )
+{
+    Q_UNUSED( event );
+    QPainter painter( this );
+    QRectF   area = rect().adjusted( 6, 6, -6, -6 );
+    painter.fillRect( rect(), palette().base() );
+    painter.setPen( palette().mid().color() );
+    painter.drawLine( area.bottomLeft(), area.bottomRight() );
+    painter.drawLine( area.bottomLeft(), area.topLeft() );
+    if ( m_frontier.points.size() == 0 )
+    {
+        return;
+    }
+
+    /*steps: max_buf stays until the next point is reached*/
+    QPolygonF curve;
+    for ( int i = 0; i < m_frontier.points.size(); i++ )
+    {
+        QPointF p = map( m_frontier.points[ i ], area );
+        if ( i > 0 )
+        {
+            curve << QPointF( p.x(), curve.last().y() );
+        }
+        curve << p;
+    }
+    painter.setRenderHint( QPainter::Antialiasing );
+    painter.setPen( QPen( palette().highlight().color(), 1.5 ) );
+    painter.drawPolyline( curve );
+
+    if ( m_current >= 0 && m_current < m_frontier.points.size() )
+    {
+        painter.setBrush( palette().highlight() );
+        painter.drawEllipse( map( m_frontier.points[ m_current ], area ), 4, 4 );
+    }
+}
+
+FrontierWidget::FrontierWidget( QWidget* parent )
+    : QWidget( parent )
+{
+    QVBoxLayout* layout = new QVBoxLayout( this );
+    QHBoxLayout* row    = new QHBoxLayout();
+    layout->setContentsMargins( 0, 0, 0, 0 );
+    mp_plot   = new FrontierPlot( this );
+    mp_slider = new QSlider( Qt::Horizontal, this );
+    mp_label  = new QLabel( this );
+    mp_slider->setEnabled( false );
+    mp_label->setMinimumWidth( 260 );
+    row->addWidget( mp_slider );
+    row->addWidget( mp_label );
+    layout->addWidget( mp_plot );
+    layout->addLayout( row );
+
+    connect( mp_slider, SIGNAL( valueChanged( int ) ), this, SLOT( sliderMoved( int ) ) );
+}
+
+void
+FrontierWidget::setFrontier( const FilterFrontier::result& frontier )
+{
+    m_frontier = frontier;
+    mp_plot->setFrontier( frontier );
+    mp_slider->blockSignals( true );
+    mp_slider->setRange( 0, qMax( 0, frontier.points.size() - 1 ) );
+    mp_slider->setValue( 0 );
+    mp_slider->blockSignals( false );
+    mp_slider->setEnabled( frontier.points.size() > 1 );
+    mp_label->setText( QString( "%1 filter steps" ).arg( frontier.points.size() - 1 ) );
+}
+
+void
+FrontierWidget::clear( const QString& message )
+{
+    FilterFrontier::result empty;
+    empty.totalTime = 0;
+    setFrontier( empty );
+    mp_label->setText( message );
+}
+
+void
+FrontierWidget::sliderMoved( int index )
+{
+    if ( index < 0 || index >= m_frontier.points.size() )
+    {
+        return;
+    }
+    const FilterFrontier::point& p = m_frontier.points[ index ];
+    double                       share = 0;
+    if ( m_frontier.totalTime > 0 )
+    {
+        share = 100.0 * p.excludedTime / m_frontier.totalTime;
+    }
+    mp_label->setText( QString( "%1 regions, %2 s (%3%) excluded" )
+                       .arg( p.excludedCount )
+                       .arg( p.excludedTime, 0, 'f', 2 )
+                       .arg( share, 0, 'f', 2 ) );
+    mp_plot->setCurrent( index );
+    emit pointSelected( index );
+}
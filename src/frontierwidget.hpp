@@ -0,0 +1,76 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#ifndef FRONTIERWIDGET_HPP
+#define FRONTIERWIDGET_HPP
+
+#include <QWidget>
+#include <QSlider>
+#include <QLabel>
+#include <QLayout>
+#include <QPainter>
+
+#include "frontier.hpp"
+
+/*draws the excluded time / max_buf curve*/
+class FrontierPlot : public QWidget
+{
+public:
+    FrontierPlot( QWidget* parent = 0 );
+
+    void
+    setFrontier( const FilterFrontier::result& frontier );
+    void
+    setCurrent( int index );
+
+protected:
+    void
+    paintEvent( QPaintEvent* event );
+
+private:
+    FilterFrontier::result m_frontier;
+    int                    m_current;
+
+    QPointF
+    map( const FilterFrontier::point& p,
+         const QRectF&                area );
+};
+
+/*curve plus a slider to pick one of its points*/
+class FrontierWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    FrontierWidget( QWidget* parent = 0 );
+
+    void
+    setFrontier( const FilterFrontier::result& frontier );
+    void
+    clear( const QString& message = QString() );
+
+signals:
+    void
+    pointSelected( int index );
+
+private:
+    FrontierPlot*          mp_plot;
+    QSlider*               mp_slider;
+    QLabel*                mp_label;
+    FilterFrontier::result m_frontier;
+
+private slots:
+    void
+    sliderMoved( int index );
+};
+
+#endif // FRONTIERWIDGET_HPP
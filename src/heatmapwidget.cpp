@@ -0,0 +1,231 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#include <math.h>
+
+#include "heatmapwidget.hpp"
+
+namespace
+{
+const char* bandNames[ 3 ] = { "max", "mean", "min" };
+
+QString
+readable( double bytes )
+{
+    const char* units[] = { "B", "kB", "MB", "GB", "TB" };
+    int         unit    = 0;
+    while ( bytes >= 1024 && unit < 4 )
+    {
+        bytes /= 1024;
+        unit++;
+    }
+    return QString::number( bytes, 'f', unit == 0 ? 0 : 1 ) + units[ unit ];
+}
+}
+
+HeatmapWidget::HeatmapWidget( QWidget* parent )
+    : QWidget( parent )
+    , m_first( 0 )
+    , m_span( 0 )
+    , m_dragX( -1 )
+    , m_dragFirst( 0 )
+{
+    setFixedHeight( 70 );
+    setMouseTracking( true );
+}
+
+void
+HeatmapWidget::setValues( const ProcessPyramid& pyramid, const QString& title )
+{
+    if ( pyramid.size() != m_pyramid.size() )
+    {
+        m_first = 0;
+        m_span  = pyramid.size();
+    }
+    m_pyramid = pyramid;
+    m_title   = title;
+    clampView();
+    update();
+}
+
+void
+HeatmapWidget::clear( const QString& message )
+{
+    m_pyramid = ProcessPyramid();
+    m_title   = message;
+    m_first   = 0;
+    m_span    = 0;
+    update();
+}
+
+QRect
+HeatmapWidget::plotArea() const
+{
+    /*room for the title above and the band names on the left*/
+    return rect().adjusted( 40, fontMetrics().height() + 4, -6, -4 );
+}
+
+void
+HeatmapWidget::processRange( int x, int* first, int* last ) const
+{
+    QRect  area = plotArea();
+    double from = m_first + m_span * ( x - area.left() ) / area.width();
+    double to   = m_first + m_span * ( x + 1 - area.left() ) / area.width();
+    *first = ( int )floor( from );
+    /*zoomed in further than one process per pixel*/
+    *last = qMax( *first + 1, ( int )ceil( to ) );
+}
+
+void
+HeatmapWidget::clampView()
+{
+    int size = m_pyramid.size();
+    m_span  = qMax( qMin( m_span, ( double )size ), qMin( 8.0, ( double )size ) );
+    m_first = qMax( 0.0, qMin( m_first, size - m_span ) );
+}
+
+QColor
+HeatmapWidget::heat( double value ) const
+{
+    /*blue for idle processes to red for the ones defining max_buf*/
+    double share = m_pyramid.maxValue() > 0 ? value / m_pyramid.maxValue() : 0;
+    return QColor::fromHsvF( ( 1 - qMin( 1.0, share ) ) * 0.66, 0.85, 0.95 );
+}
+
+void
+HeatmapWidget::paintEvent( QPaintEvent* event )
+{
+    Q_UNUSED( event );
+    QPainter painter( this );
+    QRect    area = plotArea();
+    painter.fillRect( rect(), palette().base() );
+    painter.setPen( palette().text().color() );
+    if ( m_pyramid.size() == 0 || area.width() <= 0 )
+    {
+        painter.drawText( rect().adjusted( 6, 2, -6, 0 ), Qt::AlignLeft | Qt::AlignTop, m_title );
+        return;
+    }
+    painter.drawText( rect().adjusted( 6, 2, -6, 0 ), Qt::AlignLeft | Qt::AlignTop,
+                      QString( "%1 - processes %2 to %3 of %4, max %5" )
+                      .arg( m_title )
+                      .arg( ( int )m_first )
+                      .arg( ( int )( m_first + m_span ) - 1 )
+                      .arg( m_pyramid.size() )
+                      .arg( readable( m_pyramid.maxValue() ) ) );
+
+    int bandHeight = area.height() / 3;
+    for ( int band = 0; band < 3; band++ )
+    {
+        painter.drawText( QRect( 0, area.top() + band * bandHeight, area.left() - 4, bandHeight ),
+                          Qt::AlignRight | Qt::AlignVCenter, bandNames[ band ] );
+    }
+    /*one pyramid query per pixel column, independent of the process count*/
+    for ( int x = area.left(); x <= area.right(); x++ )
+    {
+        int first;
+        int last;
+        processRange( x, &first, &last );
+        ProcessPyramid::bucket b = m_pyramid.range( first, last );
+        if ( b.count == 0 )
+        {
+            continue;
+        }
+        double values[ 3 ] = { ( double )b.max, b.sum / b.count, ( double )b.min };
+        for ( int band = 0; band < 3; band++ )
+        {
+            painter.fillRect( QRect( x, area.top() + band * bandHeight, 1, bandHeight ), heat( values[ band ] ) );
+        }
+    }
+}
+
+void
+HeatmapWidget::wheelEvent( QWheelEvent* event )
+{
+    if ( m_pyramid.size() == 0 )
+    {
+        return;
+    }
+    /*the process under the cursor stays in place*/
+    QRect  area   = plotArea();
+    double anchor = qBound( 0.0, ( double )( event->pos().x() - area.left() ) / area.width(), 1.0 );
+    double center = m_first + anchor * m_span;
+    m_span  = event->delta() > 0 ? m_span * 0.8 : m_span * 1.25;
+    m_first = center - anchor * m_span;
+    clampView();
+    update();
+    event->accept();
+}
+
+void
+HeatmapWidget::mousePressEvent( QMouseEvent* event )
+{
+    if ( event->button() == Qt::LeftButton )
+    {
+        m_dragX     = event->pos().x();
+        m_dragFirst = m_first;
+    }
+}
+
+void
+HeatmapWidget::mouseMoveEvent( QMouseEvent* event )
+{
+    QRect area = plotArea();
+    if ( m_pyramid.size() == 0 || area.width() <= 0 )
+    {
+        return;
+    }
+    if ( m_dragX >= 0 )
+    {
+        m_first = m_dragFirst - m_span * ( event->pos().x() - m_dragX ) / area.width();
+        clampView();
+        update();
+        return;
+    }
+    if ( !area.contains( event->pos() ) )
+    {
+        QToolTip::hideText();
+        return;
+    }
+    int first;
+    int last;
+    processRange( event->pos().x(), &first, &last );
+    last = qMin( last, m_pyramid.size() );
+    ProcessPyramid::bucket b = m_pyramid.range( first, last );
+    if ( b.count == 0 )
+    {
+        return;
+    }
+    QString processes = last - first == 1 ? QString( "process %1" ).arg( first ) :
+                        QString( "processes %1 to %2" ).arg( first ).arg( last - 1 );
+    QToolTip::showText( event->globalPos(),
+                        QString( "%1\nmax %2\nmean %3\nmin %4" )
+                        .arg( processes )
+                        .arg( readable( b.max ) )
+                        .arg( readable( b.sum / b.count ) )
+                        .arg( readable( b.min ) ), this );
+}
+
+void
+HeatmapWidget::mouseReleaseEvent( QMouseEvent* event )
+{
+    Q_UNUSED( event );
+    m_dragX = -1;
+}
+
+void
+HeatmapWidget::mouseDoubleClickEvent( QMouseEvent* event )
+{
+    Q_UNUSED( event );
+    m_first = 0;
+    m_span  = m_pyramid.size();
+    update();
+}
@@ -0,0 +1,77 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#ifndef HEATMAPWIDGET_HPP
+#define HEATMAPWIDGET_HPP
+
+#include <QWidget>
+#include <QPainter>
+#include <QMouseEvent>
+#include <QWheelEvent>
+#include <QToolTip>
+
+#include "processpyramid.hpp"
+
+/*
+ * Bytes per process as three colored bands: maximum, mean and minimum of
+ * the processes falling onto each pixel column. The wheel zooms around
+ * the cursor, dragging pans and a double click shows all processes again.
+ */
+class HeatmapWidget : public QWidget
+{
+public:
+    HeatmapWidget( QWidget* parent = 0 );
+
+    /*keeps the zoom if the number of processes stays the same*/
+    void
+    setValues( const ProcessPyramid& pyramid,
+               const QString&        title );
+    void
+    clear( const QString& message = QString() );
+
+protected:
+    void
+    paintEvent( QPaintEvent* event );
+    void
+    wheelEvent( QWheelEvent* event );
+    void
+    mousePressEvent( QMouseEvent* event );
+    void
+    mouseMoveEvent( QMouseEvent* event );
+    void
+    mouseReleaseEvent( QMouseEvent* event );
+    void
+    mouseDoubleClickEvent( QMouseEvent* event );
+
+private:
+    ProcessPyramid m_pyramid;
+    QString        m_title;
+    /*shown processes [m_first, m_first + m_span)*/
+    double m_first;
+    double m_span;
+    /*pan start, -1 while not dragging*/
+    int    m_dragX;
+    double m_dragFirst;
+
+    QRect
+    plotArea() const;
+    void
+    processRange( int  x,
+                  int* first,
+                  int* last ) const;
+    void
+    clampView();
+    QColor
+    heat( double value ) const;
+};
+
+#endif // HEATMAPWIDGET_HPP
@@ -11,13 +11,22 @@
  */
 
 #include "mainwindow.hpp"
+#include "batchscore.hpp"
 #include <QApplication>
+#include <QCoreApplication>
 #include <QFontDatabase>
 #include <QTextStream>
 
 int
 main( int argc, char* argv[] )
 {
+    /*scorep-score-gui --batch directory [--jobs n] [--output file], no window*/
+    if ( argc > 1 && QString( argv[ 1 ] ) == "--batch" )
+    {
+        QCoreApplication batch( argc, argv );
+        return BatchScore::run( batch.arguments().mid( 1 ) );
+    }
+
     QApplication a( argc, argv );
     MainWindow   w;
     QFont        def( "DejaVu Sans", 10, QFont::Normal );
@@ -30,9 +39,16 @@ main( int argc, char* argv[] )
     a.setFont( def );
     /*first check if link is set*/
     w.show();
+    /*scorep-score-gui --benchmark profile.cubex [--toggles n], timings to stderr*/
+    if ( argc > 2 && QString( argv[ 1 ] ) == "--benchmark" )
+    {
+        w.benchmark( argv[ 2 ], argc > 4 && QString( argv[ 3 ] ) == "--toggles" ? QString( argv[ 4 ] ).toInt() : 100 );
+        return a.exec();
+    }
+    /*scorep-score-gui [profile.cubex [filter file | baseline.cubex] | session.session]*/
     if ( argc != 1 )
     {
-        w.initOpen( argv[ 1 ] );
+        w.initOpen( argv[ 1 ], argc > 2 ? QString( argv[ 2 ] ) : QString() );
     }
 
     int ret = a.exec();
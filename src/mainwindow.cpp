@@ -11,8 +11,11 @@
  */
 
 #include <limits>
+#include <algorithm>
 
 #include "mainwindow.hpp"
+#include <QCoreApplication>
+#include <QTextStream>
 
 MainWindow::MainWindow( QWidget* parent )
     : QMainWindow( parent )
@@ -23,51 +26,183 @@ MainWindow::MainWindow( QWidget* parent )
     , mp_statusBar( 0 )
     , mp_menu( 0 )
     , mp_progressbar( 0 )
+    , mp_busyLabel( 0 )
+    , mp_frontierWidget( 0 )
+    , mp_heatmap( 0 )
+    , mp_regionDetail( 0 )
+    , mp_timingLabel( 0 )
+    , mp_search( 0 )
+    , mp_functionTabs( 0 )
+    , mp_callTree( 0 )
+    , mp_brush( 0 )
+    , mp_files( 0 )
+    , mp_profiles( 0 )
+    , mp_scaling( 0 )
+    , mp_groupModel( 0 )
+    , mp_functionModel( 0 )
     , mp_connection( 0 )
     , mp_prototypeNumberItem( 0 )
-    , mp_prototypeTextItem( 0 )
-    , mp_signalMapper( 0 )
+    , m_benchmarkToggles( -1 )
+    , m_benchmarkLoad( 0 )
+    , mp_frontierWatcher( 0 )
+    , m_frontierValid( false )
+    , mp_sizeTimer( 0 )
+    , mp_sizeWatcher( 0 )
+    , m_sizeGeneration( 0 )
+    , m_sizePending( false )
+    , mp_sortWatcher( 0 )
+    , m_sortValid( false )
+    , m_sortColumn( TableModel::CHECK )
+    , m_sortOrder( Qt::DescendingOrder )
+    , m_searchFiltered( false )
+    , m_sizeTableFilled( false )
+    , m_sizeFiltered( false )
+    , mp_loading( 0 )
+    , mp_loadWatcher( 0 )
+    , mp_loadTimer( 0 )
+    , mp_cancelButton( 0 )
+    , m_loadingMode( OPEN_PROFILE )
+    , m_pendingMode( OPEN_PROFILE )
+    , m_restoreSession( false )
+    , mp_baseline( 0 )
+    , mp_watchProfile( 0 )
+    , mp_profileWatcher( 0 )
+    , m_loadingSize( -1 )
+    , m_heatmapVersion( 0 )
+    , m_heatmapKey( -1 )
+    , m_sizePreviewShown( false )
+    , mp_filterSaver( 0 )
 {
     m_windowTitle = "Score-P scoring GUI";
 
-    /*signal mapper to determine the position of a clicked checkbox*/
-    mp_signalMapper = new QSignalMapper( this );
-
     /*init layout*/
     QWidget* window = new QWidget( this );
     mp_layout = new QVBoxLayout( window );
     setCentralWidget( window );
 
-    m_noFilter << "MPI" << "ALL" << "OMP" << "SHMEM";
+    m_noFilter = dataCenter::noFilterTypes();
 
     /*init*/
     initTables();
     initMenu();
-    mp_statusBar   = new QStatusBar( this );
-    mp_progressbar = new QProgressBar( this );
+    mp_statusBar       = new QStatusBar( this );
+    mp_progressbar     = new QProgressBar( this );
+    mp_frontierWidget  = new FrontierWidget( this );
+    mp_heatmap         = new HeatmapWidget( this );
+    mp_regionDetail    = new RegionDetailWidget( this );
+    mp_frontierWatcher = new QFutureWatcher<FilterFrontier::result>( this );
+    mp_sizeWatcher     = new QFutureWatcher<Connector::sizeResult>( this );
+    mp_sortWatcher     = new QFutureWatcher<QVector<QVector<int> > >( this );
+    mp_loadWatcher     = new QFutureWatcher<bool>( this );
+    mp_busyLabel       = new QLabel( "recomputing...", this );
+    mp_busyLabel->hide();
+    mp_timingLabel = new QLabel( this );
+    mp_cancelButton = new QPushButton( "Cancel loading", this );
+    mp_cancelButton->hide();
+    mp_statusBar->addPermanentWidget( mp_busyLabel );
+    mp_statusBar->addPermanentWidget( mp_timingLabel );
+    mp_statusBar->addPermanentWidget( mp_cancelButton );
+
+    /*the loading thread only writes counters, the GUI looks at them*/
+    mp_loadTimer = new QTimer( this );
+    mp_loadTimer->setInterval( 100 );
+
+    /*collect rapid clicks into one recalculation*/
+    mp_sizeTimer = new QTimer( this );
+    mp_sizeTimer->setSingleShot( true );
+    mp_sizeTimer->setInterval( 30 );
+
+    mp_profileWatcher = new ProfileWatcher( this );
+
+    /*what the numbers are compared with, hidden without a baseline*/
+    mp_baseline = new BaselineWidget( this );
+
+    /*search row above the function table*/
+    mp_search = new SearchBar( this );
+
+    /*call tree as a second tab next to the function table*/
+    mp_callTree = new CallTreeWidget( this );
+
+    /*density plot, a brush previews its exclusion in the size table*/
+    mp_brush = new BrushWidget( this );
+
+    /*source files, rules for a file or a directory glob*/
+    mp_files = new FilesWidget( this );
+
+    /*sizes of all profiles of the session with the shared filter*/
+    mp_profiles = new ProfilesWidget( this );
+
+    /*the regions of the profiles extrapolated to a larger process count*/
+    mp_scaling = new ScalingWidget( this );
+
+    mp_functionTabs = new QTabWidget( this );
+    mp_functionTabs->addTab( mp_functionTable, "Regions" );
+    mp_functionTabs->addTab( mp_callTree, "Call tree" );
+    mp_functionTabs->addTab( mp_brush, "Time per visit" );
+    mp_functionTabs->addTab( mp_files, "Files" );
+    mp_functionTabs->addTab( mp_profiles, "Profiles" );
+    mp_functionTabs->addTab( mp_scaling, "Scaling" );
 
     /*init prototypes for tableItems*/
     mp_prototypeNumberItem = new QTableWidgetItem();
     mp_prototypeNumberItem->setTextAlignment( Qt::AlignRight | Qt::AlignCenter );
-    mp_prototypeTextItem = new QTableWidgetItem();
-    mp_prototypeTextItem->setTextAlignment( Qt::AlignLeft | Qt::AlignVCenter );
 
     /*add widget to layout*/
     mp_layout->addWidget( mp_progressbar );
     mp_layout->addWidget( mp_sizeTable );
+    mp_layout->addWidget( mp_frontierWidget );
+    mp_layout->addWidget( mp_heatmap );
+    mp_layout->addWidget( mp_baseline );
     mp_layout->addWidget( mp_groupTable );
-    mp_layout->addWidget( mp_functionTable );
+    mp_layout->addWidget( mp_search );
+    QHBoxLayout* functionRow = new QHBoxLayout();
+    functionRow->addWidget( mp_functionTabs );
+    functionRow->addWidget( mp_regionDetail );
+    mp_layout->addLayout( functionRow );
 
     setMenuBar( mp_menu );
     setStatusBar( mp_statusBar );
 
 
     /*do connections*/
-    connect( mp_groupTable, SIGNAL( cellPressed( int, int ) ), this, SLOT( unselectFunctionTable() ) );
-    connect( mp_functionTable, SIGNAL( cellPressed( int, int ) ), this, SLOT( unselectGroupTable() ) );
+    connect( mp_groupTable, SIGNAL( pressed( QModelIndex ) ), this, SLOT( unselectFunctionTable() ) );
+    connect( mp_functionTable, SIGNAL( pressed( QModelIndex ) ), this, SLOT( unselectGroupTable() ) );
+    connect( mp_groupTable, SIGNAL( pressed( QModelIndex ) ), this, SLOT( groupPressed( QModelIndex ) ) );
+    connect( mp_functionTable, SIGNAL( pressed( QModelIndex ) ), this, SLOT( functionPressed( QModelIndex ) ) );
     connect( mp_groupTable->horizontalHeader(), SIGNAL( sectionResized( int, int, int ) ),
              this, SLOT( resizeFunctionTable( int, int, int ) ) );
-    connect( mp_signalMapper, SIGNAL( mapped( int ) ), this, SLOT( changeStateSlot( int ) ) );
+    /*queued, the models must not change while the view delivers the click*/
+    connect( mp_groupModel, SIGNAL( toggled( int ) ), this, SLOT( groupToggled( int ) ), Qt::QueuedConnection );
+    connect( mp_functionModel, SIGNAL( toggled( int ) ), this, SLOT( functionToggled( int ) ), Qt::QueuedConnection );
+    connect( mp_frontierWatcher, SIGNAL( finished() ), this, SLOT( frontierFinished() ) );
+    connect( mp_sizeWatcher, SIGNAL( finished() ), this, SLOT( sizesFinished() ) );
+    connect( mp_sortWatcher, SIGNAL( finished() ), this, SLOT( sortingFinished() ) );
+    /*the function table has no header, the group header sorts it*/
+    connect( mp_groupTable->horizontalHeader(), SIGNAL( sectionClicked( int ) ), this, SLOT( headerClicked( int ) ) );
+    connect( mp_sizeTimer, SIGNAL( timeout() ), this, SLOT( startSizeCalculation() ) );
+    connect( mp_loadWatcher, SIGNAL( finished() ), this, SLOT( loadFinished() ) );
+    connect( mp_baseline, SIGNAL( diffChanged() ), this, SLOT( diffChanged() ) );
+    connect( mp_baseline, SIGNAL( loadFailed( QString ) ), mp_statusBar, SLOT( showMessage( QString ) ) );
+    connect( mp_filterSaver, SIGNAL( message( QString ) ), mp_statusBar, SLOT( showMessage( QString ) ) );
+    connect( mp_filterSaver, SIGNAL( saved() ), this, SLOT( filterSaved() ) );
+    connect( mp_filterSaver, SIGNAL( timed( QString, qint64 ) ), this, SLOT( showTime( QString, qint64 ) ) );
+    connect( mp_scaling, SIGNAL( targetChanged() ), this, SLOT( updateScaling() ) );
+    connect( mp_functionTable->selectionModel(), SIGNAL( selectionChanged( QItemSelection, QItemSelection ) ),
+             this, SLOT( functionSelectionChanged() ) );
+    connect( mp_functionTabs, SIGNAL( currentChanged( int ) ), this, SLOT( functionTabChanged( int ) ) );
+    connect( mp_callTree, SIGNAL( changeRequested( bool ) ), this, SLOT( changeSubtrees( bool ) ) );
+    connect( mp_brush, SIGNAL( previewChanged() ), this, SLOT( previewChanged() ) );
+    connect( mp_brush, SIGNAL( changeRequested( bool ) ), this, SLOT( changeBrushed( bool ) ) );
+    connect( mp_files, SIGNAL( changeRequested( bool ) ), this, SLOT( changeFiles( bool ) ) );
+    connect( mp_loadTimer, SIGNAL( timeout() ), this, SLOT( showLoadProgress() ) );
+    connect( mp_cancelButton, SIGNAL( clicked( bool ) ), this, SLOT( cancelLoading() ) );
+    connect( mp_profileWatcher, SIGNAL( rewritten( qint64, QDateTime ) ),
+             this, SLOT( profileRewritten( qint64, QDateTime ) ) );
+    connect( mp_search, SIGNAL( searched() ), this, SLOT( searched() ) );
+    connect( mp_search, SIGNAL( onlyMatchesToggled() ), this, SLOT( showMatches() ) );
+    connect( mp_search, SIGNAL( nextRequested() ), this, SLOT( nextMatch() ) );
+    connect( mp_search, SIGNAL( changeRequested( bool ) ), this, SLOT( changeMatches( bool ) ) );
+    connect( mp_frontierWidget, SIGNAL( pointSelected( int ) ), this, SLOT( applyFrontierPoint( int ) ) );
 
     mp_groupTable->installEventFilter( this );
     mp_functionTable->installEventFilter( this );
@@ -80,8 +215,12 @@ void
 MainWindow::initTables()
 {
     mp_sizeTable     = new QTableWidget( 3, 3, this );
-    mp_groupTable    = new QTableWidget( 1, 8, this );
-    mp_functionTable = new QTableWidget( 1, 8, this );
+    mp_groupTable    = new QTableView( this );
+    mp_functionTable = new QTableView( this );
+    mp_groupModel    = new GroupTableModel( this );
+    mp_functionModel = new FunctionTableModel( this );
+    mp_groupTable->setModel( mp_groupModel );
+    mp_functionTable->setModel( mp_functionModel );
     /*adjust tables*/
     /*minimum width*/
     mp_groupTable->setMinimumWidth( 500 );
@@ -104,17 +243,14 @@ MainWindow::initTables()
     /*edit selection*/
     mp_sizeTable->setSelectionMode( QAbstractItemView::NoSelection );
     mp_functionTable->setSelectionBehavior( QAbstractItemView::SelectRows );
-    mp_functionTable->setSelectionMode( QAbstractItemView::SingleSelection );
+    mp_functionTable->setSelectionMode( QAbstractItemView::ExtendedSelection );
     mp_groupTable->setSelectionBehavior( QAbstractItemView::SelectRows );
-    mp_groupTable->setSelectionMode( QAbstractItemView::SingleSelection );
+    mp_groupTable->setSelectionMode( QAbstractItemView::ExtendedSelection );
     /*dont highlight header if something is selected*/
     mp_groupTable->horizontalHeader()->setHighlightSections( false );
 
-    /*fill headers*/
+    /*fill headers, the region tables take theirs from the model*/
     QStringList horizontalHeaders;
-    horizontalHeaders << "" << "type" << "max_buff[B]" << "visits" << "time[s]" << "time[%]" << "time/visit[us]" << "region";
-    mp_groupTable->setHorizontalHeaderLabels( horizontalHeaders );
-    horizontalHeaders.clear();
     horizontalHeaders << "" << "without filter" << "with filter";
     mp_sizeTable->setHorizontalHeaderLabels( horizontalHeaders );
     /*hide headers*/
@@ -137,34 +273,106 @@ MainWindow::initMenu()
     QAction* actionSave   = new QAction( "Save", this );
     QAction* actionExit   = new QAction( "Exit", this );
     QAction* actionSaveAs = new QAction( "Save As", this );
+    QAction* actionFilter = new QAction( "Load filter", this );
+    QAction* actionAdd    = new QAction( "Add profile", this );
+    actionAdd->setToolTip( "Score another profile of the same program with this filter" );
+    QAction* actionExport = new QAction( "Export", this );
+    actionExport->setToolTip( "Write the excluded regions as a list or a JSON report with the sizes" );
+    QAction* actionSaveSession = new QAction( "Save session", this );
+    actionSaveSession->setToolTip( "Save the filter, its history, the sizes, the sort order and the search" );
+    QAction* actionOpenSession = new QAction( "Open session", this );
+    QAction* actionCompare     = new QAction( "Compare with", this );
+    actionCompare->setToolTip( "Show the changes against a baseline profile, e.g. of the previous run" );
+    QAction* actionStopCompare = new QAction( "Stop comparing", this );
+    mp_watchProfile = new QAction( "Watch profile", this );
+    mp_watchProfile->setCheckable( true );
+    mp_watchProfile->setToolTip( "Reload the profile whenever it is rewritten, the filter is kept" );
+    mp_filterSaver = new FilterSaver( this );
     /*set shortcuts*/
     actionOpen->setShortcut( QKeySequence( Qt::CTRL + Qt::Key_O ) );
     actionSave->setShortcut( QKeySequence( Qt::CTRL + Qt::Key_S ) );
     actionExit->setShortcut( QKeySequence( Qt::CTRL + Qt::Key_Q ) );
     actionSaveAs->setShortcut( QKeySequence( Qt::CTRL + Qt::SHIFT + Qt::Key_S ) );
+    actionFilter->setShortcut( QKeySequence( Qt::CTRL + Qt::Key_L ) );
+    actionAdd->setShortcut( QKeySequence( Qt::CTRL + Qt::SHIFT + Qt::Key_O ) );
+    actionExport->setShortcut( QKeySequence( Qt::CTRL + Qt::Key_E ) );
+    actionSaveSession->setShortcut( QKeySequence( Qt::CTRL + Qt::ALT + Qt::Key_S ) );
+    actionOpenSession->setShortcut( QKeySequence( Qt::CTRL + Qt::ALT + Qt::Key_O ) );
+    actionCompare->setShortcut( QKeySequence( Qt::CTRL + Qt::Key_D ) );
+    mp_watchProfile->setShortcut( QKeySequence( Qt::CTRL + Qt::Key_W ) );
     actionOpen->setIcon( QIcon( ":icons/images/open.png" ) );
     actionSave->setIcon( QIcon( ":icons/images/save.png" ) );
     actionSaveAs->setIcon( QIcon( ":icons/images/save.png" ) );
     actionExit->setIcon( QIcon( ":icons/images/exit.png" ) );
+    actionFilter->setIcon( QIcon( ":icons/images/open.png" ) );
+    actionAdd->setIcon( QIcon( ":icons/images/open.png" ) );
+    actionExport->setIcon( QIcon( ":icons/images/save.png" ) );
+    actionSaveSession->setIcon( QIcon( ":icons/images/save.png" ) );
+    actionOpenSession->setIcon( QIcon( ":icons/images/open.png" ) );
+    actionCompare->setIcon( QIcon( ":icons/images/open.png" ) );
     QMenu* fileMenu = new QMenu( "File" );
     fileMenu->addAction( actionOpen );
+    fileMenu->addAction( actionAdd );
+    fileMenu->addAction( actionCompare );
+    fileMenu->addAction( actionStopCompare );
+    fileMenu->addAction( mp_watchProfile );
+    fileMenu->addAction( actionFilter );
     fileMenu->addAction( actionSave );
     fileMenu->addAction( actionSaveAs );
+    fileMenu->addAction( actionExport );
+    fileMenu->addAction( mp_filterSaver->compressAction() );
+    fileMenu->addAction( actionOpenSession );
+    fileMenu->addAction( actionSaveSession );
     fileMenu->addAction( actionExit );
+    QAction* actionUndo = new QAction( "Undo", this );
+    QAction* actionRedo = new QAction( "Redo", this );
+    actionUndo->setShortcut( QKeySequence( Qt::CTRL + Qt::Key_Z ) );
+    actionRedo->setShortcut( QKeySequence( Qt::CTRL + Qt::SHIFT + Qt::Key_Z ) );
+    QAction* actionSelect = new QAction( "Select by rules", this );
+    actionSelect->setShortcut( QKeySequence( Qt::CTRL + Qt::Key_R ) );
+    QAction* actionFind = new QAction( "Find regions", this );
+    actionFind->setShortcut( QKeySequence( Qt::CTRL + Qt::Key_F ) );
+    QMenu* editMenu = new QMenu( "Edit" );
+    editMenu->addAction( actionUndo );
+    editMenu->addAction( actionRedo );
+    editMenu->addAction( actionSelect );
+    editMenu->addAction( actionFind );
     QAction* actionShortcuts = new QAction( "Shortcuts", this );
     QMenu*   helpMenu        = new QMenu( "Help" );
     helpMenu->addAction( actionShortcuts );
     mp_menu->addMenu( fileMenu );
+    mp_menu->addMenu( editMenu );
     mp_menu->addMenu( helpMenu );
     connect( actionOpen, SIGNAL( triggered( bool ) ), this, SLOT( openFile() ) );
     connect( actionSave, SIGNAL( triggered( bool ) ), this, SLOT( saveFile() ) );
     connect( actionSaveAs, SIGNAL( triggered( bool ) ), this, SLOT( saveFileAs() ) );
+    connect( actionFilter, SIGNAL( triggered( bool ) ), this, SLOT( loadFilter() ) );
+    connect( actionAdd, SIGNAL( triggered( bool ) ), this, SLOT( addProfile() ) );
+    connect( actionExport, SIGNAL( triggered( bool ) ), this, SLOT( exportFilter() ) );
+    connect( actionSaveSession, SIGNAL( triggered( bool ) ), this, SLOT( saveSession() ) );
+    connect( actionOpenSession, SIGNAL( triggered( bool ) ), this, SLOT( openSession() ) );
+    connect( actionCompare, SIGNAL( triggered( bool ) ), this, SLOT( compareProfile() ) );
+    connect( actionStopCompare, SIGNAL( triggered( bool ) ), this, SLOT( stopComparing() ) );
+    connect( mp_watchProfile, SIGNAL( toggled( bool ) ), this, SLOT( watchProfile( bool ) ) );
     connect( actionExit, SIGNAL( triggered( bool ) ), this, SLOT( close() ) );
+    connect( actionUndo, SIGNAL( triggered( bool ) ), this, SLOT( undoFilter() ) );
+    connect( actionRedo, SIGNAL( triggered( bool ) ), this, SLOT( redoFilter() ) );
+    connect( actionSelect, SIGNAL( triggered( bool ) ), this, SLOT( selectByRules() ) );
+    connect( actionFind, SIGNAL( triggered( bool ) ), this, SLOT( focusSearch() ) );
     connect( actionShortcuts, SIGNAL( triggered( bool ) ), this, SLOT( showShortcuts() ) );
 }
 
 MainWindow::~MainWindow()
 {
+    /*the loading thread still uses its connector*/
+    if ( mp_loadWatcher->isRunning() )
+    {
+        m_loadProgress.cancel.fetchAndStoreRelaxed( 1 );
+        mp_loadWatcher->waitForFinished();
+    }
+    delete mp_loading;
+    mp_regionDetail->cancel();
+    mp_callTree->cancel();
 }
 
 
@@ -187,97 +395,198 @@ MainWindow::fillSizeTable()
 }
 
 void
-MainWindow::changeStateSlot( int pos )
+MainWindow::groupToggled( int key )
 {
-    mp_statusBar->clearMessage();
-    /*what if partially checked?*/
-    QList<dataCenter::groupData> tempGroups;
-    tempGroups = mp_connection->getGroupData();
-    bool       groupTable = false;
-    QList<int> keys;
+    toggle( key, true );
+}
 
-    if ( pos < tempGroups.size() )
+void
+MainWindow::functionToggled( int key )
+{
+    toggle( key, false );
+}
+
+void
+MainWindow::toggle( int key, bool groupTable )
+{
+    /*a click into a selection of several rows toggles all of them*/
+    QVector<int> keys;
+    if ( m_pressedKeys.size() > 1 && m_pressedKeys.contains( key ) )
     {
-        /*groupTable*/
-        groupTable = true;
-        mp_groupTable->selectRow( pos );
-        mp_functionTable->clearSelection();
+        keys = m_pressedKeys;
     }
     else
     {
-        pos = pos - tempGroups.size();
-        mp_functionTable->selectRow( pos );
-        mp_groupTable->clearSelection();
-        /*functionTable*/
+        keys.append( key );
     }
-    keys.append( pos );
-    mp_connection->changeState( keys, groupTable );
-    setWindowModified( true );
-    updateTables();
+    m_pressedKeys.clear();
+    toggleKeys( keys, key, groupTable );
 }
 
 void
-MainWindow::changeState()
+MainWindow::reportTime( const QString& what )
 {
-    mp_statusBar->clearMessage();
-    /*get selected row
-     * changeState*/
-    /*function to detext selection an pass to connector*/
-    QList<int>                   keys;
-    QModelIndexList              selection;
-    QList<dataCenter::groupData> tempGroups;
-    QList<dataCenter::data>      tempData = mp_connection->getFunctionData();
-    QString                      type;
-    tempGroups = mp_connection->getGroupData();
-    bool groupTable = false;
+    showTime( what, m_timer.elapsed() );
+}
+
+void
+MainWindow::showTime( QString what, qint64 milliseconds )
+{
+    mp_timingLabel->setText( QString( "%1: %2 ms" ).arg( what ).arg( milliseconds ) );
+}
 
-    if ( mp_functionTable->selectedItems().size() > 0 )
+void
+MainWindow::changeState()
+{
+    bool         groupTable = mp_groupTable->selectionModel()->hasSelection();
+    QVector<int> keys       = selectedKeys( groupTable );
+    if ( keys.isEmpty() )
     {
-        selection = mp_functionTable->selectionModel()->selectedRows();
+        return;
     }
-    if ( mp_groupTable->selectedItems().size() > 0 )
+    int current = groupTable ? mp_groupTable->currentIndex().row() :
+                  mp_functionModel->keyAt( mp_functionTable->currentIndex().row() );
+    toggleKeys( keys, keys.contains( current ) ? current : keys.first(), groupTable );
+}
+
+QVector<int>
+MainWindow::selectedKeys( bool groupTable )
+{
+    QTableView*     table     = groupTable ? mp_groupTable : mp_functionTable;
+    QModelIndexList selection = table->selectionModel()->selectedRows();
+    QVector<int>    keys( selection.size() );
+    for ( int i = 0; i < selection.size(); i++ )
     {
-        selection  = mp_groupTable->selectionModel()->selectedRows();
-        groupTable = true;
+        /*rows of the sorted function table are not its keys*/
+        keys[ i ] = groupTable ? selection[ i ].row() : mp_functionModel->keyAt( selection[ i ].row() );
     }
+    return keys;
+}
 
-    for ( int i = 0; i < selection.count(); i++ )
+void
+MainWindow::selectKeys( const QVector<int>& keys, int current, bool groupTable )
+{
+    QTableView*  table = groupTable ? mp_groupTable : mp_functionTable;
+    QVector<int> rows;
+    for ( int i = 0; i < keys.size(); i++ )
     {
-        QModelIndex index = selection.at( i );
-        keys.append( index.row() );
+        int row = groupTable ? keys[ i ] : mp_functionModel->rowOf( keys[ i ] );
+        if ( row >= 0 )
+        {
+            rows.append( row );
+        }
     }
-    if ( groupTable )
+    std::sort( rows.begin(), rows.end() );
+    /*one range per run of consecutive rows*/
+    QItemSelection selection;
+    int            i = 0;
+    while ( i < rows.size() )
     {
-        type = QString::fromStdString( tempGroups[ keys.at( 0 ) ].type );
+        int first = rows[ i ];
+        int last  = first;
+        while ( i + 1 < rows.size() && rows[ i + 1 ] <= last + 1 )
+        {
+            last = rows[ ++i ];
+        }
+        selection.select( table->model()->index( first, 0 ),
+                          table->model()->index( last, TableModel::COLUMN_NUM - 1 ) );
+        i++;
     }
-    else
+    ( groupTable ? mp_functionTable : mp_groupTable )->clearSelection();
+    table->selectionModel()->select( selection, QItemSelectionModel::ClearAndSelect );
+    int currentRow = groupTable ? current : mp_functionModel->rowOf( current );
+    if ( currentRow >= 0 )
     {
-        type = QString::fromStdString( tempData[ keys.at( 0 ) ].type );
+        table->selectionModel()->setCurrentIndex( table->model()->index( currentRow, 0 ), QItemSelectionModel::NoUpdate );
     }
-    if ( groupTable == true )
+}
+
+void
+MainWindow::toggleKeys( QVector<int> keys, int current, bool groupTable )
+{
+    mp_statusBar->clearMessage();
+    m_timer.start();
+    selectKeys( keys, current, groupTable );
+    QString type;
+    bool    changed;
+    if ( groupTable )
     {
-        /*check if positon == filter*/
-        if ( keys.at( 0 ) == mp_groupTable->rowCount() - 1 )
+        QSharedPointer<const dataCenter::groupSnapshot> groups = mp_connection->getGroupData();
+        const QVector<dataCenter::groupData>&           rows   = groups->rows;
+        type = QString::fromStdString( rows[ current ].type );
+        if ( keys.size() == 1 && current == rows.size() - 1 )
         {
+            /*the FLT row switches every group*/
             keys.clear();
-            for ( int i = 0; i < tempGroups.size(); i++ )
+            for ( int i = 0; i < rows.size(); i++ )
             {
-                if ( !m_noFilter.contains( QString::fromStdString( tempGroups[ i ].type ) ) )
+                if ( !m_noFilter.contains( QString::fromStdString( rows[ i ].type ) ) )
                 {
                     keys.append( i );
                 }
             }
         }
+        else if ( keys.size() > 1 )
+        {
+            /*all groups take the state the current one switches to, groups
+             * already in that state must not be switched back*/
+            bool         include = rows[ current ].state != dataCenter::INCLUDED;
+            QVector<int> switched;
+            for ( int i = 0; i < keys.size(); i++ )
+            {
+                if ( ( rows[ keys[ i ] ].state != dataCenter::INCLUDED ) == include &&
+                     !m_noFilter.contains( QString::fromStdString( rows[ keys[ i ] ].type ) ) )
+                {
+                    switched.append( keys[ i ] );
+                }
+            }
+            keys = switched;
+        }
+        changed = !keys.isEmpty() && mp_connection->changeState( keys.toList(), true );
+    }
+    else
+    {
+        /*one edit for all keys, the current key decides the direction*/
+        type    = QString::fromStdString( mp_connection->getFunctionData()->rows[ current ].type );
+        changed = mp_connection->excludeFunctions( keys, mp_connection->isIncluded( current ) ) > 0;
     }
-    if ( !mp_connection->changeState( keys, groupTable ) )
+    if ( !changed )
     {
         mp_statusBar->showMessage( type + " cannot be excluded" );
     }
     else
     {
         setWindowModified( true );
+        if ( keys.size() > 1 )
+        {
+            mp_statusBar->showMessage( QString( "%1 rows switched" ).arg( keys.size() ) );
+        }
     }
     updateTables();
+    requestSizes();
+    reportTime( "update" );
+}
+
+void
+MainWindow::groupPressed( const QModelIndex& index )
+{
+    /*the view shrinks the selection to the clicked row before the click
+     * reaches the checkbox, so remember what was selected*/
+    m_pressedKeys.clear();
+    if ( index.column() == TableModel::CHECK && mp_groupTable->selectionModel()->isSelected( index ) )
+    {
+        m_pressedKeys = selectedKeys( true );
+    }
+}
+
+void
+MainWindow::functionPressed( const QModelIndex& index )
+{
+    m_pressedKeys.clear();
+    if ( index.column() == TableModel::CHECK && mp_functionTable->selectionModel()->isSelected( index ) )
+    {
+        m_pressedKeys = selectedKeys( false );
+    }
 }
 
 
@@ -293,441 +602,1329 @@ MainWindow::openFile()
     /*get directory*/
     if ( fileName != 0 )
     {
-        reset();
-        m_fileName = fileName;
-        setWindowTitle( m_fileName + "[*] - " + m_windowTitle );
-        mp_connection->start( fileName );
-        mp_groupTable->selectRow( 0 );
-        updateTables();
+        startLoading( fileName );
     }
 }
 
 void
-MainWindow::saveFile()
+MainWindow::addProfile()
 {
     mp_statusBar->clearMessage();
-    if ( mp_connection->hasFiltered() )
+    if ( m_fileName.isEmpty() )
     {
-        if ( m_filterFileName.isEmpty() )
-        {
-            QString saveFileName;
-            saveFileName = QFileDialog::getSaveFileName( this, tr( "Save filter file" ), QDir::currentPath(), tr( "Filter files (*.filter)" ) );
-            if ( saveFileName.isEmpty() )
-            {
-                return;
-            }
-            if ( !saveFileName.endsWith( ".filter" ) )
-            {
-                saveFileName += ".filter";
-            }
-            m_filterFileName = saveFileName;
-            if ( mp_connection->createFilterFile( saveFileName ) )
-            {
-                mp_statusBar->showMessage( "Filter file saved at " + saveFileName );
-                setWindowModified( false );
-            }
-            else
-            {
-                mp_statusBar->showMessage( "Saving filterfile failed. No Permissions" );
-            }
-        }
-        else
-        {
-            if ( mp_connection->createFilterFile( m_filterFileName ) )
-            {
-                mp_statusBar->showMessage( "Filter file saved at " + m_filterFileName );
-                setWindowModified( false );
-            }
-            else
-            {
-                mp_statusBar->showMessage( "Saving filter file failed. No Permissions" );
-            }
-        }
+        mp_statusBar->showMessage( "Error: No profile loaded" );
+        return;
     }
-    else
+    QString fileName = QFileDialog::getOpenFileName( this, tr( "Add profile" ), QDir::currentPath(), tr( "Profile files (*.cubex)" ) );
+    if ( !fileName.isEmpty() )
     {
-        mp_statusBar->showMessage( "Error: No functions to filter" );
+        startLoading( fileName, ADD_PROFILE );
     }
-    updateTables();
 }
 
 void
-MainWindow::saveFileAs()
+MainWindow::saveFile()
 {
-    mp_statusBar->clearMessage();
-    if ( mp_connection->hasFiltered() )
-    {
-        QString saveFileName;
-        saveFileName = QFileDialog::getSaveFileName( this, tr( "Save filter file" ), QDir::currentPath(), tr( "Filter files (*.filter)" ) );
-        if ( saveFileName == "" )
-        {
-            return;
-        }
-        if ( !saveFileName.endsWith( ".filter" ) )
-        {
-            saveFileName += ".filter";
-        }
-        m_filterFileName = saveFileName;
-        if ( mp_connection->createFilterFile( saveFileName ) )
-        {
-            mp_statusBar->showMessage( "Filter file saved at " + saveFileName );
-            setWindowModified( false );
-        }
-        else
-        {
-            mp_statusBar->showMessage( "Saving filter file failed. No Permissions" );
-        }
-    }
-    else
-    {
-        mp_statusBar->showMessage( "Error: No functions to filter" );
-    }
+    mp_filterSaver->save( mp_connection );
     updateTables();
 }
 
 void
-MainWindow::initOpen( QString fileName )
+MainWindow::saveFileAs()
 {
-    if ( fileName.endsWith( ".cubex" ) )
-    {
-        m_fileName = fileName;
-        setWindowTitle( m_fileName + "[*] - " + m_windowTitle );
-        mp_connection->start( fileName );
-        mp_groupTable->selectRow( 0 );
-        updateTables();
-    }
-    else
-    {
-        mp_statusBar->showMessage( "Error: Given file isn't a .cubex file" );
-        updateTables();
-    }
+    mp_filterSaver->saveAs( mp_connection );
+    updateTables();
 }
 
 void
-MainWindow::unselectFunctionTable()
+MainWindow::exportFilter()
 {
-    mp_functionTable->clearSelection();
+    mp_filterSaver->exportFilter( mp_connection );
 }
 
 void
-MainWindow::unselectGroupTable()
+MainWindow::filterSaved()
 {
-    mp_groupTable->clearSelection();
+    setWindowModified( false );
 }
 
 void
-MainWindow::updateTables()
+MainWindow::saveSession()
 {
+    mp_statusBar->clearMessage();
     if ( m_fileName.isEmpty() )
     {
+        mp_statusBar->showMessage( "Error: No profile loaded" );
         return;
     }
-    QStringList horizontalHeaders;
-    horizontalHeaders << "" << "type" << "max_buff[B]" << "visits" << "time[s]" << "time[%]" << "time/visit[us]" << "region";
-    dataCenter::sizes            tempSizes;
-    dataCenter::sizes            tempFilteredSizes;
-    QList<dataCenter::data>      tempFunctions;
-    QList<dataCenter::groupData> tempGroups;
-    QVector<int>                 maxWidth;
-
-    /*get data from Connector*/
-    tempSizes     = mp_connection->getSizes();
-    tempFunctions = mp_connection->getFunctionData();
-    tempGroups    = mp_connection->getGroupData();
-
-    /*set progressbar values*/
-    mp_progressbar->setMaximum( tempSizes.traceSize );
-    if ( mp_connection->hasFiltered() )
+    QString fileName = QFileDialog::getSaveFileName( this, tr( "Save session" ), QDir::currentPath(),
+                                                     tr( "Sessions (*.session)" ) );
+    if ( fileName.isEmpty() )
     {
-        tempFilteredSizes = mp_connection->getFilteredSizes();
-        mp_progressbar->setValue( tempFilteredSizes.traceSize );
+        return;
     }
-    else
+    if ( !fileName.endsWith( ".session" ) )
     {
-        mp_progressbar->setValue( tempSizes.traceSize );
+        fileName += ".session";
     }
+    QFileInfo            profile( m_fileName );
+    SessionFile::content session;
+    session.profile         = profile.absoluteFilePath();
+    session.profileSize     = profile.size();
+    session.profileModified = profile.lastModified();
+    session.filter          = mp_connection->getHistory();
+    session.filterFile      = mp_filterSaver->fileName();
+    session.compress        = mp_filterSaver->compressAction()->isChecked();
+    session.sortColumn      = m_sortColumn;
+    session.sortOrder       = m_sortOrder;
+    session.search          = mp_search->text();
+    session.onlyMatches     = mp_search->onlyMatches();
+    session.tab             = mp_functionTabs->currentIndex();
+    m_timer.start();
+    QString error;
+    if ( !SessionFile::save( fileName, session, &error ) )
+    {
+        mp_statusBar->showMessage( "Error: Saving session failed, " + error );
+        return;
+    }
+    mp_statusBar->showMessage( "Session saved at " + fileName );
+    reportTime( "session" );
+}
 
-    mp_functionTable->setRowCount( tempFunctions.size() );
-    mp_groupTable->setRowCount( tempGroups.size() );
-
-    /*fill tables*/
-    /*sizeTable*/
-    mp_sizeTable->setItem( 0, 1, mp_prototypeNumberItem->clone() );
-    mp_sizeTable->setItem( 1, 1, mp_prototypeNumberItem->clone() );
-    mp_sizeTable->setItem( 2, 1, mp_prototypeNumberItem->clone() );
-    mp_sizeTable->item( 0, 1 )->setText( mp_connection->getReadableByteNo( tempSizes.traceSize ) );
-    mp_sizeTable->item( 1, 1 )->setText( mp_connection->getReadableByteNo( tempSizes.maxBuf ) );
-    mp_sizeTable->item( 2, 1 )->setText( mp_connection->getReadableByteNo( tempSizes.totalMemory ) );
-    /*groupTable*/
-
+void
+MainWindow::openSession()
+{
+    mp_statusBar->clearMessage();
+    QString fileName = QFileDialog::getOpenFileName( this, tr( "Open session" ), QDir::currentPath(),
+                                                     tr( "Sessions (*.session)" ) );
+    if ( !fileName.isEmpty() )
+    {
+        loadSession( fileName );
+    }
+}
 
-    QFont        def( "DejaVu Sans", 10, QFont::Normal );
-    QFontMetrics fm( def );
-    maxWidth.reserve( 8 );
-    for ( int i = 0; i < mp_functionTable->columnCount(); i++ )
+void
+MainWindow::loadSession( const QString& fileName )
+{
+    SessionFile::content session;
+    QString              error;
+    if ( !SessionFile::load( fileName, &session, &error ) )
     {
-        maxWidth.push_back( fm.width( horizontalHeaders.at( i ) ) );
+        mp_statusBar->showMessage( "Error: Opening session failed, " + error );
+        return;
+    }
+    if ( !QFileInfo( session.profile ).exists() )
+    {
+        mp_statusBar->showMessage( "Error: Profile of the session not found, " + session.profile );
+        return;
     }
+    /*applied by loadFinished instead of an initial filter*/
+    m_sessionToRestore = session;
+    m_restoreSession   = true;
+    m_initialFilter.clear();
+    startLoading( session.profile );
+}
 
-    for ( int i = 0; i < tempGroups.size(); i++ )
+void
+MainWindow::restoreSession( const SessionFile::content& session )
+{
+    if ( !mp_connection->restoreHistory( session.filter ) )
     {
-        int checkboxWidth = 0;
-        if ( !m_noFilter.contains( QString::fromStdString( tempGroups[ i ].type ) ) )
-        {
-            QCheckBox* tempBox = new QCheckBox( this );
-            tempBox->installEventFilter( this );
-            mp_groupTable->setCellWidget( i, 0, tempBox );
-            checkboxWidth = tempBox->width();
-            mp_signalMapper->setMapping( tempBox, i );
-            connect( tempBox, SIGNAL( clicked( bool ) ), mp_signalMapper, SLOT( map() ) );
-            if ( tempGroups[ i ].state == dataCenter::PARTIAL )
-            {
-                tempBox->setCheckState( Qt::PartiallyChecked );
-            }
-            else if ( tempGroups[ i ].state == dataCenter::INCLUDED )
-            {
-                tempBox->setCheckState( Qt::Checked );
-                tempBox->setChecked( true );
-            }
-            else
-            {
-                tempBox->setCheckState( Qt::Unchecked );
-                tempBox->setChecked( false );
-            }
-        }
-        mp_groupTable->setItem( i, 1, mp_prototypeTextItem->clone() );
-        mp_groupTable->setItem( i, 2, mp_prototypeNumberItem->clone() );
-        mp_groupTable->setItem( i, 3, mp_prototypeNumberItem->clone() );
-        mp_groupTable->setItem( i, 4, mp_prototypeNumberItem->clone() );
-        mp_groupTable->setItem( i, 5, mp_prototypeNumberItem->clone() );
-        mp_groupTable->setItem( i, 6, mp_prototypeNumberItem->clone() );
-        mp_groupTable->setItem( i, 7, mp_prototypeTextItem->clone() );
-        mp_groupTable->item( i, 1 )->setText( ( QString::fromStdString( tempGroups[ i ].type ) ) );
-        mp_groupTable->item( i, 2 )->setText( seperate( tempGroups[ i ].maxBuf ) );
-        mp_groupTable->item( i, 3 )->setText( seperate( tempGroups[ i ].visits ) );
-        mp_groupTable->item( i, 4 )->setText( QString::number( tempGroups[ i ].timeS, 'f', 2 ) );
-        mp_groupTable->item( i, 5 )->setText( QString::number( tempGroups[ i ].timeP, 'f', 2 ) );
-        mp_groupTable->item( i, 6 )->setText( QString::number( tempGroups[ i ].timePerVisit, 'f', 2 ) );
-        mp_groupTable->item( i, 7 )->setText( QString::fromStdString( tempGroups[ i ].region ) );
-        maxWidth[ 0 ] = qMax( maxWidth[ 0 ], checkboxWidth + 4 );
-        maxWidth[ 1 ] = qMax( maxWidth[ 1 ], fm.width( QString::fromStdString( tempGroups[ i ].type ) ) );
-        maxWidth[ 2 ] = qMax( maxWidth[ 2 ], fm.width( seperate( tempGroups[ i ].maxBuf ) ) );
-        maxWidth[ 3 ] = qMax( maxWidth[ 3 ], fm.width( seperate( tempGroups[ i ].visits ) ) );
-        maxWidth[ 4 ] = qMax( maxWidth[ 4 ], fm.width( QString::number( tempGroups[ i ].timeS, 'f', 2 ) ) );
-        maxWidth[ 5 ] = qMax( maxWidth[ 5 ], fm.width( QString::number( tempGroups[ i ].timeP, 'f', 2 ) ) );
-        maxWidth[ 6 ] = qMax( maxWidth[ 6 ], fm.width( QString::number( tempGroups[ i ].timePerVisit, 'f', 2 ) ) );
-        maxWidth[ 7 ] = qMax( maxWidth[ 7 ], fm.width( QString::fromStdString( tempGroups[ i ].region ) ) );
-    }
-    int height = 2 + mp_groupTable->rowCount() * mp_groupTable->rowHeight( 0 ) + mp_groupTable->horizontalHeader()->height();
-
-    mp_groupTable->setMaximumHeight( height );
-    mp_groupTable->setMinimumHeight( height );
-
-    /*functionTable*/
-    for ( int i = 0; i < tempFunctions.size(); i++ )
-    {
-        if ( !m_noFilter.contains( QString::fromStdString( tempFunctions[ i ].type ) ) )
-        {
-            QCheckBox* tempBox = new QCheckBox( this );
-            tempBox->installEventFilter( this );
-            mp_functionTable->setCellWidget( i, 0, tempBox );
-            mp_signalMapper->setMapping( tempBox, i + tempGroups.size() );
-            connect( tempBox, SIGNAL( clicked( bool ) ), mp_signalMapper, SLOT( map() ) );
-            if ( tempFunctions[ i ].included )
-            {
-                tempBox->setChecked( true );
-            }
-            else
-            {
-                tempBox->setChecked( false );
-            }
-        }
-        mp_functionTable->setItem( i, 1, mp_prototypeTextItem->clone() );
-        mp_functionTable->setItem( i, 2, mp_prototypeNumberItem->clone() );
-        mp_functionTable->setItem( i, 3, mp_prototypeNumberItem->clone() );
-        mp_functionTable->setItem( i, 4, mp_prototypeNumberItem->clone() );
-        mp_functionTable->setItem( i, 5, mp_prototypeNumberItem->clone() );
-        mp_functionTable->setItem( i, 6, mp_prototypeNumberItem->clone() );
-        mp_functionTable->setItem( i, 7, mp_prototypeTextItem->clone() );
-        mp_functionTable->item( i, 1 )->setText( QString::fromStdString( tempFunctions[ i ].type ) );
-        mp_functionTable->item( i, 2 )->setText( seperate( tempFunctions[ i ].maxBuf ) );
-        mp_functionTable->item( i, 3 )->setText( seperate( tempFunctions[ i ].visits ) );
-        mp_functionTable->item( i, 4 )->setText( QString::number( tempFunctions[ i ].timeS, 'f', 2 ) );
-        mp_functionTable->item( i, 5 )->setText( QString::number( tempFunctions[ i ].timeP, 'f', 2 ) );
-        mp_functionTable->item( i, 6 )->setText( QString::number( tempFunctions[ i ].timePerVisit, 'f', 2 ) );
-        mp_functionTable->item( i, 7 )->setText( QString::fromStdString( tempFunctions[ i ].region ) );
-        maxWidth[ 1 ] = qMax( maxWidth[ 1 ], fm.width( QString::fromStdString( tempFunctions[ i ].type ) ) );
-        maxWidth[ 2 ] = qMax( maxWidth[ 2 ], fm.width( seperate( tempFunctions[ i ].maxBuf ) ) );
-        maxWidth[ 3 ] = qMax( maxWidth[ 3 ], fm.width( seperate( tempFunctions[ i ].visits ) ) );
-        maxWidth[ 4 ] = qMax( maxWidth[ 4 ], fm.width( QString::number( tempFunctions[ i ].timeS, 'f', 2 ) ) );
-        maxWidth[ 5 ] = qMax( maxWidth[ 5 ], fm.width( QString::number( tempFunctions[ i ].timeP, 'f', 2 ) ) );
-        maxWidth[ 6 ] = qMax( maxWidth[ 6 ], fm.width( QString::number( tempFunctions[ i ].timePerVisit, 'f', 2 ) ) );
-        maxWidth[ 7 ] = qMax( maxWidth[ 7 ], fm.width( QString::fromStdString( tempFunctions[ i ].region ) ) );
+        mp_statusBar->showMessage( "Error: The session does not fit " + m_fileName + ", the profile changed" );
+        return;
     }
-    /*set column widths*/
-    int minWidth = 0;
-    for ( int i = 1; i < mp_groupTable->columnCount(); i++ )
+    cancelSizes();
+    mp_filterSaver->setFileName( session.filterFile );
+    mp_filterSaver->compressAction()->setChecked( session.compress );
+    if ( session.sortColumn >= 0 && session.sortColumn < TableModel::COLUMN_NUM )
     {
-        maxWidth[ i ] += 8;
-        minWidth      += maxWidth[ i ];
-        mp_groupTable->setColumnWidth( i, maxWidth[ i ] );
-        mp_functionTable->setColumnWidth( i, maxWidth[ i ] );
+        m_sortColumn = session.sortColumn;
+        m_sortOrder  = session.sortOrder == Qt::AscendingOrder ? Qt::AscendingOrder : Qt::DescendingOrder;
+        applySort();
     }
-    mp_groupTable->setMinimumWidth( minWidth );
-    mp_functionTable->setMinimumWidth( minWidth );
-    mp_sizeTable->setMinimumWidth( minWidth );
-    if ( mp_connection->hasFiltered() )
+    /*the search runs once the index is built*/
+    mp_search->setSearch( session.search, session.onlyMatches );
+    if ( session.tab >= 0 && session.tab < mp_functionTabs->count() )
     {
-        /*sizeTable*/
-        /*add new size*/
-        QStringList sizeLabel;
-        sizeLabel << "" << "without Filter" << "with Filter";
-        mp_sizeTable->setHorizontalHeaderLabels( sizeLabel );
-        QTableWidgetItem* one = new QTableWidgetItem();
-        one->setTextAlignment( Qt::AlignRight | Qt::AlignCenter );
-        one->setText( mp_connection->getReadableByteNo( tempFilteredSizes.traceSize ) );
-        QTableWidgetItem* two = one->clone();
-        two->setText( mp_connection->getReadableByteNo( tempFilteredSizes.maxBuf ) );
-        QTableWidgetItem* tri = one->clone();
-        tri->setText( mp_connection->getReadableByteNo( tempFilteredSizes.totalMemory ) );
-        mp_sizeTable->setItem( 0, 2, one );
-        mp_sizeTable->setItem( 1, 2, two );
-        mp_sizeTable->setItem( 2, 2, tri );
-        mp_sizeTable->setFixedHeight( mp_sizeTable->horizontalHeader()->height() + 92 );
-        mp_sizeTable->setColumnWidth( 1, 90 );
+        mp_functionTabs->setCurrentIndex( session.tab );
+    }
+    if ( !mp_connection->hasFilteredSizes() )
+    {
+        requestSizes();
+    }
+    setWindowModified( false );
+    updateTables();
+    QFileInfo profile( m_fileName );
+    if ( profile.size() != session.profileSize || profile.lastModified() != session.profileModified )
+    {
+        mp_statusBar->showMessage( "Warning: " + m_fileName + " was modified after the session was saved" );
     }
     else
     {
-        /*reset new size column*/
-        mp_sizeTable->setItem( 0, 2, new QTableWidgetItem( "" ) );
-        mp_sizeTable->setItem( 1, 2, new QTableWidgetItem( "" ) );
-        mp_sizeTable->setItem( 2, 2, new QTableWidgetItem( "" ) );
+        mp_statusBar->showMessage( "Session restored" );
     }
-    //mp_groupTable->setSortingEnabled(true);
-    //mp_functionTable->setSortingEnabled(true);
 }
 
-QString
-MainWindow::seperate( int number )
+void
+MainWindow::compareProfile()
 {
-    QString temp = QString::number( number );
-    if ( temp.size() > 3 )
+    mp_statusBar->clearMessage();
+    QString fileName = QFileDialog::getOpenFileName( this, tr( "Compare with" ), QDir::currentPath(), tr( "Profile files (*.cubex)" ) );
+    if ( !fileName.isEmpty() )
     {
-        temp.insert( temp.size() - 3, "," );
+        startBaseline( fileName );
     }
-    /*7 because of the added ,*/
-    if ( temp.size() > 7 )
+}
+
+void
+MainWindow::startBaseline( const QString& fileName )
+{
+    /*independent of the load of the shown profile, both may run at once*/
+    if ( !mp_baseline->load( fileName ) )
     {
-        temp.insert( temp.size() - 7, "," );
+        mp_statusBar->showMessage( "Error: Another baseline is still loading" );
     }
-    return temp;
 }
 
+void
+MainWindow::stopComparing()
+{
+    mp_baseline->stop();
+}
 
-bool
-MainWindow::eventFilter( QObject* object, QEvent* event )
+void
+MainWindow::diffChanged()
 {
-    Q_UNUSED( object );
-    bool ret = false;
-    if ( event->type() == QEvent::KeyPress )
+    mp_groupModel->setDiff( mp_baseline->diff() );
+    mp_functionModel->setDiff( mp_baseline->diff() );
+}
+
+void
+MainWindow::loadFilter()
+{
+    mp_statusBar->clearMessage();
+    if ( m_fileName.isEmpty() )
     {
-        QKeyEvent* keyEvent = static_cast<QKeyEvent*>( event );
-        if ( keyEvent->key() == Qt::Key_Space )
-        {
-            ret = true;
-            changeState();
-        }
-        if ( keyEvent->key() == Qt::Key_Tab )
-        {
-            ret = true;
-            if ( mp_functionTable->selectedItems().size() > 0 )
-            {
-                /*switch to groupTable*/
-                mp_functionTable->clearSelection();
-                mp_groupTable->selectRow( 0 );
-            }
-            else
+        mp_statusBar->showMessage( "Error: No profile loaded" );
+        return;
+    }
+    QString fileName = QFileDialog::getOpenFileName( this, tr( "Load filter file" ), QDir::currentPath(),
+                                                     tr( "Filter files (*.filter);;All files (*)" ) );
+    if ( !fileName.isEmpty() )
+    {
+        applyFilter( fileName );
+    }
+}
+
+void
+MainWindow::applyFilter( const QString& fileName )
+{
+    QString error;
+    int     excluded = mp_connection->applyFilterFile( fileName, &error );
+    if ( excluded < 0 )
+    {
+        mp_statusBar->showMessage( "Error: Loading filter file failed, " + error );
+        return;
+    }
+    /*sizes of the replaced state are outdated*/
+    cancelSizes();
+    mp_statusBar->showMessage( QString( "%1 regions excluded by %2" )
+                               .arg( excluded )
+                               .arg( QFileInfo( fileName ).fileName() ) );
+    if ( !mp_connection->hasFilteredSizes() )
+    {
+        requestSizes();
+    }
+    setWindowModified( true );
+    updateTables();
+}
+
+void
+MainWindow::benchmark( QString fileName, int toggles )
+{
+    m_benchmarkToggles = qMax( 0, toggles );
+    startLoading( fileName, OPEN_PROFILE );
+}
+
+void
+MainWindow::runBenchmark()
+{
+    /*regions that can be excluded, in the shown order*/
+    QVector<int> keys;
+    for ( int i = 0; i < mp_functionModel->rowCount() && keys.size() < m_benchmarkToggles; i++ )
+    {
+        if ( mp_functionModel->flags( mp_functionModel->index( i, 1 ) ) != Qt::NoItemFlags )
+        {
+            keys.append( mp_functionModel->keyAt( i ) );
+        }
+    }
+    /*a click excludes a region, the next one includes it again*/
+    QVector<qint64> times;
+    QElapsedTimer   timer;
+    for ( int i = 0; i < keys.size() * 2; i++ )
+    {
+        timer.start();
+        toggleKeys( QVector<int>() << keys[ i / 2 ], keys[ i / 2 ], false );
+        mp_functionTable->viewport()->repaint();
+        times.append( timer.nsecsElapsed() );
+    }
+    std::sort( times.begin(), times.end() );
+
+    QTextStream err( stderr );
+    err << "regions: " << mp_connection->getFunctionData()->rows.size() << "\n"
+        << "load to display: " << m_benchmarkLoad << " ms\n";
+    if ( !times.isEmpty() )
+    {
+        err << QString( "click to repaint: median %1 ms, max %2 ms, %3 clicks\n" )
+            .arg( times[ times.size() / 2 ] / 1e6, 0, 'f', 2 )
+            .arg( times.last() / 1e6, 0, 'f', 2 )
+            .arg( times.size() );
+    }
+    QCoreApplication::exit( 0 );
+}
+
+void
+MainWindow::initOpen( QString fileName, QString filterFile )
+{
+    if ( fileName.endsWith( ".session" ) )
+    {
+        loadSession( fileName );
+    }
+    else if ( fileName.endsWith( ".cubex" ) && filterFile.endsWith( ".cubex" ) )
+    {
+        /*both load at the same time, the later one starts the diff*/
+        startLoading( fileName );
+        startBaseline( filterFile );
+    }
+    else if ( fileName.endsWith( ".cubex" ) )
+    {
+        /*applied by loadFinished as the initial state of the profile*/
+        m_initialFilter = filterFile;
+        startLoading( fileName );
+    }
+    else
+    {
+        mp_statusBar->showMessage( "Error: Given file isn't a .cubex file" );
+        updateTables();
+    }
+}
+
+void
+MainWindow::startLoading( const QString& fileName, loadMode mode )
+{
+    if ( mp_loadWatcher->isRunning() )
+    {
+        /*loadFinished starts the new file once the old one stopped*/
+        m_pendingFile = fileName;
+        m_pendingMode = mode;
+        m_loadProgress.cancel.fetchAndStoreRelaxed( 1 );
+        return;
+    }
+    /*the shown profile stays usable, the new one is loaded into its own connector*/
+    m_loadingFile = fileName;
+    m_loadingMode = mode;
+    /*a rewrite while loading is noticed by the next check*/
+    QFileInfo profile( fileName );
+    m_loadingSize     = profile.size();
+    m_loadingModified = profile.lastModified();
+    m_loadProgress.stage.fetchAndStoreRelaxed( Connector::OPEN );
+    m_loadProgress.done.fetchAndStoreRelaxed( 0 );
+    m_loadProgress.total.fetchAndStoreRelaxed( 0 );
+    m_loadProgress.cancel.fetchAndStoreRelaxed( 0 );
+    mp_loading = new Connector();
+    m_timer.start();
+    mp_cancelButton->show();
+    showLoadProgress();
+    mp_loadTimer->start();
+    mp_loadWatcher->setFuture( QtConcurrent::run( &Connector::load, mp_loading, fileName, &m_loadProgress ) );
+}
+
+void
+MainWindow::showLoadProgress()
+{
+    int stage = m_loadProgress.stage.fetchAndAddRelaxed( 0 );
+    int total = m_loadProgress.total.fetchAndAddRelaxed( 0 );
+    /*a range of 0 shows a busy indicator for stages that cannot be measured*/
+    mp_progressbar->setRange( 0, total );
+    mp_progressbar->setValue( qMin( m_loadProgress.done.fetchAndAddRelaxed( 0 ), total ) );
+    mp_statusBar->showMessage( QString( "Loading %1: %2 (%3/%4)" )
+                               .arg( QFileInfo( m_loadingFile ).fileName() )
+                               .arg( Connector::stageName( stage ) )
+                               .arg( stage + 1 )
+                               .arg( Connector::LOAD_STAGE_NUM ) );
+}
+
+void
+MainWindow::cancelLoading()
+{
+    if ( mp_loadWatcher->isRunning() )
+    {
+        m_pendingFile.clear();
+        m_loadProgress.cancel.fetchAndStoreRelaxed( 1 );
+        mp_statusBar->showMessage( "Cancelling..." );
+    }
+}
+
+void
+MainWindow::loadFinished()
+{
+    mp_loadTimer->stop();
+    mp_cancelButton->hide();
+    bool       loaded     = mp_loadWatcher->result();
+    Connector* connection = mp_loading;
+    mp_loading = 0;
+    if ( !m_pendingFile.isEmpty() )
+    {
+        delete connection;
+        QString fileName = m_pendingFile;
+        m_pendingFile.clear();
+        startLoading( fileName, m_pendingMode );
+        return;
+    }
+    if ( !loaded )
+    {
+        QString error = connection->getLoadError();
+        delete connection;
+        m_initialFilter.clear();
+        m_restoreSession   = false;
+        m_sessionToRestore = SessionFile::content();
+        restoreProgress();
+        mp_statusBar->showMessage( error.isEmpty() ? "Loading of " + m_loadingFile + " cancelled" : "Error: " + error );
+        if ( m_benchmarkToggles >= 0 )
+        {
+            QTextStream( stderr ) << "Error: " << error << "\n";
+            QCoreApplication::exit( 1 );
+        }
+        return;
+    }
+    if ( m_loadingMode == RELOAD_PROFILE )
+    {
+        reloadFinished( connection );
+        return;
+    }
+    if ( m_loadingMode == ADD_PROFILE )
+    {
+        /*matched by name to the shown functions, scored with their state*/
+        m_session.addProfile( m_loadingFile, connection, mp_connection->getFunctionData(),
+                              mp_connection->getFilterState() );
+        restoreProgress();
+        mp_statusBar->showMessage( QString( "%1 added, %2 profiles" )
+                                   .arg( QFileInfo( m_loadingFile ).fileName() )
+                                   .arg( m_session.profileNum() + 1 ) );
+        reportTime( "load" );
+        updateProfileTable();
+        updateScaling();
+        return;
+    }
+    /*reset() drops the old profile, the loaded connector takes its place*/
+    reset();
+    delete mp_connection;
+    mp_connection = connection;
+    mp_statusBar->clearMessage();
+    m_fileName = m_loadingFile;
+    setWindowTitle( m_fileName + "[*] - " + m_windowTitle );
+    mp_profileWatcher->setProfile( m_fileName, m_loadingSize, m_loadingModified );
+    restoreProgress();
+    updateTables();
+    mp_groupTable->selectRow( 0 );
+    reportTime( "load" );
+    if ( m_benchmarkToggles >= 0 )
+    {
+        /*displayed once the tables are painted*/
+        mp_groupTable->viewport()->repaint();
+        mp_functionTable->viewport()->repaint();
+        m_benchmarkLoad = m_timer.elapsed();
+        QTimer::singleShot( 0, this, SLOT( runBenchmark() ) );
+    }
+    startFrontier();
+    mp_baseline->compare( mp_connection );
+    functionTabChanged( mp_functionTabs->currentIndex() );
+    if ( m_restoreSession )
+    {
+        /*only for the profile of the session, not for one opened meanwhile*/
+        SessionFile::content session = m_sessionToRestore;
+        m_restoreSession   = false;
+        m_sessionToRestore = SessionFile::content();
+        if ( QFileInfo( m_fileName ).absoluteFilePath() == session.profile )
+        {
+            restoreSession( session );
+        }
+    }
+    if ( !m_initialFilter.isEmpty() )
+    {
+        applyFilter( m_initialFilter );
+        m_initialFilter.clear();
+    }
+}
+
+void
+MainWindow::reloadFinished( Connector* connection )
+{
+    /*the selection and the rules follow the functions by name*/
+    int excluded = connection->takeFilter( mp_connection->getFunctionData(), mp_connection->getFilterState(),
+                                           mp_connection->getFilterRules() );
+    bool                            modified   = isWindowModified();
+    int                             sortColumn = m_sortColumn;
+    Qt::SortOrder                   sortOrder  = m_sortOrder;
+    QString                         search     = mp_search->text();
+    bool                            only       = mp_search->onlyMatches();
+    QVector<ProfileSession::source> profiles   = m_session.takeProfiles();
+
+    /*the tables switch to the reloaded profile at once*/
+    reset();
+    delete mp_connection;
+    mp_connection = connection;
+    setWindowTitle( m_fileName + "[*] - " + m_windowTitle );
+    setWindowModified( modified );
+    mp_profileWatcher->setProfile( m_fileName, m_loadingSize, m_loadingModified );
+    for ( int i = 0; i < profiles.size(); i++ )
+    {
+        m_session.addProfile( profiles[ i ].fileName, profiles[ i ].connection,
+                              mp_connection->getFunctionData(), mp_connection->getFilterState() );
+    }
+    /*the search index is kept if the names did not change*/
+    restoreProgress();
+    updateTables();
+    mp_groupTable->selectRow( 0 );
+    reportTime( "reload" );
+    if ( sortColumn != TableModel::CHECK )
+    {
+        m_sortColumn = sortColumn;
+        m_sortOrder  = sortOrder;
+        applySort();
+    }
+    mp_search->setSearch( search, only );
+    if ( !mp_connection->hasFilteredSizes() )
+    {
+        requestSizes();
+    }
+    startFrontier();
+    mp_baseline->compare( mp_connection );
+    functionTabChanged( mp_functionTabs->currentIndex() );
+    mp_statusBar->showMessage( QString( "%1 reloaded at %2, %3 regions excluded" )
+                               .arg( QFileInfo( m_fileName ).fileName() )
+                               .arg( m_loadingModified.toString( "hh:mm:ss" ) )
+                               .arg( excluded ) );
+}
+
+void
+MainWindow::watchProfile( bool on )
+{
+    mp_profileWatcher->setWatching( on );
+    if ( mp_profileWatcher->isWatching() )
+    {
+        mp_statusBar->showMessage( "Watching " + m_fileName );
+        mp_profileWatcher->check();
+    }
+}
+
+void
+MainWindow::profileRewritten( qint64 size, QDateTime modified )
+{
+    if ( mp_loadWatcher->isRunning() && m_loadingMode != RELOAD_PROFILE )
+    {
+        /*another profile is loading, a new one is watched afterwards*/
+        mp_profileWatcher->retry();
+        return;
+    }
+    if ( mp_loadWatcher->isRunning() && m_loadingSize == size && m_loadingModified == modified )
+    {
+        return;
+    }
+    /*a running reload of an older version is restarted*/
+    startLoading( m_fileName, RELOAD_PROFILE );
+}
+
+void
+MainWindow::restoreProgress()
+{
+    /*the progress bar shows the trace size again*/
+    mp_progressbar->setRange( 0, 100 );
+    mp_progressbar->reset();
+    updateSizeTable( QVector<int>() );
+}
+
+void
+MainWindow::startFrontier()
+{
+    /*the input is a copy, the computation does not touch the connector*/
+    m_frontierValid = true;
+    mp_frontierWidget->clear( "computing filter trade-off..." );
+    mp_frontierWatcher->setFuture( QtConcurrent::run( &FilterFrontier::compute,
+                                                      mp_connection->getFrontierInput() ) );
+}
+
+void
+MainWindow::frontierFinished()
+{
+    if ( !m_frontierValid )
+    {
+        return;
+    }
+    m_frontier = mp_frontierWatcher->result();
+    mp_frontierWidget->setFrontier( m_frontier );
+}
+
+void
+MainWindow::startSorting( QSharedPointer<const dataCenter::functionSnapshot> functions )
+{
+    /*orders of an older snapshot are useless, the new ones replace them*/
+    m_sortValid = true;
+    m_sortOrders.clear();
+    mp_sortWatcher->setFuture( QtConcurrent::run( &SortIndex::compute, functions ) );
+}
+
+void
+MainWindow::sortingFinished()
+{
+    if ( !m_sortValid || mp_sortWatcher->isRunning() )
+    {
+        return;
+    }
+    m_sortOrders = mp_sortWatcher->result();
+    if ( m_sortColumn != TableModel::CHECK )
+    {
+        applySort();
+    }
+}
+
+void
+MainWindow::headerClicked( int section )
+{
+    if ( m_fileName.isEmpty() )
+    {
+        return;
+    }
+    if ( section == m_sortColumn )
+    {
+        m_sortOrder = m_sortOrder == Qt::AscendingOrder ? Qt::DescendingOrder : Qt::AscendingOrder;
+    }
+    else
+    {
+        /*numbers start with the largest, names alphabetically*/
+        m_sortColumn = section;
+        m_sortOrder  = section == TableModel::TYPE || section == TableModel::REGION ?
+                       Qt::AscendingOrder : Qt::DescendingOrder;
+    }
+    applySort();
+}
+
+void
+MainWindow::applySort()
+{
+    QHeaderView* header = mp_groupTable->horizontalHeader();
+    if ( m_sortColumn == TableModel::CHECK )
+    {
+        header->setSortIndicatorShown( false );
+        mp_functionModel->setOrder( QVector<int>(), false );
+        return;
+    }
+    header->setSortIndicatorShown( true );
+    header->setSortIndicator( m_sortColumn, m_sortOrder );
+    if ( m_sortOrders.isEmpty() )
+    {
+        /*sortingFinished applies the order*/
+        mp_statusBar->showMessage( "sorting..." );
+        return;
+    }
+    mp_functionModel->setOrder( m_sortOrders[ m_sortColumn ], m_sortOrder == Qt::DescendingOrder );
+    if ( mp_functionTable->selectionModel()->hasSelection() )
+    {
+        mp_functionTable->scrollTo( mp_functionTable->selectionModel()->selectedRows().first() );
+    }
+    if ( mp_statusBar->currentMessage() == "sorting..." )
+    {
+        mp_statusBar->clearMessage();
+    }
+}
+
+void
+MainWindow::searched()
+{
+    showMatches();
+    if ( !mp_search->onlyMatches() )
+    {
+        jumpToMatch( -1 );
+    }
+}
+
+void
+MainWindow::showMatches()
+{
+    bool filtered = mp_search->onlyMatches() && !mp_search->text().isEmpty();
+    if ( !filtered && !m_searchFiltered )
+    {
+        /*all rows are shown already*/
+        return;
+    }
+    int current = -1;
+    if ( mp_functionTable->selectionModel()->hasSelection() )
+    {
+        current = mp_functionModel->keyAt( mp_functionTable->currentIndex().row() );
+    }
+    m_searchFiltered = filtered;
+    mp_functionModel->setVisible( mp_search->matches(), !filtered );
+    if ( current >= 0 )
+    {
+        selectFunction( current );
+    }
+}
+
+void
+MainWindow::nextMatch()
+{
+    int current = -1;
+    if ( mp_functionTable->selectionModel()->hasSelection() )
+    {
+        current = mp_functionTable->currentIndex().row();
+    }
+    jumpToMatch( current );
+}
+
+void
+MainWindow::jumpToMatch( int afterRow )
+{
+    /*the first match below afterRow in the current order, else the first one*/
+    QVector<int> matches = mp_search->matches();
+    int          next    = -1;
+    int          first   = -1;
+    for ( int i = 0; i < matches.size(); i++ )
+    {
+        int row = mp_functionModel->rowOf( matches[ i ] );
+        if ( row < 0 )
+        {
+            continue;
+        }
+        if ( row > afterRow && ( next < 0 || row < next ) )
+        {
+            next = row;
+        }
+        if ( first < 0 || row < first )
+        {
+            first = row;
+        }
+    }
+    if ( next < 0 )
+    {
+        next = first;
+    }
+    if ( next >= 0 )
+    {
+        selectFunction( mp_functionModel->keyAt( next ) );
+    }
+}
+
+void
+MainWindow::selectFunction( int key )
+{
+    int row = mp_functionModel->rowOf( key );
+    if ( row < 0 )
+    {
+        return;
+    }
+    mp_groupTable->clearSelection();
+    mp_functionTable->selectRow( row );
+    mp_functionTable->scrollTo( mp_functionModel->index( row, 0 ) );
+}
+
+void
+MainWindow::focusSearch()
+{
+    mp_search->focus();
+}
+
+void
+MainWindow::changeMatches( bool exclude )
+{
+    QVector<int> matches = mp_search->matches();
+    if ( matches.isEmpty() )
+    {
+        return;
+    }
+    mp_statusBar->clearMessage();
+    m_timer.start();
+    /*one edit and one size calculation for all matches*/
+    int changed = mp_connection->excludeFunctions( matches, exclude );
+    mp_statusBar->showMessage( QString( "%1 regions %2" )
+                               .arg( changed )
+                               .arg( exclude ? "excluded" : "included" ) );
+    if ( changed > 0 )
+    {
+        setWindowModified( true );
+        requestSizes();
+    }
+    updateTables();
+    reportTime( "update" );
+}
+
+void
+MainWindow::applyFrontierPoint( int index )
+{
+    mp_statusBar->clearMessage();
+    /*the point carries its sizes, running calculations are outdated*/
+    cancelSizes();
+    mp_connection->applyFrontierPoint( m_frontier, index );
+    setWindowModified( true );
+    updateTables();
+}
+
+void
+MainWindow::undoFilter()
+{
+    cancelSizes();
+    if ( !mp_connection->undo() )
+    {
+        return;
+    }
+    mp_statusBar->clearMessage();
+    /*history entries keep their sizes, only states never calculated need a run*/
+    if ( !mp_connection->hasFilteredSizes() )
+    {
+        requestSizes();
+    }
+    setWindowModified( true );
+    updateTables();
+}
+
+void
+MainWindow::redoFilter()
+{
+    cancelSizes();
+    if ( !mp_connection->redo() )
+    {
+        return;
+    }
+    mp_statusBar->clearMessage();
+    if ( !mp_connection->hasFilteredSizes() )
+    {
+        requestSizes();
+    }
+    setWindowModified( true );
+    updateTables();
+}
+
+void
+MainWindow::selectByRules()
+{
+    if ( m_fileName.isEmpty() )
+    {
+        mp_statusBar->showMessage( "Error: No profile loaded" );
+        return;
+    }
+    SelectionDialog dialog( mp_connection, this );
+    if ( dialog.exec() != QDialog::Accepted )
+    {
+        return;
+    }
+    Connector::selectionPreview preview = dialog.preview();
+    /*the preview carries the sizes of the new state*/
+    cancelSizes();
+    mp_connection->applySelection( preview );
+    mp_statusBar->showMessage( QString( "%1 regions %2" )
+                               .arg( preview.changed )
+                               .arg( preview.exclude ? "excluded" : "included" ) );
+    if ( !mp_connection->hasFilteredSizes() )
+    {
+        requestSizes();
+    }
+    setWindowModified( true );
+    updateTables();
+}
+
+void
+MainWindow::requestSizes()
+{
+    m_sizeGeneration.fetchAndAddRelaxed( 1 );
+    mp_busyLabel->show();
+    mp_sizeTimer->start();
+}
+
+void
+MainWindow::cancelSizes()
+{
+    m_sizeGeneration.fetchAndAddRelaxed( 1 );
+    m_sizePending = false;
+    mp_sizeTimer->stop();
+    mp_busyLabel->hide();
+}
+
+void
+MainWindow::startSizeCalculation()
+{
+    if ( mp_sizeWatcher->isRunning() )
+    {
+        /*the running calculation notices it is outdated and stops early*/
+        m_sizePending = true;
+        return;
+    }
+    mp_sizeWatcher->setFuture( QtConcurrent::run( &Connector::computeFilteredSizes,
+                                                  mp_connection->getSizeRequest( &m_sizeGeneration ) ) );
+}
+
+void
+MainWindow::sizesFinished()
+{
+    Connector::sizeResult result = mp_sizeWatcher->result();
+    if ( m_sizePending )
+    {
+        m_sizePending = false;
+        startSizeCalculation();
+        return;
+    }
+    if ( result.cancelled || result.generation != m_sizeGeneration.fetchAndAddRelaxed( 0 ) )
+    {
+        return;
+    }
+    mp_connection->setFilteredSizes( result );
+    mp_busyLabel->hide();
+    updateTables();
+}
+
+void
+MainWindow::unselectFunctionTable()
+{
+    mp_functionTable->clearSelection();
+}
+
+void
+MainWindow::unselectGroupTable()
+{
+    mp_groupTable->clearSelection();
+}
+
+void
+MainWindow::updateTables()
+{
+    if ( m_fileName.isEmpty() )
+    {
+        return;
+    }
+    /*get data from Connector, the snapshots are shared and not copied*/
+    Connector::changeSet                               changes   = mp_connection->takeChanges();
+    QSharedPointer<const dataCenter::functionSnapshot> functions = mp_connection->getFunctionData();
+    QSharedPointer<const dataCenter::groupSnapshot>    groups    = mp_connection->getGroupData();
+
+    /*the models only hand out the rows the views ask for and
+     * only repaint the rows the connector reported as changed*/
+    if ( groups->version != m_groupVersion )
+    {
+        m_groupVersion = groups->version;
+        mp_groupModel->setGroups( groups, changes.groups );
+        int height = 2 + groups->rows.size() * mp_groupTable->verticalHeader()->defaultSectionSize() +
+                     mp_groupTable->horizontalHeader()->height();
+        mp_groupTable->setMaximumHeight( height );
+        mp_groupTable->setMinimumHeight( height );
+    }
+
+    if ( functions->version != m_functionVersion )
+    {
+        m_functionVersion = functions->version;
+        m_stateVersion    = mp_connection->getStateVersion();
+        mp_functionModel->setFunctions( functions, mp_connection->getFilterState() );
+        updateColumnWidths( groups->rows, functions->rows );
+        startSorting( functions );
+        m_searchFiltered = false;
+        mp_search->setFunctions( functions );
+        mp_brush->setFunctions( mp_connection, functions );
+    }
+    else if ( mp_connection->getStateVersion() != m_stateVersion )
+    {
+        /*only the filter state changed, keep the rows and update the checkboxes*/
+        m_stateVersion = mp_connection->getStateVersion();
+        mp_functionModel->setState( mp_connection->getFilterState(), changes.functions, changes.allFunctions );
+        mp_callTree->setState( mp_connection->getFilterState() );
+        mp_brush->updatePreview();
+    }
+    updateSizeTable( changes.sizes );
+    updateHeatmap();
+    updateRegionDetail();
+    updateFileTable();
+    updateProfileTable();
+    updateScaling();
+}
+
+void
+MainWindow::updateProfileTable()
+{
+    if ( mp_functionTabs->currentWidget() == mp_profiles && !m_fileName.isEmpty() )
+    {
+        mp_profiles->setProfiles( mp_connection, m_fileName, m_session );
+    }
+}
+
+void
+MainWindow::updateScaling()
+{
+    if ( mp_functionTabs->currentWidget() == mp_scaling && !m_fileName.isEmpty() )
+    {
+        mp_scaling->compute( mp_connection, m_session );
+    }
+}
+
+void
+MainWindow::functionSelectionChanged()
+{
+    if ( !m_fileName.isEmpty() )
+    {
+        updateHeatmap();
+        updateRegionDetail();
+    }
+}
+
+int
+MainWindow::selectedFunction()
+{
+    QModelIndexList selection = mp_functionTable->selectionModel()->selectedRows();
+    if ( selection.size() != 1 )
+    {
+        return -1;
+    }
+    return mp_functionModel->keyAt( selection.first().row() );
+}
+
+void
+MainWindow::updateHeatmap()
+{
+    /*a single selected function is shown on its own, otherwise all of them*/
+    int      key     = selectedFunction();
+    uint64_t version = mp_connection->getStateVersion();
+    if ( key == m_heatmapKey && version == m_heatmapVersion )
+    {
+        return;
+    }
+    QVector<uint64_t> bytes;
+    if ( !mp_connection->getProcessBytes( key, &bytes ) )
+    {
+        /*states from the frontier only know their totals, the per process
+         * values need a calculation, the next updateTables shows them*/
+        if ( !mp_sizeWatcher->isRunning() && !mp_sizeTimer->isActive() )
+        {
+            requestSizes();
+        }
+        return;
+    }
+    m_heatmapKey     = key;
+    m_heatmapVersion = version;
+    QString title = "Bytes per process, all regions";
+    if ( key >= 0 )
+    {
+        title = "Bytes per process of " +
+                QString::fromStdString( mp_connection->getFunctionData()->rows[ key ].region );
+    }
+    else if ( mp_connection->hasFiltered() )
+    {
+        title += " with filter";
+    }
+    mp_heatmap->setValues( ProcessPyramid::build( bytes ), title );
+}
+
+void
+MainWindow::updateRegionDetail()
+{
+    mp_regionDetail->showRegion( mp_connection, selectedFunction() );
+}
+
+void
+MainWindow::functionTabChanged( int index )
+{
+    QWidget* page = mp_functionTabs->widget( index );
+    if ( page != mp_brush )
+    {
+        /*the preview belongs to the visible brush*/
+        mp_brush->clearBrush();
+    }
+    if ( page == mp_callTree && !m_fileName.isEmpty() )
+    {
+        mp_callTree->load( mp_connection );
+    }
+    updateFileTable();
+    updateProfileTable();
+    updateScaling();
+}
+
+void
+MainWindow::changeSubtrees( bool exclude )
+{
+    QVector<int> keys = mp_callTree->selectedFunctions();
+    if ( keys.isEmpty() )
+    {
+        mp_statusBar->showMessage( "Select call paths in the call tree first" );
+        return;
+    }
+    mp_statusBar->clearMessage();
+    m_timer.start();
+    int changed = mp_connection->excludeFunctions( keys, exclude );
+    mp_statusBar->showMessage( QString( "%1 regions of the selected call paths %2" )
+                               .arg( changed )
+                               .arg( exclude ? "excluded" : "included" ) );
+    if ( changed > 0 )
+    {
+        setWindowModified( true );
+        requestSizes();
+    }
+    updateTables();
+    reportTime( "update" );
+}
+
+void
+MainWindow::changeFiles( bool exclude )
+{
+    QVector<FilterFile::rule> rules = mp_files->rules( exclude );
+    if ( m_fileName.isEmpty() || rules.isEmpty() )
+    {
+        mp_statusBar->showMessage( "Type a file pattern or select files first" );
+        return;
+    }
+    mp_statusBar->clearMessage();
+    m_timer.start();
+    int changed = mp_connection->addFilterRules( rules );
+    mp_statusBar->showMessage( QString( "%1 regions %2 by %3 file rules" )
+                               .arg( changed )
+                               .arg( exclude ? "excluded" : "included" )
+                               .arg( rules.size() ) );
+    if ( changed > 0 )
+    {
+        setWindowModified( true );
+        requestSizes();
+    }
+    updateTables();
+    reportTime( "update" );
+}
+
+void
+MainWindow::updateFileTable()
+{
+    if ( mp_functionTabs->currentWidget() == mp_files && !m_fileName.isEmpty() )
+    {
+        mp_files->setFiles( mp_connection );
+    }
+}
+
+void
+MainWindow::previewChanged()
+{
+    QVector<int> rows;
+    rows << 0 << 1 << 2;
+    updateSizeTable( rows );
+}
+
+void
+MainWindow::changeBrushed( bool exclude )
+{
+    mp_statusBar->clearMessage();
+    m_timer.start();
+    Connector::selectionPreview preview = mp_brush->selection( exclude );
+    mp_brush->clearBrush();
+    cancelSizes();
+    mp_connection->applySelection( preview );
+    mp_statusBar->showMessage( QString( "%1 regions %2" )
+                               .arg( preview.changed )
+                               .arg( exclude ? "excluded" : "included" ) );
+    if ( !mp_connection->hasFilteredSizes() )
+    {
+        requestSizes();
+    }
+    if ( preview.changed > 0 )
+    {
+        setWindowModified( true );
+    }
+    updateTables();
+    reportTime( "update" );
+}
+
+void
+MainWindow::updateColumnWidths( const QVector<dataCenter::groupData>& groups,
+                                const QVector<dataCenter::data>&      functions )
+{
+    /*the widest number of a column belongs to its largest value, so one
+     * text per column is measured instead of every row*/
+    QFont        def( "DejaVu Sans", 10, QFont::Normal );
+    QFontMetrics fm( def );
+    QVector<int> maxWidth;
+    for ( int i = 0; i < TableModel::COLUMN_NUM; i++ )
+    {
+        maxWidth.push_back( fm.width( mp_groupModel->headerData( i, Qt::Horizontal ).toString() ) );
+    }
+    int    maxBuf       = 0;
+    int    visits       = 0;
+    double timeS        = 0;
+    double timeP        = 0;
+    double timePerVisit = 0;
+    /*the types of the functions are the types of the groups*/
+    for ( int i = 0; i < groups.size(); i++ )
+    {
+        maxWidth[ TableModel::TYPE ]   = qMax( maxWidth[ TableModel::TYPE ], fm.width( QString::fromStdString( groups[ i ].type ) ) );
+        maxWidth[ TableModel::REGION ] = qMax( maxWidth[ TableModel::REGION ], fm.width( QString::fromStdString( groups[ i ].region ) ) );
+        maxBuf                         = qMax( maxBuf, groups[ i ].maxBuf );
+        visits                         = qMax( visits, groups[ i ].visits );
+        timeS                          = qMax( timeS, groups[ i ].timeS );
+        timeP                          = qMax( timeP, groups[ i ].timeP );
+        timePerVisit                   = qMax( timePerVisit, groups[ i ].timePerVisit );
+    }
+    int longestRegion = -1;
+    for ( int i = 0; i < functions.size(); i++ )
+    {
+        timePerVisit = qMax( timePerVisit, functions[ i ].timePerVisit );
+        if ( longestRegion < 0 || functions[ i ].region.size() > functions[ longestRegion ].region.size() )
+        {
+            longestRegion = i;
+        }
+    }
+    if ( longestRegion >= 0 )
+    {
+        maxWidth[ TableModel::REGION ] = qMax( maxWidth[ TableModel::REGION ],
+                                               fm.width( QString::fromStdString( functions[ longestRegion ].region ) ) );
+    }
+    maxWidth[ TableModel::MAX_BUF ]        = qMax( maxWidth[ TableModel::MAX_BUF ], fm.width( TableModel::seperate( maxBuf ) ) );
+    maxWidth[ TableModel::VISITS ]         = qMax( maxWidth[ TableModel::VISITS ], fm.width( TableModel::seperate( visits ) ) );
+    maxWidth[ TableModel::TIME ]           = qMax( maxWidth[ TableModel::TIME ], fm.width( QString::number( timeS, 'f', 2 ) ) );
+    maxWidth[ TableModel::TIME_PERCENT ]   = qMax( maxWidth[ TableModel::TIME_PERCENT ], fm.width( QString::number( timeP, 'f', 2 ) ) );
+    maxWidth[ TableModel::TIME_PER_VISIT ] = qMax( maxWidth[ TableModel::TIME_PER_VISIT ], fm.width( QString::number( timePerVisit, 'f', 2 ) ) );
+
+    /*set column widths*/
+    int minWidth = 0;
+    for ( int i = 1; i < TableModel::COLUMN_NUM; i++ )
+    {
+        maxWidth[ i ] += 8;
+        minWidth      += maxWidth[ i ];
+        mp_groupTable->setColumnWidth( i, maxWidth[ i ] );
+        mp_functionTable->setColumnWidth( i, maxWidth[ i ] );
+    }
+    mp_groupTable->setMinimumWidth( minWidth );
+    mp_functionTable->setMinimumWidth( minWidth );
+    mp_sizeTable->setMinimumWidth( minWidth );
+}
+
+void
+MainWindow::updateSizeTable( const QVector<int>& rows )
+{
+    if ( m_fileName.isEmpty() )
+    {
+        return;
+    }
+    dataCenter::sizes tempSizes         = mp_connection->getSizes();
+    dataCenter::sizes tempFilteredSizes = mp_connection->getFilteredSizes();
+    bool              previewActive     = mp_brush->isPreviewActive();
+    bool              filtered          = mp_connection->hasFiltered() || previewActive;
+    if ( previewActive )
+    {
+        /*the filter column shows the state after excluding the brushed functions*/
+        const Connector::sizeResult& after = mp_brush->preview().after;
+
+        tempFilteredSizes.traceSize   = after.traceSize;
+        tempFilteredSizes.maxBuf      = after.maxBuf;
+        tempFilteredSizes.totalMemory = mp_connection->getTotalMemory( after.maxBuf );
+    }
+
+    /*set progressbar values*/
+    mp_progressbar->setMaximum( tempSizes.traceSize );
+    if ( filtered )
+    {
+        mp_progressbar->setValue( tempFilteredSizes.traceSize );
+    }
+    else
+    {
+        mp_progressbar->setValue( tempSizes.traceSize );
+    }
+
+    if ( m_sizeTableFilled && filtered == m_sizeFiltered && previewActive == m_sizePreviewShown )
+    {
+        /*the layout stays, only rewrite the cells whose value changed*/
+        if ( filtered )
+        {
+            uint64_t values[ 3 ] = { tempFilteredSizes.traceSize, tempFilteredSizes.maxBuf, tempFilteredSizes.totalMemory };
+            for ( int i = 0; i < rows.size(); i++ )
             {
-                mp_groupTable->clearSelection();
-                mp_functionTable->selectRow( 0 );
+                mp_sizeTable->item( rows[ i ], 2 )->setText( mp_connection->getReadableByteNo( values[ rows[ i ] ] ) );
             }
         }
-        if ( keyEvent->key() == Qt::Key_Up )
+        return;
+    }
+    m_sizeTableFilled  = true;
+    m_sizeFiltered     = filtered;
+    m_sizePreviewShown = previewActive;
+
+    /*sizeTable*/
+    mp_sizeTable->setItem( 0, 1, mp_prototypeNumberItem->clone() );
+    mp_sizeTable->setItem( 1, 1, mp_prototypeNumberItem->clone() );
+    mp_sizeTable->setItem( 2, 1, mp_prototypeNumberItem->clone() );
+    mp_sizeTable->item( 0, 1 )->setText( mp_connection->getReadableByteNo( tempSizes.traceSize ) );
+    mp_sizeTable->item( 1, 1 )->setText( mp_connection->getReadableByteNo( tempSizes.maxBuf ) );
+    mp_sizeTable->item( 2, 1 )->setText( mp_connection->getReadableByteNo( tempSizes.totalMemory ) );
+    if ( filtered )
+    {
+        /*sizeTable*/
+        /*add new size*/
+        QStringList sizeLabel;
+        sizeLabel << "" << "without Filter" << ( previewActive ? "Preview" : "with Filter" );
+        mp_sizeTable->setHorizontalHeaderLabels( sizeLabel );
+        QTableWidgetItem* one = new QTableWidgetItem();
+        one->setTextAlignment( Qt::AlignRight | Qt::AlignCenter );
+        one->setText( mp_connection->getReadableByteNo( tempFilteredSizes.traceSize ) );
+        QTableWidgetItem* two = one->clone();
+        two->setText( mp_connection->getReadableByteNo( tempFilteredSizes.maxBuf ) );
+        QTableWidgetItem* tri = one->clone();
+        tri->setText( mp_connection->getReadableByteNo( tempFilteredSizes.totalMemory ) );
+        mp_sizeTable->setItem( 0, 2, one );
+        mp_sizeTable->setItem( 1, 2, two );
+        mp_sizeTable->setItem( 2, 2, tri );
+        mp_sizeTable->setFixedHeight( mp_sizeTable->horizontalHeader()->height() + 92 );
+        mp_sizeTable->setColumnWidth( 1, 90 );
+    }
+    else
+    {
+        /*reset new size column*/
+        mp_sizeTable->setItem( 0, 2, new QTableWidgetItem( "" ) );
+        mp_sizeTable->setItem( 1, 2, new QTableWidgetItem( "" ) );
+        mp_sizeTable->setItem( 2, 2, new QTableWidgetItem( "" ) );
+    }
+}
+
+bool
+MainWindow::eventFilter( QObject* object, QEvent* event )
+{
+    Q_UNUSED( object );
+    bool ret = false;
+    if ( event->type() == QEvent::KeyPress )
+    {
+        QKeyEvent* keyEvent = static_cast<QKeyEvent*>( event );
+        if ( keyEvent->key() == Qt::Key_Space )
+        {
+            ret = true;
+            changeState();
+        }
+        if ( keyEvent->key() == Qt::Key_Tab )
         {
             ret = true;
-            /* check which table*/
-            if ( mp_functionTable->selectedItems().size() > 0 )
+            if ( mp_functionTable->selectionModel()->hasSelection() )
             {
-                /*functionTable*/
-                /*check if row unselectable*/
-                if ( mp_functionTable->currentRow() != 0 )
-                {
-                    int nextPossible = 1;
-                    while ( mp_functionTable->item( mp_functionTable->currentRow() - nextPossible, 1 )->flags() == Qt::NoItemFlags )
-                    {
-                        nextPossible++;
-                        if ( mp_functionTable->currentRow() - nextPossible == 0 )
-                        {
-                            break;
-                        }
-                    }
-                    mp_functionTable->selectRow( mp_functionTable->currentRow() - nextPossible );
-                }
+                /*switch to groupTable*/
+                mp_functionTable->clearSelection();
+                mp_groupTable->selectRow( 0 );
             }
             else
             {
-                if ( mp_groupTable->currentRow() != 0 )
-                {
-                    int nextPossible = 1;
-                    while ( mp_groupTable->item( mp_groupTable->currentRow() - nextPossible, 1 )->flags() == Qt::NoItemFlags )
-                    {
-                        nextPossible++;
-                        if ( mp_groupTable->currentRow() - nextPossible == 0 )
-                        {
-                            break;
-                        }
-                    }
-                    mp_groupTable->selectRow( mp_groupTable->currentRow() - nextPossible );
-                }
+                mp_groupTable->clearSelection();
+                mp_functionTable->selectRow( 0 );
             }
         }
-        if ( keyEvent->key() == Qt::Key_Down )
+        if ( keyEvent->key() == Qt::Key_Up || keyEvent->key() == Qt::Key_Down )
         {
             ret = true;
             /* check which table*/
-            if ( mp_functionTable->selectedItems().size() > 0 )
+            QTableView* table = mp_functionTable->selectionModel()->hasSelection() ?
+                                mp_functionTable : mp_groupTable;
+            QAbstractItemModel* model = table->model();
+            int                 step  = keyEvent->key() == Qt::Key_Up ? -1 : 1;
+            int                 row   = table->currentIndex().row() + step;
+            /*unselectable rows are skipped*/
+            while ( row >= 0 && row < model->rowCount() && model->flags( model->index( row, 1 ) ) == Qt::NoItemFlags )
             {
-                /*functionTable*/
-                /*check if row unselectable*/
-                if ( mp_functionTable->currentRow() != mp_functionTable->rowCount() - 1 )
-                {
-                    int nextPossible = 1;
-                    while ( mp_functionTable->item( mp_functionTable->currentRow() + nextPossible, 1 )->flags() == Qt::NoItemFlags )
-                    {
-                        nextPossible++;
-                        if ( mp_functionTable->currentRow() + nextPossible == mp_functionTable->rowCount() )
-                        {
-                            break;
-                        }
-                    }
-                    mp_functionTable->selectRow( mp_functionTable->currentRow() + nextPossible );
-                }
+                row += step;
             }
-            else
+            if ( row >= 0 && row < model->rowCount() )
             {
-                if ( mp_groupTable->currentRow() != mp_groupTable->rowCount() - 1 )
-                {
-                    int nextPossible = 1;
-                    while ( mp_groupTable->item( mp_groupTable->currentRow() + nextPossible, 1 )->flags() == Qt::NoItemFlags )
-                    {
-                        nextPossible++;
-                        if ( mp_groupTable->currentRow() + nextPossible == mp_groupTable->rowCount() )
-                        {
-                            break;
-                        }
-                    }
-                    mp_groupTable->selectRow( mp_groupTable->currentRow() + nextPossible );
-                }
+                table->selectRow( row );
             }
         }
     }
@@ -742,8 +1939,22 @@ MainWindow::showShortcuts()
                     "Space\t change state\n"
                     "Key Up\n"
                     "Key Down\t navigate in table\n"
+                    "Shift/Ctrl+Click\t select several rows, a checkbox or Space switches all of them\n"
+                    "Ctrl+a\t select all visible rows\n"
                     "Ctrl+o\t open file\n"
-                    "Ctrl+s\t create filter file\n" );
+                    "Ctrl+l\t load a filter file\n"
+                    "Ctrl+Shift+o\t add a profile scored with the same filter\n"
+                    "Ctrl+d\t compare with a baseline profile\n"
+                    "Ctrl+w\t reload the profile whenever it is rewritten\n"
+                    "Ctrl+s\t create filter file\n"
+                    "Ctrl+e\t export the excluded regions as a list or a JSON report\n"
+                    "Ctrl+Alt+s\t save the session\n"
+                    "Ctrl+Alt+o\t open a session\n"
+                    "Ctrl+z\t undo\n"
+                    "Ctrl+Shift+z\t redo\n"
+                    "Ctrl+r\t select regions by rules\n"
+                    "Ctrl+f\t search regions, Enter jumps to the next match\n"
+                    "Header click\t sort the regions, again to reverse, first column unsorts\n" );
     msgBox.exec();
 }
 
@@ -759,22 +1970,49 @@ MainWindow::reset()
 {
     setWindowModified( false );
     setWindowTitle( m_windowTitle );
+    cancelSizes();
+    mp_regionDetail->cancel();
+    mp_callTree->cancel();
+    mp_brush->clear();
     if ( mp_connection )
     {
         delete mp_connection;
     }
-    mp_connection = new Connector();
-    mp_groupTable->clearContents();
+    mp_connection     = new Connector();
+    m_functionVersion = 0;
+    m_groupVersion    = 0;
+    m_stateVersion    = 0;
+    m_frontierValid   = false;
+    m_frontier        = FilterFrontier::result();
+    m_sortValid       = false;
+    m_sortColumn      = TableModel::CHECK;
+    m_sortOrders.clear();
+    mp_groupTable->horizontalHeader()->setSortIndicatorShown( false );
+    mp_files->clear();
+    mp_baseline->compare( 0 );
+    m_session.clear();
+    mp_profiles->clear();
+    mp_scaling->clear();
+    mp_search->clear();
+    m_searchFiltered = false;
+    mp_frontierWidget->clear();
+    mp_heatmap->clear();
+    m_heatmapVersion = 0;
+    m_heatmapKey     = -1;
+    mp_regionDetail->clear();
+    mp_groupModel->setGroups( QSharedPointer<const dataCenter::groupSnapshot>() );
+    mp_functionModel->setFunctions( QSharedPointer<const dataCenter::functionSnapshot>(), FilterState() );
+    mp_timingLabel->clear();
+    m_sizeTableFilled = false;
     mp_sizeTable->clearContents();
     fillSizeTable();
-    mp_functionTable->clearContents();
     mp_progressbar->reset();
 }
 
 QString
 MainWindow::filterFile()
 {
-    return m_filterFileName;
+    return mp_filterSaver->fileName();
 }
 
 QString
@@ -782,12 +2020,23 @@ MainWindow::totalMemory()
 {
     if ( mp_connection )
     {
-        dataCenter::sizes tempSizes = mp_connection->getSizes();
-        if ( tempSizes.totalMemory > std::numeric_limits<uint32_t>::max() )
+        /*the window may close before the filtered sizes were calculated*/
+        if ( !mp_connection->hasFilteredSizes() )
+        {
+            cancelSizes();
+            Connector::sizeRequest request = mp_connection->getSizeRequest( &m_sizeGeneration );
+            mp_connection->setFilteredSizes( Connector::computeFilteredSizes( request ) );
+        }
+        m_session.update( mp_connection->getFilterState() );
+        /*with the filter, the worst profile of the session decides as in
+         * the "Profiles" tab*/
+        dataCenter::sizes tempSizes = mp_connection->getFilteredSizes();
+        uint64_t          memory    = qMax( tempSizes.totalMemory, m_session.worstTotalMemory( true ) );
+        if ( memory > std::numeric_limits<uint32_t>::max() )
         {
             return QString();
         }
-        return mp_connection->getReadableByteNo( tempSizes.totalMemory );
+        return mp_connection->getReadableByteNo( memory );
     }
 
     return QString();
@@ -17,6 +17,8 @@
 #include <QtGlobal>
 #include <QPushButton>
 #include <QTableWidget>
+#include <QTableView>
+#include <QElapsedTimer>
 #include <QLayout>
 #include <QDebug>
 #include <QHeaderView>
@@ -26,15 +28,40 @@
 #include <QFileDialog>
 #include <QStatusBar>
 #include <QMenuBar>
+#include <QAction>
 #include <QMainWindow>
-#include <QCheckBox>
 #include <QKeyEvent>
 #include <QEvent>
 #include <QMessageBox>
 #include <QProgressBar>
-#include <QSignalMapper>
+#include <QFutureWatcher>
+#include <QtConcurrentRun>
+#include <QTimer>
+#include <QAtomicInt>
+#include <QTabWidget>
+#include <QCheckBox>
+#include <QFileInfo>
+#include <QDateTime>
 
 #include "connector.hpp"
+#include "frontierwidget.hpp"
+#include "heatmapwidget.hpp"
+#include "brushwidget.hpp"
+#include "regiondetailwidget.hpp"
+#include "selectiondialog.hpp"
+#include "tablemodel.hpp"
+#include "calltreewidget.hpp"
+#include "sortindex.hpp"
+#include "filtercompression.hpp"
+#include "profilesession.hpp"
+#include "sessionfile.hpp"
+#include "baselinewidget.hpp"
+#include "fileswidget.hpp"
+#include "filtersaver.hpp"
+#include "searchbar.hpp"
+#include "profileswidget.hpp"
+#include "profilewatcher.hpp"
+#include "scalingwidget.hpp"
 
 
 class Connector;
@@ -47,8 +74,12 @@ public:
     MainWindow( QWidget* parent = 0 );
     ~MainWindow();
 
+    /*filterFile, if given, is applied once the profile is loaded, a
+     * .cubex instead is loaded in parallel as the baseline to compare
+     * with, a .session file reopens its profile with the saved state*/
     void
-    initOpen( QString fileName );
+    initOpen( QString fileName,
+              QString filterFile = QString() );
 
     QString
     filterFile();
@@ -56,15 +87,49 @@ public:
     QString
     totalMemory();
 
+    /*loads fileName, excludes and includes again the first toggles
+     * regions and prints the load to display and click to repaint times
+     * to stderr before quitting*/
+    void
+    benchmark( QString fileName,
+               int     toggles );
+
 private:
+    /*what a loaded profile is used for*/
+    enum loadMode
+    {
+        /*replaces the shown profile*/
+        OPEN_PROFILE,
+        /*joins m_session*/
+        ADD_PROFILE,
+        /*the shown profile was rewritten, its filter is kept*/
+        RELOAD_PROFILE
+    };
+
     /*GUI elements*/
-    QVBoxLayout*  mp_layout;
-    QTableWidget* mp_sizeTable;
-    QTableWidget* mp_groupTable;
-    QTableWidget* mp_functionTable;
-    QStatusBar*   mp_statusBar;
-    QMenuBar*     mp_menu;
-    QProgressBar* mp_progressbar;
+    QVBoxLayout*        mp_layout;
+    QTableWidget*       mp_sizeTable;
+    QTableView*         mp_groupTable;
+    QTableView*         mp_functionTable;
+    QStatusBar*         mp_statusBar;
+    QMenuBar*           mp_menu;
+    QProgressBar*       mp_progressbar;
+    QLabel*             mp_busyLabel;
+    FrontierWidget*     mp_frontierWidget;
+    HeatmapWidget*      mp_heatmap;
+    RegionDetailWidget* mp_regionDetail;
+    QLabel*             mp_timingLabel;
+    SearchBar*          mp_search;
+    QTabWidget*         mp_functionTabs;
+    CallTreeWidget*     mp_callTree;
+    BrushWidget*        mp_brush;
+    FilesWidget*        mp_files;
+    ProfilesWidget*     mp_profiles;
+    ScalingWidget*      mp_scaling;
+
+    /*models of the group and function table*/
+    GroupTableModel*    mp_groupModel;
+    FunctionTableModel* mp_functionModel;
 
     /*instance of Connector*/
     Connector* mp_connection;
@@ -72,12 +137,91 @@ private:
     QStringList m_noFilter;
 
     QTableWidgetItem* mp_prototypeNumberItem;
-    QTableWidgetItem* mp_prototypeTextItem;
 
-    QSignalMapper* mp_signalMapper;
+    /*load and update times shown in the status bar*/
+    QElapsedTimer m_timer;
+
+    /*regions to toggle by benchmark(), -1 without, and the measured load
+     * to display time*/
+    int    m_benchmarkToggles;
+    qint64 m_benchmarkLoad;
+
+    /*versions of the connector data shown in the tables*/
+    uint64_t m_functionVersion;
+    uint64_t m_groupVersion;
+    uint64_t m_stateVersion;
+
+    /*filter trade-off curve, computed in the background after loading*/
+    QFutureWatcher<FilterFrontier::result>* mp_frontierWatcher;
+    FilterFrontier::result                  m_frontier;
+    bool                                    m_frontierValid;
+
+    /*filtered sizes are recalculated in the background, newer requests
+     * increase the generation and supersede running ones*/
+    QTimer*                                mp_sizeTimer;
+    QFutureWatcher<Connector::sizeResult>* mp_sizeWatcher;
+    QAtomicInt                             m_sizeGeneration;
+    bool                                   m_sizePending;
+
+    /*orders of every function column, sorted in the background after loading,
+     * m_sortColumn is CHECK while the function table is unsorted*/
+    QFutureWatcher<QVector<QVector<int> > >* mp_sortWatcher;
+    QVector<QVector<int> >                   m_sortOrders;
+    bool                                     m_sortValid;
+    int                                      m_sortColumn;
+    Qt::SortOrder                            m_sortOrder;
+
+    /*only the matches of the search are shown in the function table*/
+    bool m_searchFiltered;
+
+    /*the size table is only rebuilt if the filter column appears or vanishes*/
+    bool m_sizeTableFilled;
+    bool m_sizeFiltered;
+
+    /*profiles are loaded into their own connector in the background and
+     * replace mp_connection when done, a file opened meanwhile waits in
+     * m_pendingFile until the running load stopped*/
+    Connector*              mp_loading;
+    Connector::loadProgress m_loadProgress;
+    QFutureWatcher<bool>*   mp_loadWatcher;
+    QTimer*                 mp_loadTimer;
+    QPushButton*            mp_cancelButton;
+    QString                 m_loadingFile;
+    QString                 m_pendingFile;
+    QString                 m_initialFilter;
+    loadMode                m_loadingMode;
+    loadMode                m_pendingMode;
+    /*state of an opened session, restored once its profile is loaded*/
+    SessionFile::content    m_sessionToRestore;
+    bool                    m_restoreSession;
+
+    /*profile the shown one is compared with and the join of both*/
+    BaselineWidget* mp_baseline;
+
+    /*the shown profile is reloaded when it is rewritten*/
+    QAction*        mp_watchProfile;
+    ProfileWatcher* mp_profileWatcher;
+    /*file as the loading profile was read*/
+    qint64          m_loadingSize;
+    QDateTime       m_loadingModified;
+
+    /*further profiles scored with the same filter*/
+    ProfileSession m_session;
+
+    /*state version and function shown by the heatmap, -1 for all functions*/
+    uint64_t m_heatmapVersion;
+    int      m_heatmapKey;
+
+    /*whether the size table shows the preview of the brush*/
+    bool m_sizePreviewShown;
+
+    /*selection at the last press into a checkbox column*/
+    QVector<int> m_pressedKeys;
+
+    /*save, save as and export of the filter*/
+    FilterSaver* mp_filterSaver;
 
     QString m_fileName;
-    QString m_filterFileName;
     QString m_windowTitle;
 
     /*functions*/
@@ -90,11 +234,42 @@ private:
     void
     updateTables();
 
+    void
+    updateSizeTable( const QVector<int>& rows );
+
+    void
+    requestSizes();
+
+    void
+    cancelSizes();
+
     void
     reset();
 
-    QString
-    seperate( int number );
+    void
+    updateColumnWidths( const QVector<dataCenter::groupData>& groups,
+                        const QVector<dataCenter::data>&      functions );
+
+    void
+    toggle( int  key,
+            bool groupTable );
+
+    /*switches all keys in one edit, current decides the new state*/
+    void
+    toggleKeys( QVector<int> keys,
+                int          current,
+                bool         groupTable );
+
+    QVector<int>
+    selectedKeys( bool groupTable );
+
+    void
+    selectKeys( const QVector<int>& keys,
+                int                 current,
+                bool                groupTable );
+
+    void
+    reportTime( const QString& what );
 
     void
     initTables();
@@ -102,11 +277,72 @@ private:
     void
     initMenu();
 
+    void
+    startFrontier();
+
+    void
+    startLoading( const QString& fileName,
+                  loadMode       mode = OPEN_PROFILE );
+
+    /*replaces the shown profile by its reloaded version, the filter
+     * without its history, the added profiles, the sort order and the
+     * search are kept*/
+    void
+    reloadFinished( Connector* connection );
+
+    /*shown profile and the profiles of the session side by side*/
+    void
+    updateProfileTable();
+
+    void
+    updateHeatmap();
+
+    /*key of the only selected function, -1 for none or several*/
+    int
+    selectedFunction();
+
+    void
+    updateRegionDetail();
+
+    void
+    updateFileTable();
+
+    void
+    restoreProgress();
+
+    void
+    applyFilter( const QString& fileName );
+
+    void
+    loadSession( const QString& fileName );
+
+    void
+    startBaseline( const QString& fileName );
+
+    /*takes the filter, sizes and history of the session without recalculation*/
+    void
+    restoreSession( const SessionFile::content& session );
+
+    void
+    startSorting( QSharedPointer<const dataCenter::functionSnapshot> functions );
+
+    void
+    applySort();
+
+    void
+    selectFunction( int key );
+
+    void
+    jumpToMatch( int afterRow );
+
     bool
     eventFilter( QObject* object,
                  QEvent*  event );
 
 private slots:
+    void
+    runBenchmark();
+
     /*slots for the buttons*/
     void
     openFile();
@@ -115,9 +351,94 @@ private slots:
     void
     saveFileAs();
     void
-    changeStateSlot( int pos );
+    loadFilter();
+    void
+    addProfile();
+    void
+    exportFilter();
+    void
+    filterSaved();
+    void
+    showTime( QString what,
+              qint64  milliseconds );
+    void
+    saveSession();
+    void
+    openSession();
+    void
+    compareProfile();
+    void
+    stopComparing();
+    void
+    diffChanged();
+    void
+    groupToggled( int key );
+    void
+    functionToggled( int key );
+    void
+    groupPressed( const QModelIndex& index );
+    void
+    functionPressed( const QModelIndex& index );
     void
     showShortcuts();
+    void
+    frontierFinished();
+    void
+    applyFrontierPoint( int index );
+    void
+    undoFilter();
+    void
+    redoFilter();
+    void
+    selectByRules();
+    void
+    startSizeCalculation();
+    void
+    sizesFinished();
+    void
+    sortingFinished();
+    void
+    headerClicked( int section );
+    void
+    loadFinished();
+    void
+    watchProfile( bool on );
+    void
+    profileRewritten( qint64    size,
+                      QDateTime modified );
+    void
+    showLoadProgress();
+    void
+    functionSelectionChanged();
+    void
+    functionTabChanged( int index );
+    /*extrapolates the profiles if the scaling tab is shown and they, the
+     * filter or the target changed*/
+    void
+    updateScaling();
+    /*one edit for the functions of all selected subtrees*/
+    void
+    changeSubtrees( bool exclude );
+    void
+    previewChanged();
+    void
+    changeBrushed( bool exclude );
+    /*adds the FILE_NAMES rules of the files tab*/
+    void
+    changeFiles( bool exclude );
+    void
+    cancelLoading();
+    void
+    searched();
+    void
+    showMatches();
+    void
+    nextMatch();
+    void
+    focusSearch();
+    /*one edit for all matches of the search*/
+    void
+    changeMatches( bool exclude );
 
     /*slots for tables
      * guarantees that you cant select rows in both tables*/
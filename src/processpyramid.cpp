@@ -0,0 +1,120 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#include "processpyramid.hpp"
+
+ProcessPyramid::ProcessPyramid()
+{
+}
+
+ProcessPyramid
+ProcessPyramid::build( const QVector<uint64_t>& values )
+{
+    ProcessPyramid pyramid;
+    pyramid.m_values = values;
+
+    /*every level pairs the blocks of the one below, an odd block stays alone*/
+    QVector<bucket> below;
+    below.resize( values.size() );
+    for ( int i = 0; i < values.size(); i++ )
+    {
+        below[ i ].min   = values[ i ];
+        below[ i ].max   = values[ i ];
+        below[ i ].sum   = values[ i ];
+        below[ i ].count = 1;
+    }
+    while ( below.size() > 1 )
+    {
+        QVector<bucket> level( ( below.size() + 1 ) / 2 );
+        for ( int i = 0; i < level.size(); i++ )
+        {
+            level[ i ] = below[ 2 * i ];
+            if ( 2 * i + 1 < below.size() )
+            {
+                merge( level[ i ], below[ 2 * i + 1 ] );
+            }
+        }
+        pyramid.m_levels.append( level );
+        below = level;
+    }
+    return pyramid;
+}
+
+int
+ProcessPyramid::size() const
+{
+    return m_values.size();
+}
+
+ProcessPyramid::bucket
+ProcessPyramid::range( int first, int last ) const
+{
+    bucket result;
+    result.min   = 0;
+    result.max   = 0;
+    result.sum   = 0;
+    result.count = 0;
+    first        = qMax( first, 0 );
+    last         = qMin( last, m_values.size() );
+    while ( first < last )
+    {
+        /*the largest block starting at first that ends before last*/
+        int level = 0;
+        while ( level < m_levels.size() &&
+                ( first & ( ( 2 << level ) - 1 ) ) == 0 &&
+                first + ( 2 << level ) <= last )
+        {
+            level++;
+        }
+        bucket part;
+        if ( level == 0 )
+        {
+            part.min   = m_values[ first ];
+            part.max   = m_values[ first ];
+            part.sum   = m_values[ first ];
+            part.count = 1;
+        }
+        else
+        {
+            part = m_levels[ level - 1 ][ first >> level ];
+        }
+        if ( result.count == 0 )
+        {
+            result = part;
+        }
+        else
+        {
+            merge( result, part );
+        }
+        first += 1 << level;
+    }
+    return result;
+}
+
+uint64_t
+ProcessPyramid::maxValue() const
+{
+    if ( m_levels.isEmpty() )
+    {
+        return m_values.isEmpty() ? 0 : m_values[ 0 ];
+    }
+    return m_levels.last()[ 0 ].max;
+}
+
+void
+ProcessPyramid::merge( bucket& into, const bucket& other )
+{
+    into.min    = qMin( into.min, other.min );
+    into.max    = qMax( into.max, other.max );
+    into.sum   += other.sum;
+    into.count += other.count;
+}
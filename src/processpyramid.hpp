@@ -0,0 +1,62 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#ifndef PROCESSPYRAMID_HPP
+#define PROCESSPYRAMID_HPP
+
+#include <stdint.h>
+#include <QtGlobal>
+#include <QVector>
+
+/*
+ * Minimum, maximum and sum of per process values for blocks of 2^k
+ * processes on every level k. Any range of processes is answered from
+ * O(log n) blocks, so a plot of a million processes only touches a few
+ * values per pixel.
+ */
+class ProcessPyramid
+{
+public:
+    struct bucket
+    {
+        uint64_t min;
+        uint64_t max;
+        double   sum;
+        int      count;
+    };
+
+    ProcessPyramid();
+
+    static ProcessPyramid
+    build( const QVector<uint64_t>& values );
+
+    int
+    size() const;
+    /*aggregate of the processes [first, last)*/
+    bucket
+    range( int first,
+           int last ) const;
+    /*largest value of all processes*/
+    uint64_t
+    maxValue() const;
+
+private:
+    QVector<uint64_t> m_values;
+    /*level k - 1 holds the blocks of 2^k processes*/
+    QVector<QVector<bucket> > m_levels;
+
+    static void
+    merge( bucket&       into,
+           const bucket& other );
+};
+
+#endif // PROCESSPYRAMID_HPP
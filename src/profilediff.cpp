@@ -0,0 +1,135 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#include <QHash>
+#include <QByteArray>
+
+#include "profilediff.hpp"
+#include "filtercompression.hpp"
+
+ProfileDiff::ProfileDiff() :
+    m_matchedNum( 0 ),
+    m_removedNum( 0 ),
+    m_removedMaxBuf( 0 )
+{
+}
+
+QSharedPointer<const ProfileDiff>
+ProfileDiff::compute( QSharedPointer<const dataCenter::functionSnapshot> functions,
+                      QSharedPointer<const dataCenter::functionSnapshot> baseline,
+                      QSharedPointer<const dataCenter::groupSnapshot>    baselineGroups )
+{
+    QSharedPointer<ProfileDiff>      diff( new ProfileDiff() );
+    const QVector<dataCenter::data>& rows = functions->rows;
+    const QVector<dataCenter::data>& old  = baseline->rows;
+    diff->m_baseline       = baseline;
+    diff->m_baselineGroups = baselineGroups;
+
+    /*build: id of every name, unmatched baseline keys of an id are
+     * head[ id ], next[ head[ id ] ], ...*/
+    QHash<QByteArray, int> ids;
+    ids.reserve( old.size() );
+    QVector<int> head;
+    QVector<int> tail;
+    QVector<int> next( old.size(), -1 );
+    for ( int key = 0; key < old.size(); key++ )
+    {
+        /*the snapshot outlives the hash, the keys need no copies*/
+        const std::string&                     name = FilterCompression::matchName( old[ key ] );
+        QByteArray                             b    = QByteArray::fromRawData( name.data(), ( int )name.size() );
+        QHash<QByteArray, int>::const_iterator it   = ids.constFind( b );
+        if ( it == ids.constEnd() )
+        {
+            ids.insert( b, head.size() );
+            head.append( key );
+            tail.append( key );
+        }
+        else
+        {
+            next[ tail[ it.value() ] ] = key;
+            tail[ it.value() ]         = key;
+        }
+    }
+
+    /*probe*/
+    QVector<bool> matched( old.size(), false );
+    diff->m_baselineKeys.fill( -1, rows.size() );
+    for ( int key = 0; key < rows.size(); key++ )
+    {
+        const std::string&                     name = FilterCompression::matchName( rows[ key ] );
+        QHash<QByteArray, int>::const_iterator it   = ids.constFind( QByteArray::fromRawData( name.data(), ( int )name.size() ) );
+        if ( it == ids.constEnd() || head[ it.value() ] < 0 )
+        {
+            continue;
+        }
+        int& first = head[ it.value() ];
+        diff->m_baselineKeys[ key ] = first;
+        matched[ first ]            = true;
+        first                       = next[ first ];
+        diff->m_matchedNum++;
+    }
+
+    for ( int key = 0; key < old.size(); key++ )
+    {
+        if ( !matched[ key ] )
+        {
+            diff->m_removedNum++;
+            diff->m_removedMaxBuf += old[ key ].maxBuf;
+        }
+    }
+    return diff;
+}
+
+const dataCenter::data*
+ProfileDiff::baselineFunction( int key ) const
+{
+    int old = m_baselineKeys.value( key, -1 );
+    return old < 0 ? 0 : &m_baseline->rows[ old ];
+}
+
+const dataCenter::groupData*
+ProfileDiff::baselineGroup( const std::string& type ) const
+{
+    /*a handful of groups, no index needed*/
+    for ( int i = 0; m_baselineGroups && i < m_baselineGroups->rows.size(); i++ )
+    {
+        if ( m_baselineGroups->rows[ i ].type == type )
+        {
+            return &m_baselineGroups->rows[ i ];
+        }
+    }
+    return 0;
+}
+
+int
+ProfileDiff::matchedNum() const
+{
+    return m_matchedNum;
+}
+
+int
+ProfileDiff::addedNum() const
+{
+    return m_baselineKeys.size() - m_matchedNum;
+}
+
+int
+ProfileDiff::removedNum() const
+{
+    return m_removedNum;
+}
+
+uint64_t
+ProfileDiff::removedMaxBuf() const
+{
+    return m_removedMaxBuf;
+}
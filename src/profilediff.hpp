@@ -0,0 +1,73 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#ifndef PROFILEDIFF_HPP
+#define PROFILEDIFF_HPP
+
+#include <QtGlobal>
+#include <QVector>
+#include <QSharedPointer>
+#include <stdint.h>
+
+#include "data.hpp"
+
+/*
+ * The shown profile joined to a baseline profile, e.g. the run before a
+ * change of the instrumentation. Functions are joined by the name the
+ * filter matches, groups by their type.
+ *
+ * The names of the baseline are interned into ids by a hash that only
+ * refers to the strings of the snapshot, the ids chain the baseline
+ * functions of every name. Each shown function probes the hash once and
+ * takes the next unmatched function of its name, so functions sharing a
+ * name are paired in the order of the profiles.
+ */
+class ProfileDiff
+{
+public:
+    ProfileDiff();
+
+    /*runs in a worker thread, the snapshots are only read*/
+    static QSharedPointer<const ProfileDiff>
+    compute( QSharedPointer<const dataCenter::functionSnapshot> functions,
+             QSharedPointer<const dataCenter::functionSnapshot> baseline,
+             QSharedPointer<const dataCenter::groupSnapshot>    baselineGroups );
+
+    /*0 if the baseline has no function of the same name*/
+    const dataCenter::data*
+    baselineFunction( int key ) const;
+    /*0 if the baseline has no group of this type, e.g. FLT*/
+    const dataCenter::groupData*
+    baselineGroup( const std::string& type ) const;
+
+    int
+    matchedNum() const;
+    /*shown functions without a baseline function*/
+    int
+    addedNum() const;
+    /*baseline functions without a shown function*/
+    int
+    removedNum() const;
+    uint64_t
+    removedMaxBuf() const;
+
+private:
+    QSharedPointer<const dataCenter::functionSnapshot> m_baseline;
+    QSharedPointer<const dataCenter::groupSnapshot>    m_baselineGroups;
+    /*baseline key of every shown key, -1 for none*/
+    QVector<int>                                       m_baselineKeys;
+    int                                                m_matchedNum;
+    int                                                m_removedNum;
+    uint64_t                                           m_removedMaxBuf;
+};
+
+#endif // PROFILEDIFF_HPP
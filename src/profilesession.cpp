@@ -0,0 +1,223 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#include <QHash>
+#include <QByteArray>
+
+#include "profilesession.hpp"
+#include "connector.hpp"
+#include "filtercompression.hpp"
+
+ProfileSession::ProfileSession()
+{
+}
+
+ProfileSession::~ProfileSession()
+{
+    clear();
+}
+
+void
+ProfileSession::clear()
+{
+    for ( int i = 0; i < m_profiles.size(); i++ )
+    {
+        delete m_profiles[ i ].connection;
+    }
+    m_profiles.clear();
+    m_applied = FilterState();
+}
+
+void
+ProfileSession::addProfile( const QString& fileName, Connector* connection,
+                            QSharedPointer<const dataCenter::functionSnapshot> functions,
+                            const FilterState& state )
+{
+    /*the profiles added before must be at state as well*/
+    update( state );
+
+    profile p;
+    p.fileName   = fileName;
+    p.connection = connection;
+    FilterFrontier::input                              in       = connection->getFrontierInput();
+    QSharedPointer<const dataCenter::functionSnapshot> snapshot = connection->getFunctionData();
+    const QVector<dataCenter::data>&                   own      = snapshot->rows;
+    const QVector<dataCenter::data>&                   rows     = functions->rows;
+    p.rows   = in.rows;
+    p.totals = in.processTotals;
+
+    /*functions of this profile by name, several may share one*/
+    QHash<QByteArray, int> byName;
+    QVector<int>           next( own.size(), -1 );
+    for ( int key = 0; key < own.size(); key++ )
+    {
+        const std::string&               name = FilterCompression::matchName( own[ key ] );
+        QByteArray                       b( name.data(), ( int )name.size() );
+        QHash<QByteArray, int>::iterator it = byName.find( b );
+        if ( it == byName.end() )
+        {
+            byName.insert( b, key );
+        }
+        else
+        {
+            next[ key ] = it.value();
+            it.value()  = key;
+        }
+    }
+    QVector<bool> matched( own.size(), false );
+    p.first.resize( rows.size() + 1 );
+    for ( int k = 0; k < rows.size(); k++ )
+    {
+        p.first[ k ] = p.keys.size();
+        const std::string&                     name = FilterCompression::matchName( rows[ k ] );
+        QHash<QByteArray, int>::const_iterator it   = byName.constFind( QByteArray::fromRawData( name.data(), ( int )name.size() ) );
+        for ( int key = it == byName.constEnd() ? -1 : it.value(); key >= 0; key = next[ key ] )
+        {
+            p.keys.append( key );
+            matched[ key ] = true;
+        }
+    }
+    p.first[ rows.size() ] = p.keys.size();
+
+    p.unmatchedNum    = 0;
+    p.unmatchedMaxBuf = 0;
+    for ( int key = 0; key < own.size(); key++ )
+    {
+        if ( !matched[ key ] )
+        {
+            p.unmatchedNum++;
+            p.unmatchedMaxBuf += own[ key ].maxBuf;
+        }
+    }
+    p.excludedBy.fill( 0, own.size() );
+    p.traceSize = 0;
+    for ( int i = 0; i < p.totals.size(); i++ )
+    {
+        p.traceSize += p.totals[ i ];
+    }
+    apply( &p, state.excludedKeys(), state );
+    m_profiles.append( p );
+    m_applied = state;
+}
+
+QVector<ProfileSession::source>
+ProfileSession::takeProfiles()
+{
+    QVector<source> sources( m_profiles.size() );
+    for ( int i = 0; i < m_profiles.size(); i++ )
+    {
+        sources[ i ].fileName   = m_profiles[ i ].fileName;
+        sources[ i ].connection = m_profiles[ i ].connection;
+    }
+    m_profiles.clear();
+    m_applied = FilterState();
+    return sources;
+}
+
+bool
+ProfileSession::update( const FilterState& state )
+{
+    if ( m_profiles.isEmpty() )
+    {
+        m_applied = state;
+        return false;
+    }
+    QVector<int> changed = state.changedKeys( m_applied );
+    m_applied = state;
+    if ( changed.isEmpty() )
+    {
+        return false;
+    }
+    for ( int i = 0; i < m_profiles.size(); i++ )
+    {
+        apply( &m_profiles[ i ], changed, state );
+    }
+    return true;
+}
+
+void
+ProfileSession::apply( profile* p, const QVector<int>& changed, const FilterState& state )
+{
+    for ( int i = 0; i < changed.size(); i++ )
+    {
+        bool excluded = state.isExcluded( changed[ i ] );
+        for ( int j = p->first[ changed[ i ] ]; j < p->first[ changed[ i ] + 1 ]; j++ )
+        {
+            /*only the first excluded and the last included name change the bytes*/
+            int& count = p->excludedBy[ p->keys[ j ] ];
+            count += excluded ? 1 : -1;
+            if ( count != ( excluded ? 1 : 0 ) )
+            {
+                continue;
+            }
+            const QVector<dataCenter::processBytes>& row = p->rows[ p->keys[ j ] ];
+            for ( int r = 0; r < row.size(); r++ )
+            {
+                if ( excluded )
+                {
+                    p->totals[ row[ r ].process ] -= row[ r ].bytes;
+                    p->traceSize                  -= row[ r ].bytes;
+                }
+                else
+                {
+                    p->totals[ row[ r ].process ] += row[ r ].bytes;
+                    p->traceSize                  += row[ r ].bytes;
+                }
+            }
+        }
+    }
+    p->maxBuf = 0;
+    for ( int i = 0; i < p->totals.size(); i++ )
+    {
+        p->maxBuf = qMax( p->maxBuf, p->totals[ i ] );
+    }
+}
+
+int
+ProfileSession::profileNum() const
+{
+    return m_profiles.size();
+}
+
+ProfileSession::summary
+ProfileSession::profileSummary( int index ) const
+{
+    const profile& p = m_profiles[ index ];
+    summary        s;
+    s.fileName             = p.fileName;
+    s.functionNum          = p.excludedBy.size();
+    s.unmatchedNum         = p.unmatchedNum;
+    s.unmatchedMaxBuf      = p.unmatchedMaxBuf;
+    s.sizes                = p.connection->getSizes();
+    s.filtered.traceSize   = p.traceSize;
+    s.filtered.maxBuf      = p.maxBuf;
+    s.filtered.totalMemory = p.connection->getTotalMemory( p.maxBuf );
+    return s;
+}
+
+Connector*
+ProfileSession::connection( int index ) const
+{
+    return m_profiles[ index ].connection;
+}
+
+uint64_t
+ProfileSession::worstTotalMemory( bool filtered ) const
+{
+    uint64_t worst = 0;
+    for ( int i = 0; i < m_profiles.size(); i++ )
+    {
+        summary s = profileSummary( i );
+        worst = qMax( worst, filtered ? s.filtered.totalMemory : s.sizes.totalMemory );
+    }
+    return worst;
+}
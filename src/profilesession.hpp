@@ -0,0 +1,120 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#ifndef PROFILESESSION_HPP
+#define PROFILESESSION_HPP
+
+#include <QtGlobal>
+#include <QVector>
+#include <QString>
+#include <QSharedPointer>
+#include <stdint.h>
+
+#include "data.hpp"
+#include "filterstate.hpp"
+
+class Connector;
+
+/*
+ * Further profiles of the same program scored with the filter of the
+ * profile shown in the tables. Their functions are matched to the shown
+ * ones by the name the filter matches, a function is filtered if any
+ * shown function of its name is excluded.
+ *
+ * Every profile keeps its filtered bytes per process. An update only
+ * visits the functions whose state changed since the previous one, found
+ * by comparing the chunks of the filter states.
+ */
+class ProfileSession
+{
+public:
+    struct summary
+    {
+        QString           fileName;
+        int               functionNum;
+        /*functions without a shown function of the same name, never filtered*/
+        int               unmatchedNum;
+        uint64_t          unmatchedMaxBuf;
+        dataCenter::sizes sizes;
+        dataCenter::sizes filtered;
+    };
+
+    struct source
+    {
+        QString    fileName;
+        Connector* connection;
+    };
+
+    ProfileSession();
+    ~ProfileSession();
+
+    /*deletes the connectors of the profiles*/
+    void
+    clear();
+    /*takes the loaded connection, matches its functions to functions and
+     * applies state*/
+    void
+    addProfile( const QString&                                     fileName,
+                Connector*                                         connection,
+                QSharedPointer<const dataCenter::functionSnapshot> functions,
+                const FilterState&                                 state );
+    /*removes the profiles without deleting their connectors, e.g. to add
+     * them again to the reloaded shown profile*/
+    QVector<source>
+    takeProfiles();
+    /*returns false if no profile changed*/
+    bool
+    update( const FilterState& state );
+
+    int
+    profileNum() const;
+    summary
+    profileSummary( int index ) const;
+    /*stays owned by the session*/
+    Connector*
+    connection( int index ) const;
+    /*largest SCOREP_TOTAL_MEMORY of all profiles, 0 without profiles*/
+    uint64_t
+    worstTotalMemory( bool filtered ) const;
+
+private:
+    struct profile
+    {
+        QString                                     fileName;
+        Connector*                                  connection;
+        /*keys of this profile for shown function k are
+         * keys[ first[ k ] ] to keys[ first[ k + 1 ] - 1 ]*/
+        QVector<int>                                first;
+        QVector<int>                                keys;
+        /*excluded shown functions per function of this profile*/
+        QVector<int>                                excludedBy;
+        QVector<QVector<dataCenter::processBytes> > rows;
+        QVector<uint64_t>                           totals;
+        uint64_t                                    traceSize;
+        uint64_t                                    maxBuf;
+        int                                         unmatchedNum;
+        uint64_t                                    unmatchedMaxBuf;
+    };
+
+    QVector<profile> m_profiles;
+    /*state of the last update*/
+    FilterState      m_applied;
+
+    static void
+    apply( profile*            p,
+           const QVector<int>& changed,
+           const FilterState&  state );
+
+    Q_DISABLE_COPY( ProfileSession )
+};
+
+#endif // PROFILESESSION_HPP
@@ -0,0 +1,111 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#include "profileswidget.hpp"
+
+#include <QFileInfo>
+
+namespace
+{
+QTableWidgetItem*
+numberItem( const QString& text )
+{
+    QTableWidgetItem* item = new QTableWidgetItem( text );
+    item->setTextAlignment( Qt::AlignRight | Qt::AlignVCenter );
+    return item;
+}
+}
+
+ProfilesWidget::ProfilesWidget( QWidget* parent )
+    : QWidget( parent )
+{
+    mp_table = new QTableWidget( 0, 6, this );
+    QStringList headers;
+    headers << "Profile" << "Regions" << "Unmatched" << "max_buf" << "max_buf with filter"
+            << "SCOREP_TOTAL_MEMORY with filter";
+    mp_table->setHorizontalHeaderLabels( headers );
+    mp_table->setEditTriggers( QAbstractItemView::NoEditTriggers );
+    mp_table->setSelectionMode( QAbstractItemView::NoSelection );
+    mp_table->verticalHeader()->hide();
+    mp_table->horizontalHeader()->setStretchLastSection( true );
+    mp_table->setColumnWidth( 0, 250 );
+    mp_label = new QLabel( this );
+
+    QVBoxLayout* layout = new QVBoxLayout( this );
+    layout->setContentsMargins( 0, 0, 0, 0 );
+    layout->addWidget( mp_table );
+    layout->addWidget( mp_label );
+    clear();
+}
+
+void
+ProfilesWidget::setProfiles( Connector* connection, const QString& fileName, ProfileSession& session )
+{
+    /*only the functions changed since the last update are visited*/
+    session.update( connection->getFilterState() );
+
+    QVector<ProfileSession::summary> profiles;
+    ProfileSession::summary          shown;
+    shown.fileName        = fileName;
+    shown.functionNum     = connection->getFunctionData()->rows.size();
+    shown.unmatchedNum    = 0;
+    shown.unmatchedMaxBuf = 0;
+    shown.sizes           = connection->getSizes();
+    shown.filtered        = connection->getFilteredSizes();
+    profiles.append( shown );
+    int worst = 0;
+    for ( int i = 0; i < session.profileNum(); i++ )
+    {
+        profiles.append( session.profileSummary( i ) );
+        if ( profiles.last().filtered.totalMemory > profiles[ worst ].filtered.totalMemory )
+        {
+            worst = profiles.size() - 1;
+        }
+    }
+
+    mp_table->setRowCount( profiles.size() );
+    for ( int row = 0; row < profiles.size(); row++ )
+    {
+        const ProfileSession::summary& p = profiles[ row ];
+        QTableWidgetItem*              items[ 6 ];
+        items[ 0 ] = new QTableWidgetItem( QFileInfo( p.fileName ).fileName() );
+        items[ 0 ]->setToolTip( p.fileName );
+        items[ 1 ] = numberItem( QString::number( p.functionNum ) );
+        items[ 2 ] = numberItem( row == 0 ? QString( "-" ) : QString::number( p.unmatchedNum ) );
+        items[ 2 ]->setToolTip( "regions without a region of the same name in the shown profile, "
+                                "never filtered: " + connection->getReadableByteNo( p.unmatchedMaxBuf ) );
+        items[ 3 ] = numberItem( connection->getReadableByteNo( p.sizes.maxBuf ) );
+        items[ 4 ] = numberItem( connection->getReadableByteNo( p.filtered.maxBuf ) );
+        items[ 5 ] = numberItem( connection->getReadableByteNo( p.filtered.totalMemory ) );
+        for ( int column = 0; column < 6; column++ )
+        {
+            QFont font = items[ column ]->font();
+            font.setBold( row == worst && profiles.size() > 1 );
+            items[ column ]->setFont( font );
+            mp_table->setItem( row, column, items[ column ] );
+        }
+    }
+    if ( profiles.size() > 1 )
+    {
+        mp_label->setText( QString( "SCOREP_TOTAL_MEMORY=%1 covers all %2 profiles, the worst is %3" )
+                           .arg( connection->getReadableByteNo( profiles[ worst ].filtered.totalMemory ) )
+                           .arg( profiles.size() )
+                           .arg( QFileInfo( profiles[ worst ].fileName ).fileName() ) );
+    }
+}
+
+void
+ProfilesWidget::clear()
+{
+    mp_table->setRowCount( 0 );
+    mp_label->setText( "File > Add profile scores further profiles with this filter" );
+}
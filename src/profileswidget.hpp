@@ -0,0 +1,49 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#ifndef PROFILESWIDGET_HPP
+#define PROFILESWIDGET_HPP
+
+#include <QWidget>
+#include <QLabel>
+#include <QTableWidget>
+#include <QHeaderView>
+#include <QVBoxLayout>
+
+#include "connector.hpp"
+#include "profilesession.hpp"
+
+/*
+ * Sizes of the shown profile and the profiles of the session with the
+ * shared filter. The profile with the largest SCOREP_TOTAL_MEMORY is
+ * bold, it decides the memory needed by all of them.
+ */
+class ProfilesWidget : public QWidget
+{
+public:
+    ProfilesWidget( QWidget* parent = 0 );
+
+    /*updates session to the state of connection, the profile shown as
+     * fileName, before the sizes are listed*/
+    void
+    setProfiles( Connector*      connection,
+                 const QString&  fileName,
+                 ProfileSession& session );
+    void
+    clear();
+
+private:
+    QTableWidget* mp_table;
+    QLabel*       mp_label;
+};
+
+#endif // PROFILESWIDGET_HPP
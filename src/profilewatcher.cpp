@@ -0,0 +1,119 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#include "profilewatcher.hpp"
+
+ProfileWatcher::ProfileWatcher( QObject* parent )
+    : QObject( parent )
+    , m_watching( false )
+    , m_size( -1 )
+    , m_changedSize( -1 )
+{
+    mp_watcher = new QFileSystemWatcher( this );
+    mp_timer   = new QTimer( this );
+    mp_timer->setSingleShot( true );
+    mp_timer->setInterval( 1000 );
+    connect( mp_watcher, SIGNAL( fileChanged( QString ) ), this, SLOT( changed() ) );
+    connect( mp_watcher, SIGNAL( directoryChanged( QString ) ), this, SLOT( changed() ) );
+    connect( mp_timer, SIGNAL( timeout() ), this, SLOT( check() ) );
+}
+
+void
+ProfileWatcher::setProfile( const QString& fileName, qint64 size, const QDateTime& modified )
+{
+    m_size     = size;
+    m_modified = modified;
+    if ( fileName != m_fileName )
+    {
+        m_fileName = fileName;
+        updatePaths();
+    }
+}
+
+void
+ProfileWatcher::setWatching( bool on )
+{
+    m_watching = on;
+    updatePaths();
+}
+
+bool
+ProfileWatcher::isWatching() const
+{
+    return m_watching && !m_fileName.isEmpty();
+}
+
+void
+ProfileWatcher::retry()
+{
+    mp_timer->start();
+}
+
+void
+ProfileWatcher::updatePaths()
+{
+    mp_timer->stop();
+    if ( !mp_watcher->files().isEmpty() )
+    {
+        mp_watcher->removePaths( mp_watcher->files() );
+    }
+    if ( !mp_watcher->directories().isEmpty() )
+    {
+        mp_watcher->removePaths( mp_watcher->directories() );
+    }
+    if ( !isWatching() )
+    {
+        return;
+    }
+    mp_watcher->addPath( m_fileName );
+    /*a file replaced by a rename is only noticed by its directory*/
+    mp_watcher->addPath( QFileInfo( m_fileName ).absolutePath() );
+}
+
+void
+ProfileWatcher::changed()
+{
+    /*check runs once the events stopped for a while*/
+    mp_timer->start();
+}
+
+void
+ProfileWatcher::check()
+{
+    if ( !isWatching() )
+    {
+        return;
+    }
+    QFileInfo profile( m_fileName );
+    if ( !profile.exists() )
+    {
+        /*removed before the new one is written, the directory reports it*/
+        return;
+    }
+    if ( !mp_watcher->files().contains( m_fileName ) )
+    {
+        mp_watcher->addPath( m_fileName );
+    }
+    if ( profile.size() == m_size && profile.lastModified() == m_modified )
+    {
+        return;
+    }
+    if ( profile.size() != m_changedSize || profile.lastModified() != m_changedModified )
+    {
+        /*still being written, a partial profile cannot be read*/
+        m_changedSize     = profile.size();
+        m_changedModified = profile.lastModified();
+        mp_timer->start();
+        return;
+    }
+    emit rewritten( m_changedSize, m_changedModified );
+}
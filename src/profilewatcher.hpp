@@ -0,0 +1,81 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#ifndef PROFILEWATCHER_HPP
+#define PROFILEWATCHER_HPP
+
+#include <QObject>
+#include <QString>
+#include <QDateTime>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QTimer>
+
+/*
+ * Notices when the shown profile is rewritten, e.g. by every run of a
+ * tuning campaign. A profile being written changes many times, a rewrite
+ * is reported once its size and time of modification stayed the same for
+ * a second.
+ */
+class ProfileWatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    ProfileWatcher( QObject* parent = 0 );
+
+    /*the profile with its size and time of modification as it was read,
+     * an empty fileName watches nothing*/
+    void
+    setProfile( const QString&   fileName,
+                qint64           size,
+                const QDateTime& modified );
+    void
+    setWatching( bool on );
+    bool
+    isWatching() const;
+    /*checks again after the interval, e.g. if the rewrite cannot be
+     * loaded yet*/
+    void
+    retry();
+
+public slots:
+    /*reports a rewrite since the profile was read, also one from before
+     * watching started*/
+    void
+    check();
+
+signals:
+    void
+    rewritten( qint64    size,
+               QDateTime modified );
+
+private slots:
+    void
+    changed();
+
+private:
+    QFileSystemWatcher* mp_watcher;
+    QTimer*             mp_timer;
+    bool                m_watching;
+    QString             m_fileName;
+    /*file as it was read and as last seen*/
+    qint64              m_size;
+    QDateTime           m_modified;
+    qint64              m_changedSize;
+    QDateTime           m_changedModified;
+
+    void
+    updatePaths();
+};
+
+#endif // PROFILEWATCHER_HPP
@@ -0,0 +1,219 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#include "regiondetailwidget.hpp"
+
+namespace
+{
+QString
+readable( double bytes )
+{
+    const char* units[] = { "B", "kB", "MB", "GB", "TB" };
+    int         unit    = 0;
+    while ( bytes >= 1024 && unit < 4 )
+    {
+        bytes /= 1024;
+        unit++;
+    }
+    return QString::number( bytes, 'f', unit == 0 ? 0 : 1 ) + units[ unit ];
+}
+
+QString
+ratio( double max, double mean )
+{
+    return mean > 0 ? QString::number( max / mean, 'f', 2 ) : QString( "-" );
+}
+
+QTableWidgetItem*
+numberItem( const QString& text )
+{
+    QTableWidgetItem* item = new QTableWidgetItem( text );
+    item->setTextAlignment( Qt::AlignRight | Qt::AlignVCenter );
+    item->setFlags( Qt::ItemIsEnabled | Qt::ItemIsSelectable );
+    return item;
+}
+}
+
+RegionDetailWidget::RegionDetailWidget( QWidget* parent )
+    : QWidget( parent )
+    , mp_connection( 0 )
+    , m_generation( 0 )
+    , m_pending( false )
+    , m_key( -1 )
+{
+    QVBoxLayout* layout = new QVBoxLayout( this );
+    layout->setContentsMargins( 0, 0, 0, 0 );
+    mp_name    = new QLabel( this );
+    mp_summary = new QLabel( this );
+    mp_maxBuf  = new QLabel( this );
+    mp_top     = new QTableWidget( 0, 4, this );
+    QFont bold = mp_name->font();
+    bold.setBold( true );
+    mp_name->setFont( bold );
+    mp_name->setTextFormat( Qt::PlainText );
+    mp_name->setWordWrap( true );
+    mp_summary->setWordWrap( true );
+    mp_maxBuf->setWordWrap( true );
+    mp_top->setHorizontalHeaderLabels( QStringList() << "process" << "visits" << "bytes" << "time (s)" );
+    mp_top->verticalHeader()->hide();
+    mp_top->setEditTriggers( QAbstractItemView::NoEditTriggers );
+    mp_top->horizontalHeader()->setStretchLastSection( true );
+    layout->addWidget( mp_name );
+    layout->addWidget( mp_summary );
+    layout->addWidget( mp_maxBuf );
+    layout->addWidget( mp_top, 1 );
+    setFixedWidth( 330 );
+    clear();
+
+    mp_watcher = new QFutureWatcher<Connector::regionDetail>( this );
+    connect( mp_watcher, SIGNAL( finished() ), this, SLOT( detailFinished() ) );
+}
+
+void
+RegionDetailWidget::showRegion( Connector* connection, int key )
+{
+    mp_connection = connection;
+    if ( key == m_key )
+    {
+        /*the filter may have moved max_buf to another process*/
+        showMaxBufProcess();
+        return;
+    }
+    m_key = key;
+    m_generation.fetchAndAddRelaxed( 1 );
+    if ( key < 0 )
+    {
+        m_pending = false;
+        clear();
+        return;
+    }
+    clear( "reading the processes of " +
+           QString::fromStdString( connection->getFunctionData()->rows[ key ].region ) + "..." );
+    showMaxBufProcess();
+    startDetail();
+}
+
+void
+RegionDetailWidget::startDetail()
+{
+    if ( mp_watcher->isRunning() )
+    {
+        /*the running read notices it is outdated and stops early*/
+        m_pending = true;
+        return;
+    }
+    if ( m_key < 0 )
+    {
+        return;
+    }
+    mp_watcher->setFuture( QtConcurrent::run( &Connector::computeRegionDetail,
+                                              mp_connection->getDetailRequest( m_key, 10, &m_generation ) ) );
+}
+
+void
+RegionDetailWidget::detailFinished()
+{
+    Connector::regionDetail result = mp_watcher->result();
+    if ( m_pending )
+    {
+        m_pending = false;
+        startDetail();
+        return;
+    }
+    if ( result.cancelled || result.generation != m_generation.fetchAndAddRelaxed( 0 ) )
+    {
+        return;
+    }
+    setDetail( result, QString::fromStdString( mp_connection->getFunctionData()->rows[ result.key ].region ) );
+    showMaxBufProcess();
+}
+
+void
+RegionDetailWidget::cancel()
+{
+    /*the read uses the profile of the current connector*/
+    m_generation.fetchAndAddRelaxed( 1 );
+    m_pending = false;
+    m_key     = -1;
+    mp_watcher->waitForFinished();
+}
+
+void
+RegionDetailWidget::setDetail( const Connector::regionDetail& detail, const QString& name )
+{
+    mp_name->setText( name );
+    mp_summary->setText( QString( "visited by %1 of %2 processes"
+                                  "<table cellspacing=4>"
+                                  "<tr><th></th><th align=right>max</th><th align=right>mean</th>"
+                                  "<th align=right>max/mean</th></tr>"
+                                  "<tr><td>visits</td><td align=right>%3</td><td align=right>%4</td><td align=right>%5</td></tr>"
+                                  "<tr><td>bytes</td><td align=right>%6</td><td align=right>%7</td><td align=right>%8</td></tr>"
+                                  "<tr><td>time (s)</td><td align=right>%9</td><td align=right>%10</td><td align=right>%11</td></tr>"
+                                  "</table>" )
+                         .arg( detail.visitingNum )
+                         .arg( detail.processNum )
+                         .arg( detail.maxVisits )
+                         .arg( detail.meanVisits, 0, 'f', 1 )
+                         .arg( ratio( detail.maxVisits, detail.meanVisits ) )
+                         .arg( readable( detail.maxBytes ) )
+                         .arg( readable( detail.meanBytes ) )
+                         .arg( ratio( detail.maxBytes, detail.meanBytes ) )
+                         .arg( detail.maxTime, 0, 'f', 3 )
+                         .arg( detail.meanTime, 0, 'f', 3 )
+                         .arg( ratio( detail.maxTime, detail.meanTime ) ) );
+
+    mp_top->setRowCount( detail.top.size() );
+    for ( int i = 0; i < detail.top.size(); i++ )
+    {
+        const dataCenter::regionProcess& p = detail.top[ i ];
+        mp_top->setItem( i, 0, numberItem( QString::number( p.process ) ) );
+        mp_top->setItem( i, 1, numberItem( QString::number( p.visits ) ) );
+        mp_top->setItem( i, 2, numberItem( readable( p.bytes ) ) );
+        mp_top->setItem( i, 3, numberItem( QString::number( p.time, 'f', 3 ) ) );
+    }
+    mp_top->show();
+}
+
+void
+RegionDetailWidget::showMaxBufProcess()
+{
+    int      process;
+    uint64_t total;
+    uint64_t bytes;
+    if ( m_key < 0 )
+    {
+        return;
+    }
+    if ( !mp_connection->getMaxBufProcess( m_key, &process, &total, &bytes ) )
+    {
+        /*the heatmap already requested the filtered totals*/
+        mp_maxBuf->setText( "max_buf process: calculating..." );
+        return;
+    }
+    double share = total > 0 ? 100.0 * bytes / total : 0;
+    mp_maxBuf->setText( QString( "max_buf%1 is reached on process %2 (%3), this region writes %4 (%5%) of it" )
+                        .arg( mp_connection->hasFiltered() ? " with filter" : "" )
+                        .arg( process )
+                        .arg( readable( total ) )
+                        .arg( readable( bytes ) )
+                        .arg( share, 0, 'f', 1 ) );
+}
+
+void
+RegionDetailWidget::clear( const QString& message )
+{
+    mp_name->clear();
+    mp_summary->setText( message.isEmpty() ? QString( "Select a single region to see its processes" ) : message );
+    mp_maxBuf->clear();
+    mp_top->setRowCount( 0 );
+    mp_top->hide();
+}
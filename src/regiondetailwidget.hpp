@@ -0,0 +1,80 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#ifndef REGIONDETAILWIDGET_HPP
+#define REGIONDETAILWIDGET_HPP
+
+#include <QWidget>
+#include <QLabel>
+#include <QTableWidget>
+#include <QHeaderView>
+#include <QVBoxLayout>
+#include <QAtomicInt>
+#include <QFutureWatcher>
+#include <QtConcurrentRun>
+
+#include "connector.hpp"
+
+/*
+ * Per process distribution of one region: maximum, mean and imbalance of
+ * visits, bytes and time, the process defining max_buf and the processes
+ * writing the most bytes. The processes are read from the profile in the
+ * background, at most one read runs at a time since the profile is
+ * shared, a newer region supersedes it through the generation.
+ */
+class RegionDetailWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    RegionDetailWidget( QWidget* parent = 0 );
+
+    /*shows the function key of connection, -1 for none, connection must
+     * stay until cancel()*/
+    void
+    showRegion( Connector* connection,
+                int        key );
+    /*stops the read, to be called before the connector is deleted*/
+    void
+    cancel();
+    void
+    clear( const QString& message = QString() );
+
+private slots:
+    void
+    detailFinished();
+
+private:
+    Connector*                               mp_connection;
+    QFutureWatcher<Connector::regionDetail>* mp_watcher;
+    QAtomicInt                               m_generation;
+    bool                                     m_pending;
+    int                                      m_key;
+
+    /*plain text, region names may contain markup characters*/
+    QLabel*       mp_name;
+    QLabel*       mp_summary;
+    QLabel*       mp_maxBuf;
+    QTableWidget* mp_top;
+
+    void
+    startDetail();
+    void
+    setDetail( const Connector::regionDetail& detail,
+               const QString&                 name );
+    /*the process defining max_buf, or calculating while the connector
+     * has no filtered totals*/
+    void
+    showMaxBufProcess();
+};
+
+#endif // REGIONDETAILWIDGET_HPP
@@ -0,0 +1,201 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#include <QHash>
+#include <QRegExp>
+
+#include "regionselection.hpp"
+
+namespace
+{
+int
+encode( const QString& value, QHash<QString, int>& codes, QStringList& dictionary )
+{
+    QHash<QString, int>::const_iterator it = codes.constFind( value );
+    if ( it != codes.constEnd() )
+    {
+        return it.value();
+    }
+    int code = dictionary.size();
+    codes.insert( value, code );
+    dictionary.append( value );
+    return code;
+}
+
+/*plain loops over raw arrays, simple enough for the compiler to vectorize*/
+void
+scanNumeric( const QVector<double>& values, RegionSelection::comparison op, double value, uchar* mask )
+{
+    const double* data = values.constData();
+    int           size = values.size();
+    if ( op == RegionSelection::LESS )
+    {
+        for ( int i = 0; i < size; i++ )
+        {
+            mask[ i ] &= data[ i ] < value;
+        }
+    }
+    else
+    {
+        for ( int i = 0; i < size; i++ )
+        {
+            mask[ i ] &= data[ i ] > value;
+        }
+    }
+}
+
+void
+scanDictionary( const QVector<int>& codes, const QStringList& dictionary, const QRegExp& pattern,
+                bool expected, uchar* mask )
+{
+    /*match every distinct value once, then gather*/
+    QVector<uchar> hit( dictionary.size() );
+    for ( int i = 0; i < dictionary.size(); i++ )
+    {
+        hit[ i ] = pattern.exactMatch( dictionary[ i ] ) == expected;
+    }
+    const int*   data = codes.constData();
+    const uchar* hits = hit.constData();
+    int          size = codes.size();
+    for ( int i = 0; i < size; i++ )
+    {
+        mask[ i ] &= hits[ data[ i ] ];
+    }
+}
+}
+
+RegionSelection::columns
+RegionSelection::build( const QVector<dataCenter::data>& rows )
+{
+    columns             table;
+    QHash<QString, int> typeCodes;
+    QHash<QString, int> fileCodes;
+    table.visits.resize( rows.size() );
+    table.maxBuf.resize( rows.size() );
+    table.time.resize( rows.size() );
+    table.timePerVisit.resize( rows.size() );
+    table.type.resize( rows.size() );
+    table.file.resize( rows.size() );
+    for ( int i = 0; i < rows.size(); i++ )
+    {
+        const dataCenter::data& row = rows[ i ];
+        table.visits[ i ]       = row.visits;
+        table.maxBuf[ i ]       = row.maxBuf;
+        table.time[ i ]         = row.timeS;
+        table.timePerVisit[ i ] = row.timePerVisit;
+        table.names.append( QString::fromStdString( row.region ) );
+        table.type[ i ] = encode( QString::fromStdString( row.type ), typeCodes, table.types );
+        table.file[ i ] = encode( QString::fromStdString( row.fileName ), fileCodes, table.files );
+    }
+    return table;
+}
+
+QVector<int>
+RegionSelection::evaluate( const columns& table, const QList<rule>& rules )
+{
+    int            size = table.type.size();
+    QVector<uchar> mask( size, 1 );
+    for ( int r = 0; r < rules.size(); r++ )
+    {
+        const rule& current = rules[ r ];
+        if ( isNumeric( current.col ) )
+        {
+            if ( current.op != LESS && current.op != GREATER )
+            {
+                continue;
+            }
+            const QVector<double>* values = &table.visits;
+            switch ( current.col )
+            {
+                case MAX_BUF:
+                    values = &table.maxBuf;
+                    break;
+                case TIME:
+                    values = &table.time;
+                    break;
+                case TIME_PER_VISIT:
+                    values = &table.timePerVisit;
+                    break;
+                default:
+                    break;
+            }
+            scanNumeric( *values, current.op, current.value, mask.data() );
+            continue;
+        }
+
+        if ( current.op != MATCHES && current.op != NOT_MATCHES )
+        {
+            continue;
+        }
+        QRegExp pattern( current.pattern, Qt::CaseSensitive, QRegExp::Wildcard );
+        bool    expected = current.op == MATCHES;
+        if ( current.col == TYPE )
+        {
+            scanDictionary( table.type, table.types, pattern, expected, mask.data() );
+        }
+        else if ( current.col == FILE_NAME )
+        {
+            scanDictionary( table.file, table.files, pattern, expected, mask.data() );
+        }
+        else
+        {
+            /*names are mostly unique, only test rows that are still selected*/
+            for ( int i = 0; i < size; i++ )
+            {
+                if ( mask[ i ] )
+                {
+                    mask[ i ] = pattern.exactMatch( table.names[ i ] ) == expected;
+                }
+            }
+        }
+    }
+
+    QVector<int> keys;
+    for ( int i = 0; i < size; i++ )
+    {
+        if ( mask[ i ] )
+        {
+            keys.append( i );
+        }
+    }
+    return keys;
+}
+
+bool
+RegionSelection::isNumeric( column col )
+{
+    return col == VISITS || col == MAX_BUF || col == TIME || col == TIME_PER_VISIT;
+}
+
+QString
+RegionSelection::columnName( column col )
+{
+    switch ( col )
+    {
+        case TYPE:
+            return "type";
+        case VISITS:
+            return "visits";
+        case MAX_BUF:
+            return "max_buff[B]";
+        case TIME:
+            return "time[s]";
+        case TIME_PER_VISIT:
+            return "time/visit[us]";
+        case NAME:
+            return "region";
+        case FILE_NAME:
+            return "file";
+        default:
+            return QString();
+    }
+}
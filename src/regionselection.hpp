@@ -0,0 +1,73 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#ifndef REGIONSELECTION_HPP
+#define REGIONSELECTION_HPP
+
+#include <QtGlobal>
+#include <QVector>
+#include <QList>
+#include <QStringList>
+
+#include "data.hpp"
+
+/*
+ * Selects regions by rules over the columns of the region table.
+ * The table is stored column wise, every rule is one scan over a single
+ * column. Text columns with few distinct values (type, file) are
+ * dictionary encoded, so a pattern is matched once per distinct value.
+ */
+class RegionSelection
+{
+public:
+    enum column { TYPE, VISITS, MAX_BUF, TIME, TIME_PER_VISIT, NAME, FILE_NAME, COLUMN_NUM };
+    enum comparison { LESS, GREATER, MATCHES, NOT_MATCHES };
+
+    struct rule
+    {
+        column     col;
+        comparison op;
+        /*used by LESS and GREATER*/
+        double     value;
+        /*wildcard pattern, used by MATCHES and NOT_MATCHES*/
+        QString    pattern;
+    };
+
+    struct columns
+    {
+        QVector<double> visits;
+        QVector<double> maxBuf;
+        QVector<double> time;
+        QVector<double> timePerVisit;
+        QStringList     names;
+        /*index into types and files*/
+        QVector<int>    type;
+        QStringList     types;
+        QVector<int>    file;
+        QStringList     files;
+    };
+
+    static columns
+    build( const QVector<dataCenter::data>& rows );
+
+    /*keys of the rows matching all rules*/
+    static QVector<int>
+    evaluate( const columns&     table,
+              const QList<rule>& rules );
+
+    static bool
+    isNumeric( column col );
+    static QString
+    columnName( column col );
+};
+
+#endif // REGIONSELECTION_HPP
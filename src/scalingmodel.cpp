@@ -0,0 +1,365 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#include <QHash>
+#include <QByteArray>
+#include <algorithm>
+#include <cmath>
+
+#include "scalingmodel.hpp"
+#include "filtercompression.hpp"
+
+namespace
+{
+/*a model with two parameters has to lower the error of the constant by
+ * MIN_GAIN, models closer than SAME_ERROR fit equally well*/
+const double MIN_GAIN   = 0.01;
+const double SAME_ERROR = 0.001;
+/*share of the target max_buf from which a growing region dominates*/
+const double DOMINANT_SHARE = 0.1;
+/*two points are met exactly by every model with two parameters, the
+ * fit error only tells them apart from a third one on*/
+const int MIN_PROCESS_COUNTS = 3;
+
+/*one region in all profiles, indexed like the profiles*/
+struct series
+{
+    std::string     name;
+    std::string     type;
+    bool            excluded;
+    QVector<double> visits;
+    QVector<double> maxBuf;
+    QVector<double> bytes;
+};
+
+/*least squares of y = a + b * x, false if x has a single value*/
+bool
+leastSquares( const QVector<double>& x, const QVector<double>& y, double* a, double* b )
+{
+    int n = x.size();
+    if ( n < 2 )
+    {
+        return false;
+    }
+    double mx = 0;
+    double my = 0;
+    for ( int i = 0; i < n; i++ )
+    {
+        mx += x[ i ];
+        my += y[ i ];
+    }
+    mx /= n;
+    my /= n;
+    double sxx = 0;
+    double sxy = 0;
+    for ( int i = 0; i < n; i++ )
+    {
+        sxx += ( x[ i ] - mx ) * ( x[ i ] - mx );
+        sxy += ( x[ i ] - mx ) * ( y[ i ] - my );
+    }
+    if ( sxx <= 1e-12 * ( mx * mx + 1 ) )
+    {
+        return false;
+    }
+    *b = sxy / sxx;
+    *a = my - *b * mx;
+    return true;
+}
+
+double
+fitError( const ScalingModel::fit& f, const QVector<double>& processNums, const QVector<double>& y )
+{
+    double sum = 0;
+    for ( int i = 0; i < y.size(); i++ )
+    {
+        double residual = ( y[ i ] - ScalingModel::predict( f, processNums[ i ] ) ) / qMax( y[ i ], 1.0 );
+        sum += residual * residual;
+    }
+    return std::sqrt( sum / y.size() );
+}
+
+ScalingModel::fit
+fitSeries( const QVector<double>& processNums, const QVector<double>& y, double target )
+{
+    int               n = y.size();
+    ScalingModel::fit models[ ScalingModel::KIND_NUM ];
+    bool              valid[ ScalingModel::KIND_NUM ];
+    for ( int m = 0; m < ScalingModel::KIND_NUM; m++ )
+    {
+        models[ m ].model = ( ScalingModel::kind )m;
+        models[ m ].a     = 0;
+        models[ m ].b     = 0;
+    }
+
+    double mean = 0;
+    for ( int i = 0; i < n; i++ )
+    {
+        mean += y[ i ];
+    }
+    models[ ScalingModel::CONSTANT ].a = n > 0 ? mean / n : 0;
+    valid[ ScalingModel::CONSTANT ]    = true;
+
+    QVector<double> logs( n );
+    for ( int i = 0; i < n; i++ )
+    {
+        logs[ i ] = std::log( processNums[ i ] );
+    }
+    valid[ ScalingModel::LINEAR ] = leastSquares( processNums, y, &models[ ScalingModel::LINEAR ].a,
+                                                  &models[ ScalingModel::LINEAR ].b );
+    valid[ ScalingModel::LOGARITHMIC ] = leastSquares( logs, y, &models[ ScalingModel::LOGARITHMIC ].a,
+                                                       &models[ ScalingModel::LOGARITHMIC ].b );
+    /*fitted as a line in log-log, only the runs with visits take part*/
+    QVector<double> px;
+    QVector<double> py;
+    for ( int i = 0; i < n; i++ )
+    {
+        if ( y[ i ] > 0 )
+        {
+            px.append( logs[ i ] );
+            py.append( std::log( y[ i ] ) );
+        }
+    }
+    double logA = 0;
+    valid[ ScalingModel::POWER_LAW ] = leastSquares( px, py, &logA, &models[ ScalingModel::POWER_LAW ].b );
+    models[ ScalingModel::POWER_LAW ].a = std::exp( logA );
+
+    int best = ScalingModel::CONSTANT;
+    for ( int m = 0; m < ScalingModel::KIND_NUM; m++ )
+    {
+        if ( valid[ m ] )
+        {
+            models[ m ].error = fitError( models[ m ], processNums, y );
+        }
+    }
+    for ( int m = ScalingModel::LINEAR; m < ScalingModel::KIND_NUM; m++ )
+    {
+        if ( !valid[ m ] || models[ m ].error > models[ ScalingModel::CONSTANT ].error - MIN_GAIN )
+        {
+            continue;
+        }
+        if ( best == ScalingModel::CONSTANT || models[ m ].error < models[ best ].error - SAME_ERROR ||
+             ( models[ m ].error <= models[ best ].error + SAME_ERROR &&
+               ScalingModel::predict( models[ m ], target ) > ScalingModel::predict( models[ best ], target ) * ( 1 + SAME_ERROR ) ) )
+        {
+            best = m;
+        }
+    }
+    return models[ best ];
+}
+
+/*predictions of a power law may exceed every byte count*/
+uint64_t
+toBytes( double value )
+{
+    return value >= 1.8e19 ? Q_UINT64_C( 18000000000000000000 ) : ( uint64_t )value;
+}
+
+bool
+largerTarget( const ScalingModel::region& a, const ScalingModel::region& b )
+{
+    return a.targetMaxBuf > b.targetMaxBuf;
+}
+}
+
+ScalingModel::result
+ScalingModel::compute( QVector<profile> profiles, FilterState state, int targetProcessNum )
+{
+    result r;
+    r.targetProcessNum     = targetProcessNum;
+    r.dominantNum          = 0;
+    r.measured.traceSize   = 0;
+    r.measured.maxBuf      = 0;
+    r.measured.totalMemory = 0;
+    r.target               = r.measured;
+    r.targetFiltered       = r.measured;
+    r.targetFitted         = r.measured;
+    r.traceSize.model      = CONSTANT;
+    r.traceSize.a          = 0;
+    r.traceSize.b          = 0;
+    r.traceSize.error      = 0;
+    r.maxBuf               = r.traceSize;
+    for ( int k = 0; k < profiles.size(); k++ )
+    {
+        r.processNums.append( profiles[ k ].processNum );
+    }
+    std::sort( r.processNums.begin(), r.processNums.end() );
+    int distinct = 0;
+    for ( int k = 0; k < r.processNums.size(); k++ )
+    {
+        if ( k == 0 || r.processNums[ k ] != r.processNums[ k - 1 ] )
+        {
+            distinct++;
+        }
+    }
+    if ( distinct < MIN_PROCESS_COUNTS )
+    {
+        r.error = QString( "Profiles of at least %1 process counts are needed" ).arg( MIN_PROCESS_COUNTS );
+        return r;
+    }
+
+    /*regions by name, the keys refer to the strings of the snapshots*/
+    int                    n       = profiles.size();
+    int                    largest = 0;
+    QVector<double>        processNums( n );
+    QVector<double>        traceSizes( n );
+    QVector<double>        maxBufs( n );
+    QHash<QByteArray, int> ids;
+    QVector<series>        regions;
+    for ( int k = 0; k < n; k++ )
+    {
+        const profile&                   p    = profiles[ k ];
+        const QVector<dataCenter::data>& rows = p.functions->rows;
+        processNums[ k ] = p.processNum;
+        if ( p.processNum > profiles[ largest ].processNum )
+        {
+            largest = k;
+        }
+        QVector<uint64_t> totals( p.processNum, 0 );
+        for ( int key = 0; key < rows.size(); key++ )
+        {
+            const std::string&                     name = FilterCompression::matchName( rows[ key ] );
+            QByteArray                             b    = QByteArray::fromRawData( name.data(), ( int )name.size() );
+            QHash<QByteArray, int>::const_iterator it   = ids.constFind( b );
+            int                                    id   = it == ids.constEnd() ? regions.size() : it.value();
+            if ( id == regions.size() )
+            {
+                series s;
+                s.name     = name;
+                s.type     = rows[ key ].type;
+                s.excluded = false;
+                s.visits.fill( 0, n );
+                s.maxBuf.fill( 0, n );
+                s.bytes.fill( 0, n );
+                ids.insert( b, id );
+                regions.append( s );
+            }
+            series& s = regions[ id ];
+            /*filtered if any function of its name is excluded*/
+            s.excluded     = s.excluded || ( k == 0 && key < state.functionNum() && state.isExcluded( key ) );
+            s.visits[ k ] += rows[ key ].visits;
+            s.maxBuf[ k ] += rows[ key ].maxBuf;
+            const QVector<dataCenter::processBytes>& bytes = p.rows.value( key );
+            for ( int i = 0; i < bytes.size(); i++ )
+            {
+                s.bytes[ k ]                 += bytes[ i ].bytes;
+                totals[ bytes[ i ].process ] += bytes[ i ].bytes;
+            }
+        }
+        traceSizes[ k ] = 0;
+        maxBufs[ k ]    = 0;
+        for ( int i = 0; i < totals.size(); i++ )
+        {
+            traceSizes[ k ] += totals[ i ];
+            maxBufs[ k ]     = qMax( maxBufs[ k ], ( double )totals[ i ] );
+        }
+    }
+    r.measured.traceSize     = toBytes( traceSizes[ largest ] );
+    r.measured.maxBuf        = toBytes( maxBufs[ largest ] );
+    r.traceSize              = fitSeries( processNums, traceSizes, targetProcessNum );
+    r.maxBuf                 = fitSeries( processNums, maxBufs, targetProcessNum );
+    r.targetFitted.traceSize = toBytes( predict( r.traceSize, targetProcessNum ) );
+    r.targetFitted.maxBuf    = toBytes( predict( r.maxBuf, targetProcessNum ) );
+
+    double measuredSum = 0;
+    double targetSum   = 0;
+    r.regions.resize( regions.size() );
+    for ( int i = 0; i < regions.size(); i++ )
+    {
+        const series& s = regions[ i ];
+        region&       g = r.regions[ i ];
+        g.name     = s.name;
+        g.type     = s.type;
+        g.excluded = s.excluded;
+        g.visits   = fitSeries( processNums, s.visits, targetProcessNum );
+        g.maxBuf   = fitSeries( processNums, s.maxBuf, targetProcessNum );
+        /*bytes per visit over all runs*/
+        double visits = 0;
+        double bytes  = 0;
+        for ( int k = 0; k < n; k++ )
+        {
+            visits += s.visits[ k ];
+            bytes  += s.bytes[ k ];
+        }
+        g.targetVisits    = predict( g.visits, targetProcessNum );
+        g.targetTraceSize = toBytes( visits > 0 ? g.targetVisits * bytes / visits : 0 );
+        g.targetMaxBuf    = toBytes( predict( g.maxBuf, targetProcessNum ) );
+        g.measuredMaxBuf  = toBytes( s.maxBuf[ largest ] );
+        measuredSum      += g.measuredMaxBuf;
+        targetSum        += g.targetMaxBuf;
+        r.target.traceSize += g.targetTraceSize;
+        if ( !g.excluded )
+        {
+            r.targetFiltered.traceSize += g.targetTraceSize;
+        }
+    }
+
+    /*the regions peak on different processes, their sum overestimates max_buf*/
+    double overlap        = measuredSum > 0 ? maxBufs[ largest ] / measuredSum : 1;
+    double targetFiltered = 0;
+    for ( int i = 0; i < r.regions.size(); i++ )
+    {
+        region& g = r.regions[ i ];
+        g.measuredShare = measuredSum > 0 ? g.measuredMaxBuf / measuredSum : 0;
+        g.targetShare   = targetSum > 0 ? g.targetMaxBuf / targetSum : 0;
+        g.dominant      = g.targetShare >= DOMINANT_SHARE && g.targetShare > g.measuredShare;
+        if ( g.dominant )
+        {
+            r.dominantNum++;
+        }
+        if ( !g.excluded )
+        {
+            targetFiltered += g.targetMaxBuf;
+        }
+    }
+    r.target.maxBuf         = toBytes( targetSum * overlap );
+    r.targetFiltered.maxBuf = toBytes( targetFiltered * overlap );
+    std::stable_sort( r.regions.begin(), r.regions.end(), largerTarget );
+    return r;
+}
+
+double
+ScalingModel::predict( const fit& f, double processNum )
+{
+    double value = f.a;
+    switch ( f.model )
+    {
+        case LINEAR:
+            value = f.a + f.b * processNum;
+            break;
+        case LOGARITHMIC:
+            value = f.a + f.b * std::log( processNum );
+            break;
+        case POWER_LAW:
+            value = f.a * std::pow( processNum, f.b );
+            break;
+        default:
+            break;
+    }
+    /*a falling line ends at zero*/
+    return qMax( value, 0.0 );
+}
+
+QString
+ScalingModel::modelName( kind model )
+{
+    switch ( model )
+    {
+        case LINEAR:
+            return "linear";
+        case LOGARITHMIC:
+            return "logarithmic";
+        case POWER_LAW:
+            return "power law";
+        default:
+            return "constant";
+    }
+}
@@ -0,0 +1,126 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#ifndef SCALINGMODEL_HPP
+#define SCALINGMODEL_HPP
+
+#include <QtGlobal>
+#include <QVector>
+#include <QString>
+#include <QSharedPointer>
+#include <stdint.h>
+
+#include "data.hpp"
+#include "filterstate.hpp"
+
+/*
+ * Extrapolates the sizes of runs of one program at several process counts
+ * to a larger one, e.g. to plan SCOREP_TOTAL_MEMORY for a run that was
+ * never measured. Regions are joined by the name the filter matches.
+ *
+ * The visits of every region and its max_buf are fitted against the
+ * process count by least squares with a constant, a linear, a logarithmic
+ * and a power law model. A model with two parameters is only taken if it
+ * fits clearly better than the constant, among equally good ones the
+ * larger prediction wins so the plan does not fall short. The fit error
+ * is the root mean square of the residuals relative to the measured
+ * values. Two process counts would be met exactly by every model, so at
+ * least three are needed.
+ *
+ * The trace size at the target is the sum of the predicted visits times
+ * the bytes per visit of every region. Summing the max_buf of the regions
+ * overestimates max_buf, since they peak on different processes, so the
+ * sum is scaled by how much it overestimated at the largest measured run.
+ */
+class ScalingModel
+{
+public:
+    enum kind
+    {
+        CONSTANT,
+        LINEAR,
+        LOGARITHMIC,
+        POWER_LAW,
+        KIND_NUM
+    };
+    /*one measured run*/
+    struct profile
+    {
+        QString                                            fileName;
+        int                                                processNum;
+        QSharedPointer<const dataCenter::functionSnapshot> functions;
+        /*per process bytes, indexed by function key*/
+        QVector<QVector<dataCenter::processBytes> >        rows;
+    };
+    /*y = a, a + b * p, a + b * ln( p ) or a * p^b for p processes*/
+    struct fit
+    {
+        kind   model;
+        double a;
+        double b;
+        double error;
+    };
+    struct region
+    {
+        std::string name;
+        std::string type;
+        /*excluded by the filter of the first profile*/
+        bool        excluded;
+        fit         visits;
+        fit         maxBuf;
+        /*at the largest measured process count*/
+        uint64_t    measuredMaxBuf;
+        double      measuredShare;
+        /*at the target process count*/
+        double      targetVisits;
+        uint64_t    targetTraceSize;
+        uint64_t    targetMaxBuf;
+        double      targetShare;
+        /*holds a large and growing share of max_buf at the target*/
+        bool        dominant;
+    };
+    struct result
+    {
+        /*empty if the profiles allow no extrapolation*/
+        QString           error;
+        int               targetProcessNum;
+        /*of the profiles, ascending*/
+        QVector<int>      processNums;
+        /*largest target max_buf first*/
+        QVector<region>   regions;
+        int               dominantNum;
+        /*traceSize and maxBuf only, of the largest measured run, the sums
+         * of the regions at the target and the totals fitted on their own
+         * to check the sums against*/
+        dataCenter::sizes measured;
+        dataCenter::sizes target;
+        dataCenter::sizes targetFiltered;
+        dataCenter::sizes targetFitted;
+        fit               traceSize;
+        fit               maxBuf;
+    };
+
+    /*runs in a worker thread, the snapshots are only read. state is the
+     * filter of profiles[ 0 ], it applies to the others by name*/
+    static result
+    compute( QVector<profile> profiles,
+             FilterState      state,
+             int              targetProcessNum );
+
+    static double
+    predict( const fit& f,
+             double     processNum );
+    static QString
+    modelName( kind model );
+};
+
+#endif // SCALINGMODEL_HPP
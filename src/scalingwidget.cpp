@@ -0,0 +1,177 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#include "scalingwidget.hpp"
+
+namespace
+{
+/*the regions that matter at the target come first, the rest is cut*/
+const int MAX_ROWS = 1000;
+
+QTableWidgetItem*
+numberItem( const QString& text )
+{
+    QTableWidgetItem* item = new QTableWidgetItem( text );
+    item->setTextAlignment( Qt::AlignRight | Qt::AlignVCenter );
+    return item;
+}
+}
+
+ScalingWidget::ScalingWidget( QWidget* parent )
+    : QWidget( parent )
+    , mp_connection( 0 )
+    , m_valid( false )
+    , m_version( 0 )
+    , m_profileNum( -1 )
+    , m_targetNum( 0 )
+{
+    mp_target = new QSpinBox( this );
+    mp_target->setRange( 2, 16777216 );
+    mp_target->setValue( 65536 );
+    mp_table = new QTableWidget( 0, 8, this );
+    QStringList headers;
+    headers << "Region" << "Visits model" << "Visits at target" << "max_buf model" << "max_buf"
+            << "max_buf at target" << "Share" << "Share at target";
+    mp_table->setHorizontalHeaderLabels( headers );
+    mp_table->setEditTriggers( QAbstractItemView::NoEditTriggers );
+    mp_table->setSelectionMode( QAbstractItemView::NoSelection );
+    mp_table->verticalHeader()->hide();
+    mp_table->horizontalHeader()->setStretchLastSection( true );
+    mp_table->setColumnWidth( 0, 250 );
+    mp_label = new QLabel( this );
+    mp_label->setWordWrap( true );
+    mp_watcher = new QFutureWatcher<ScalingModel::result>( this );
+
+    QVBoxLayout* layout = new QVBoxLayout( this );
+    QHBoxLayout* row    = new QHBoxLayout();
+    layout->setContentsMargins( 0, 0, 0, 0 );
+    row->addWidget( new QLabel( "Target processes", this ) );
+    row->addWidget( mp_target );
+    row->addStretch();
+    layout->addLayout( row );
+    layout->addWidget( mp_table );
+    layout->addWidget( mp_label );
+
+    connect( mp_watcher, SIGNAL( finished() ), this, SLOT( scalingFinished() ) );
+    connect( mp_target, SIGNAL( valueChanged( int ) ), this, SIGNAL( targetChanged() ) );
+    clear();
+}
+
+void
+ScalingWidget::compute( Connector* connection, const ProfileSession& session )
+{
+    if ( mp_connection == connection && m_version == connection->getStateVersion() &&
+         m_profileNum == session.profileNum() && m_targetNum == mp_target->value() )
+    {
+        return;
+    }
+    mp_connection = connection;
+    m_version     = connection->getStateVersion();
+    m_profileNum  = session.profileNum();
+    m_targetNum   = mp_target->value();
+
+    /*the shown profile first, its filter applies to the others by name*/
+    QVector<ScalingModel::profile> profiles;
+    profiles.append( connection->getScalingInput() );
+    for ( int i = 0; i < session.profileNum(); i++ )
+    {
+        profiles.append( session.connection( i )->getScalingInput() );
+    }
+    m_valid = true;
+    mp_watcher->setFuture( QtConcurrent::run( &ScalingModel::compute, profiles,
+                                              connection->getFilterState(), m_targetNum ) );
+}
+
+void
+ScalingWidget::clear()
+{
+    m_valid       = false;
+    mp_connection = 0;
+    m_profileNum  = -1;
+    mp_table->setRowCount( 0 );
+    mp_label->setText( "File > Add profile loads runs at other process counts" );
+}
+
+void
+ScalingWidget::scalingFinished()
+{
+    if ( !m_valid || mp_watcher->isRunning() )
+    {
+        return;
+    }
+    ScalingModel::result r = mp_watcher->result();
+    if ( !r.error.isEmpty() )
+    {
+        mp_table->setRowCount( 0 );
+        mp_label->setText( r.error + ", File > Add profile loads runs at other process counts" );
+        return;
+    }
+
+    const int rowNum = qMin( r.regions.size(), MAX_ROWS );
+    mp_table->setRowCount( rowNum );
+    for ( int row = 0; row < rowNum; row++ )
+    {
+        const ScalingModel::region& g = r.regions[ row ];
+        QTableWidgetItem*           items[ 8 ];
+        items[ 0 ] = new QTableWidgetItem( QString::fromStdString( g.name ) );
+        items[ 0 ]->setToolTip( QString::fromStdString( g.type ) +
+                                ( g.excluded ? QString( ", excluded by the filter" ) : QString() ) );
+        items[ 1 ] = numberItem( ScalingModel::modelName( g.visits.model ) );
+        items[ 1 ]->setToolTip( QString( "fit error %1%" ).arg( 100 * g.visits.error, 0, 'f', 1 ) );
+        items[ 2 ] = numberItem( QString::number( g.targetVisits, 'f', 0 ) );
+        items[ 3 ] = numberItem( ScalingModel::modelName( g.maxBuf.model ) );
+        items[ 3 ]->setToolTip( QString( "fit error %1%" ).arg( 100 * g.maxBuf.error, 0, 'f', 1 ) );
+        items[ 4 ] = numberItem( mp_connection->getReadableByteNo( g.measuredMaxBuf ) );
+        items[ 5 ] = numberItem( mp_connection->getReadableByteNo( g.targetMaxBuf ) );
+        items[ 6 ] = numberItem( QString( "%1%" ).arg( 100 * g.measuredShare, 0, 'f', 1 ) );
+        items[ 7 ] = numberItem( QString( "%1%" ).arg( 100 * g.targetShare, 0, 'f', 1 ) );
+        for ( int column = 0; column < 8; column++ )
+        {
+            QFont font = items[ column ]->font();
+            font.setBold( g.dominant );
+            items[ column ]->setFont( font );
+            if ( g.excluded )
+            {
+                items[ column ]->setForeground( Qt::gray );
+            }
+            mp_table->setItem( row, column, items[ column ] );
+        }
+    }
+
+    QStringList processNums;
+    for ( int i = 0; i < r.processNums.size(); i++ )
+    {
+        processNums.append( QString::number( r.processNums[ i ] ) );
+    }
+    QString text = QString( "At %1 processes, fitted to %2: trace size %3, max_buf %4, "
+                            "with filter max_buf %5 and SCOREP_TOTAL_MEMORY=%6. " )
+                   .arg( r.targetProcessNum )
+                   .arg( processNums.join( ", " ) )
+                   .arg( mp_connection->getReadableByteNo( r.target.traceSize ) )
+                   .arg( mp_connection->getReadableByteNo( r.target.maxBuf ) )
+                   .arg( mp_connection->getReadableByteNo( r.targetFiltered.maxBuf ) )
+                   .arg( mp_connection->getReadableByteNo( mp_connection->getTotalMemory( r.targetFiltered.maxBuf ) ) );
+    /*far apart from the sums if the regions are fitted badly*/
+    text += QString( "The totals alone give trace size %1 (%2, error %3%) and max_buf %4 (%5, error %6%). " )
+            .arg( mp_connection->getReadableByteNo( r.targetFitted.traceSize ) )
+            .arg( ScalingModel::modelName( r.traceSize.model ) )
+            .arg( 100 * r.traceSize.error, 0, 'f', 1 )
+            .arg( mp_connection->getReadableByteNo( r.targetFitted.maxBuf ) )
+            .arg( ScalingModel::modelName( r.maxBuf.model ) )
+            .arg( 100 * r.maxBuf.error, 0, 'f', 1 );
+    text += QString( "%1 regions dominate at scale (bold)" ).arg( r.dominantNum );
+    if ( r.regions.size() > rowNum )
+    {
+        text += QString( ", the largest %1 of %2 regions are shown" ).arg( rowNum ).arg( r.regions.size() );
+    }
+    mp_label->setText( text );
+}
@@ -0,0 +1,75 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#ifndef SCALINGWIDGET_HPP
+#define SCALINGWIDGET_HPP
+
+#include <QWidget>
+#include <QLabel>
+#include <QSpinBox>
+#include <QTableWidget>
+#include <QHeaderView>
+#include <QVBoxLayout>
+#include <QFutureWatcher>
+#include <QtConcurrentRun>
+
+#include "connector.hpp"
+#include "profilesession.hpp"
+#include "scalingmodel.hpp"
+
+/*
+ * The regions of the shown and the added profiles extrapolated to a
+ * target process count, computed in the background. Regions dominating
+ * at the target are bold, excluded ones gray.
+ */
+class ScalingWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    ScalingWidget( QWidget* parent = 0 );
+
+    /*starts the extrapolation unless the state of connection, the number
+     * of profiles of session and the target did not change since the last
+     * one, connection formats the result and must stay until it is shown
+     * or clear() is called*/
+    void
+    compute( Connector*            connection,
+             const ProfileSession& session );
+    /*drops a running computation*/
+    void
+    clear();
+
+signals:
+    void
+    targetChanged();
+
+private slots:
+    void
+    scalingFinished();
+
+private:
+    QSpinBox*     mp_target;
+    QTableWidget* mp_table;
+    QLabel*       mp_label;
+    Connector*    mp_connection;
+
+    /*state version, number of profiles and target of the last
+     * computation, a running one is superseded by the next*/
+    QFutureWatcher<ScalingModel::result>* mp_watcher;
+    bool                                  m_valid;
+    uint64_t                              m_version;
+    int                                   m_profileNum;
+    int                                   m_targetNum;
+};
+
+#endif // SCALINGWIDGET_HPP
@@ -43,11 +43,26 @@
 #include <iomanip>
 #include <QString>
 #include <QDebug>
+#include <QMutexLocker>
 
 using namespace std;
 
 #define SCOREP_SCORE_BUFFER_SIZE 128
 
+/**
+ * Guards the global event list and the temporary files of otf2-estimator
+ * while profiles are loaded in parallel.
+ */
+static QMutex event_mutex;
+
+/**
+ * Sizes reported by otf2-estimator by the numbers of region and metric
+ * definitions and of dense metrics they depend on. Further profiles of a
+ * program get them without starting otf2-estimator again.
+ */
+typedef pair< pair< uint64_t, uint64_t >, uint64_t > event_size_key;
+static map< event_size_key, vector< pair< string, uint64_t > > > event_size_cache;
+
 /* **************************************************************************************
                                                                        internal functions
 ****************************************************************************************/
@@ -275,7 +290,14 @@ get_user_readable_byte_no( uint64_t bytes )
 SCOREP_Score_Estimator::SCOREP_Score_Estimator( std::string fileName,
                                                 uint64_t    denseNum )
 {
-    m_dense_num = denseNum;
+    m_dense_num   = denseNum;
+    m_profile     = NULL;
+    m_groups      = NULL;
+    m_regions     = NULL;
+    m_filtered    = NULL;
+    m_region_num  = 0;
+    m_process_num = 0;
+    m_has_filter  = false;
     SCOREP_Score_Profile* profile;
     try
     {
@@ -283,7 +305,7 @@ SCOREP_Score_Estimator::SCOREP_Score_Estimator( std::string fileName,
     }
     catch ( ... )
     {
-        /*ERROR*/
+        /*reported through isValid()*/
         return;
     }
 
@@ -292,6 +314,7 @@ SCOREP_Score_Estimator::SCOREP_Score_Estimator( std::string fileName,
     m_process_num = profile->getNumberOfProcesses();
 
     m_has_filter = false;
+    QMutexLocker lock( &event_mutex );
     SCOREP_Score_Event::RegisterEvent( new SCOREP_Score_TimestampEvent() );
     SCOREP_Score_Event::RegisterEvent( new SCOREP_Score_EnterEvent() );
     SCOREP_Score_Event::RegisterEvent( new SCOREP_Score_LeaveEvent() );
@@ -439,6 +462,12 @@ SCOREP_Score_Estimator::SCOREP_Score_Estimator( std::string fileName,
 #undef SCOREP_SCORE_EVENT
 
     calculate_event_sizes();
+    for ( map<string, SCOREP_Score_Event*>::iterator i = SCOREP_Score_Event::m_all_events.begin();
+          i != SCOREP_Score_Event::m_all_events.end(); i++ )
+    {
+        m_events.push_back( make_pair( i->second, i->second->getEventSize() ) );
+    }
+    lock.unlock();
 
     m_filtered = NULL;
     m_regions  = NULL;
@@ -455,6 +484,13 @@ SCOREP_Score_Estimator::~SCOREP_Score_Estimator()
     delete_groups( m_groups, SCOREP_SCORE_TYPE_NUM );
     delete_groups( m_regions, m_region_num );
     delete_groups( m_filtered, SCOREP_SCORE_TYPE_NUM );
+    delete m_profile;
+}
+
+bool
+SCOREP_Score_Estimator::isValid( void )
+{
+    return m_profile != NULL;
 }
 
 void
@@ -487,8 +523,9 @@ SCOREP_Score_Estimator::initializeFilter( string /*filterFile*/ )
     m_has_filter = true;
 }
 
-void
-SCOREP_Score_Estimator::calculate( bool showRegions, bool useMangled, QHash<QString, QHash<int, dataCenter::buffer> >* buffer )
+bool
+SCOREP_Score_Estimator::calculate( bool showRegions, bool useMangled, QVector<QHash<int, dataCenter::buffer> >* buffer,
+                                   QAtomicInt* done, QAtomicInt* cancel )
 {
     if ( showRegions )
     {
@@ -497,22 +534,34 @@ SCOREP_Score_Estimator::calculate( bool showRegions, bool useMangled, QHash<QStr
 
     uint64_t temp1 = 0;
     uint64_t temp0 = 0;
+    m_bytes_per_visit.assign( m_region_num, 0 );
+    /*by region ID, regions sharing a name keep their own data*/
+    buffer->clear();
+    buffer->resize( m_region_num );
     for ( uint64_t region = 0; region < m_region_num; region++ )
     {
+        if ( cancel && cancel->fetchAndAddRelaxed( 0 ) )
+        {
+            return false;
+        }
+        if ( done )
+        {
+            done->fetchAndAddRelaxed( 1 );
+        }
         const string& region_name     = m_profile->getRegionName( region );
         uint64_t      group           = m_profile->getGroup( region );
         uint64_t      bytes_per_visit = 0;
 
         /* Calculate bytes per visit */
-        for ( map<string, SCOREP_Score_Event*>::iterator i = SCOREP_Score_Event::m_all_events.begin();
-              i != SCOREP_Score_Event::m_all_events.end(); i++ )
+        for ( size_t i = 0; i < m_events.size(); i++ )
         {
-            if ( i->second->occursInRegion( region_name ) )
+            if ( m_events[ i ].first->occursInRegion( region_name ) )
             {
-                bytes_per_visit += i->second->getEventSize();
+                bytes_per_visit += m_events[ i ].second;
             }
         }
-        QHash<int, dataCenter::buffer> tempHash;
+        m_bytes_per_visit[ region ] = bytes_per_visit;
+        QHash<int, dataCenter::buffer>& tempHash = ( *buffer )[ region ];
         /* Apply region data for each process */
         for ( uint64_t process = 0; process < m_process_num; process++ )
         {
@@ -569,12 +618,8 @@ SCOREP_Score_Estimator::calculate( bool showRegions, bool useMangled, QHash<QStr
                 }
             }
         }
-        if ( tempHash.size() != 0 )
-        {
-            buffer->insert( QString::fromStdString( region_name ), tempHash );
-        }
-        tempHash.clear();
     }
+    return true;
 }
 
 void
@@ -673,6 +718,17 @@ SCOREP_Score_Estimator::dumpEventSizes( void )
 void
 SCOREP_Score_Estimator::calculate_event_sizes( void )
 {
+    event_size_key key = make_pair( make_pair( m_region_num, m_profile->getNumberOfMetrics() ), m_dense_num );
+    map< event_size_key, vector< pair< string, uint64_t > > >::iterator cached = event_size_cache.find( key );
+    if ( cached != event_size_cache.end() )
+    {
+        for ( size_t i = 0; i < cached->second.size(); i++ )
+        {
+            SCOREP_Score_Event::SetEventSize( cached->second[ i ].first, cached->second[ i ].second );
+        }
+        return;
+    }
+
     /* Write otf2-estimator input */
     string in_filename  = get_temp_filename();
     string out_filename = get_temp_filename();
@@ -712,6 +768,7 @@ SCOREP_Score_Estimator::calculate_event_sizes( void )
         exit( EXIT_FAILURE );
     }
 
+    vector< pair< string, uint64_t > > sizes;
     while ( estimator_out )
     {
         /* Decode next line. Has format <name><space><number of bytes>
@@ -734,7 +791,9 @@ SCOREP_Score_Estimator::calculate_event_sizes( void )
 
         /* Apply to event sizes */
         SCOREP_Score_Event::SetEventSize( event, value );
+        sizes.push_back( make_pair( event, value ) );
     }
+    event_size_cache[ key ] = sizes;
 
     /* Clean up */
     estimator_out.close();
@@ -774,6 +833,7 @@ SCOREP_Score_Estimator::initialize_regions( bool useMangled )
                                                       m_process_num,
                                                       m_profile->getRegionName( region ),
                                                       m_profile->getMangledName( region ) );
+        m_regions[ region ]->setRegionId( region );
     }
 }
 
@@ -827,11 +887,56 @@ SCOREP_Score_Estimator::getRegionInformation( int number )
     m_regions[ number ]->getRegionData( &d.type, &d.maxBuf, &d.visits,
                                         &d.timeS, &d.timeP, &d.timePerVisit,
                                         &d.region, total_time, &d.mangledName );
+    d.fileName = m_profile->getFileName( m_regions[ number ]->getRegionId() );
     d.key      = number;
-    d.included = true;
     return d;
 }
 
+double
+SCOREP_Score_Estimator::getRegionTime( int number, uint64_t process )
+{
+    QMutexLocker lock( &m_profile_mutex );
+    return m_profile->getTime( m_regions[ number ]->getRegionId(), process );
+}
+
+uint64_t
+SCOREP_Score_Estimator::getRegionId( int number )
+{
+    return m_regions[ number ]->getRegionId();
+}
+
+bool
+SCOREP_Score_Estimator::getCallTree( vector<uint64_t>* regions,
+                                     vector<int64_t>*  parents,
+                                     vector<uint64_t>* bytes,
+                                     vector<string>*   names,
+                                     QAtomicInt*       cancel )
+{
+    {
+        QMutexLocker lock( &m_profile_mutex );
+        m_profile->getCallTree( regions, parents );
+        names->resize( m_region_num );
+        for ( uint64_t region = 0; region < m_region_num; region++ )
+        {
+            ( *names )[ region ] = m_profile->getRegionName( region );
+        }
+    }
+
+    /* One lock per callpath lets other readers in between */
+    bytes->resize( regions->size() );
+    for ( uint64_t callpath = 0; callpath < regions->size(); callpath++ )
+    {
+        if ( cancel && ( callpath & 1023 ) == 0 && cancel->fetchAndAddRelaxed( 0 ) )
+        {
+            return false;
+        }
+        QMutexLocker lock( &m_profile_mutex );
+        ( *bytes )[ callpath ] = m_profile->getCallpathVisits( callpath ) *
+                                 m_bytes_per_visit[ ( *regions )[ callpath ] ];
+    }
+    return true;
+}
+
 uint64_t
 SCOREP_Score_Estimator::getTypeNum()
 {
@@ -844,6 +949,12 @@ SCOREP_Score_Estimator::getRegionNum()
     return m_region_num;
 }
 
+uint64_t
+SCOREP_Score_Estimator::getProcessNum()
+{
+    return m_process_num;
+}
+
 uint64_t
 SCOREP_Score_Estimator::updateMemory( uint64_t maxBuf )
 {
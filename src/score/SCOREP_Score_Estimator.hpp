@@ -43,6 +43,9 @@
 #include "SCOREP_Score_Event.hpp"
 #include <deque>
 #include <QHash>
+#include <QAtomicInt>
+#include <QMutex>
+#include <vector>
 #include "../data.hpp"
 
 /**
@@ -66,17 +69,30 @@ public:
     virtual
     ~SCOREP_Score_Estimator();
 
+    /**
+     * Returns false if the profile could not be opened. No other method
+     * may be called then.
+     */
+    bool
+    isValid( void );
+
     /**
      * Claculates the group an region data.
      * @param showRegions  Pass true if the user wants to see per region data
      *                     in addition to the groups.
      * @param useMangled   Wether mangled or demangled region names are used for
      *                     display.
+     * @param buffer       Returns the per process visits of every region ID.
+     * @param done         If given, incremented for every processed region.
+     * @param cancel       If given and set, the calculation stops early.
+     * @return false if the calculation was cancelled.
      */
-    void
-    calculate( bool showRegions,
-               bool useMangled,
-               QHash<QString, QHash<int, dataCenter::buffer> >* buffer );
+    bool
+    calculate( bool                                      showRegions,
+               bool                                      useMangled,
+               QVector<QHash<int, dataCenter::buffer> >* buffer,
+               QAtomicInt*                               done = 0,
+               QAtomicInt*                               cancel = 0 );
 
     /**
      * Prints the group information to the screen.
@@ -115,10 +131,45 @@ public:
     void
     dumpEventSizes( void );
 
+    /**
+     * Reads the exclusive time of one region on one process from the profile.
+     * @param number   Index of the region as used by getRegionInformation.
+     * @param process  Index of the process.
+     */
+    double
+    getRegionTime( int      number,
+                   uint64_t process );
+
+    /**
+     * Returns the profile region ID of a region.
+     * @param number  Index of the region as used by getRegionInformation.
+     */
+    uint64_t
+    getRegionId( int number );
+
+    /**
+     * Estimates the trace bytes of every callpath, the tree is flattened in
+     * preorder as in SCOREP_Score_Profile::getCallTree. Requires calculate().
+     * @param regions  Returns the region ID of every callpath.
+     * @param parents  Returns the parent of every callpath, -1 for the roots.
+     * @param bytes    Returns the bytes every callpath writes on all processes.
+     * @param names    Returns the name of every region ID.
+     * @param cancel   Stops the estimation if set, may be NULL.
+     * @returns false if the estimation was cancelled.
+     */
+    bool
+    getCallTree( std::vector<uint64_t>*    regions,
+                 std::vector<int64_t>*     parents,
+                 std::vector<uint64_t>*    bytes,
+                 std::vector<std::string>* names,
+                 QAtomicInt*               cancel = 0 );
+
     uint64_t
     getTypeNum();
     uint64_t
     getRegionNum();
+    uint64_t
+    getProcessNum();
 
 private:
     /**
@@ -146,7 +197,8 @@ private:
                    uint64_t             num );
 
     /**
-     * Initializes the event sizes.
+     * Initializes the event sizes, taken from a profile with the same
+     * numbers of definitions if one was loaded before.
      */
     void
     calculate_event_sizes( void );
@@ -198,6 +250,24 @@ private:
      * Stores the number of dense metrics that should be taken into account.
      */
     uint64_t m_dense_num;
+
+    /**
+     * Stores the bytes per visit of every region ID.
+     */
+    std::vector<uint64_t> m_bytes_per_visit;
+
+    /**
+     * Serializes the profile reads of getRegionTime and getCallTree, which
+     * run in worker threads.
+     */
+    QMutex m_profile_mutex;
+
+    /**
+     * The registered events with their sizes for this profile. The global
+     * event list is only used by the constructor, profiles loaded in
+     * parallel read their own copy.
+     */
+    std::vector< std::pair< SCOREP_Score_Event*, uint32_t > > m_events;
 };
 
 
@@ -94,6 +94,7 @@ SCOREP_Score_Group::SCOREP_Score_Group( uint64_t type,
     m_name       = name;
     m_filter     = SCOREP_SCORE_FILTER_UNSPECIFIED;
     m_visits     = 0;
+    m_region_id  = 0;
 }
 
 SCOREP_Score_Group::SCOREP_Score_Group( uint64_t type,
@@ -110,6 +111,7 @@ SCOREP_Score_Group::SCOREP_Score_Group( uint64_t type,
     m_filter      = SCOREP_SCORE_FILTER_UNSPECIFIED;
     m_visits      = 0;
     m_mangledName = mangledName;
+    m_region_id   = 0;
 }
 
 
@@ -225,6 +227,18 @@ SCOREP_Score_Group::getTotalTime( void )
     return m_total_time;
 }
 
+void
+SCOREP_Score_Group::setRegionId( uint64_t regionId )
+{
+    m_region_id = regionId;
+}
+
+uint64_t
+SCOREP_Score_Group::getRegionId( void )
+{
+    return m_region_id;
+}
+
 uint64_t
 SCOREP_Score_Group::getMaxTraceBufferSize( void )
 {
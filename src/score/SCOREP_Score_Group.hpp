@@ -196,6 +196,20 @@ public:
     void
     doFilter( SCOREP_Score_FilterState state );
 
+    /**
+     * Sets the id of the region in the profile, if this group represents
+     * a single region.
+     * @param regionId  The region id.
+     */
+    void
+    setRegionId( uint64_t regionId );
+
+    /**
+     * Returns the id of the represented region in the profile.
+     */
+    uint64_t
+    getRegionId( void );
+
 private:
     /**
      * Stores the group type.
@@ -234,6 +248,11 @@ private:
 
     std::string m_mangledName;
 
+    /**
+     * Stores the region id in the profile.
+     */
+    uint64_t m_region_id;
+
     /**
      * Stores the filter state.
      */
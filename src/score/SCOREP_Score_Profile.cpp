@@ -298,6 +298,63 @@ SCOREP_Score_Profile::get_definition_type( uint64_t region )
     }
 }
 
+void
+SCOREP_Score_Profile::getCallTree( vector<uint64_t>* regions,
+                                   vector<int64_t>*  parents )
+{
+    regions->clear();
+    parents->clear();
+    m_callpaths.clear();
+
+    /* Iterative, call trees may be deeper than the stack allows */
+    vector<Cnode*>  stack;
+    vector<int64_t> stack_parents;
+    vector<Cnode*>  roots = m_cube->get_root_cnodev();
+    for ( uint64_t i = roots.size(); i > 0; i-- )
+    {
+        stack.push_back( roots[ i - 1 ] );
+        stack_parents.push_back( -1 );
+    }
+    while ( !stack.empty() )
+    {
+        Cnode*  node   = stack.back();
+        int64_t parent = stack_parents.back();
+        stack.pop_back();
+        stack_parents.pop_back();
+
+        int64_t index = m_callpaths.size();
+        m_callpaths.push_back( node );
+        regions->push_back( node->get_callee()->get_id() );
+        parents->push_back( parent );
+        for ( uint32_t i = node->num_children(); i > 0; i-- )
+        {
+            stack.push_back( node->get_child( i - 1 ) );
+            stack_parents.push_back( index );
+        }
+    }
+}
+
+uint64_t
+SCOREP_Score_Profile::getCallpathVisits( uint64_t callpath )
+{
+    Value* value = m_cube->get_sev_adv( m_visits, CUBE_CALCULATE_EXCLUSIVE,
+                                        m_callpaths[ callpath ], CUBE_CALCULATE_EXCLUSIVE );
+
+    if ( !value )
+    {
+        return 0;
+    }
+    if ( value->myDataType() == CUBE_DATA_TYPE_TAU_ATOMIC )
+    {
+        TauAtomicValue* tau_value = ( TauAtomicValue* )value;
+        return tau_value->getN().getUnsignedLong();
+    }
+    else
+    {
+        return value->getUnsignedLong();
+    }
+}
+
 bool
 SCOREP_Score_Profile::calculate_calltree_types( const vector<Cnode*>* cnodes,
                                                 Cnode*                node )
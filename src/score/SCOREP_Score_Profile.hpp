@@ -164,6 +164,24 @@ public:
     uint64_t
     getFileSize( void );
 
+    /**
+     * Flattens the call tree in preorder, the subtree of a node directly
+     * follows it.
+     * @param regions  Returns the region ID of every callpath.
+     * @param parents  Returns the preorder index of the parent of every
+     *                 callpath, -1 for the roots.
+     */
+    void
+    getCallTree( std::vector<uint64_t>* regions,
+                 std::vector<int64_t>*  parents );
+
+    /**
+     * Returns the number of visits of a callpath summed over all processes.
+     * @param callpath  Preorder index of the callpath as returned by getCallTree.
+     */
+    uint64_t
+    getCallpathVisits( uint64_t callpath );
+
 private:
     /**
      * Calculates recursively whether a node is on a callpath to an MPI or OpenMP
@@ -209,6 +227,11 @@ private:
      */
     std::vector<cube::Region*> m_regions;
 
+    /**
+     * Stores the callpaths in the order of getCallTree.
+     */
+    std::vector<cube::Cnode*> m_callpaths;
+
     /**
      * Stores a mapping of regionIds to region types.
      */
@@ -0,0 +1,178 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#include "searchbar.hpp"
+
+SearchBar::SearchBar( QWidget* parent )
+    : QWidget( parent )
+    , m_active( false )
+    , m_indexValid( false )
+{
+    mp_edit = new QLineEdit( this );
+    mp_edit->setPlaceholderText( "search region or mangled names" );
+    mp_onlyMatches = new QCheckBox( "only matches", this );
+    mp_label       = new QLabel( this );
+    mp_exclude     = new QPushButton( "Exclude matches", this );
+    mp_include     = new QPushButton( "Include matches", this );
+    mp_exclude->setEnabled( false );
+    mp_include->setEnabled( false );
+    mp_timer = new QTimer( this );
+    mp_timer->setSingleShot( true );
+    mp_timer->setInterval( 100 );
+    mp_indexWatcher = new QFutureWatcher<QSharedPointer<const TrigramIndex> >( this );
+
+    QHBoxLayout* layout = new QHBoxLayout( this );
+    layout->setContentsMargins( 0, 0, 0, 0 );
+    layout->addWidget( mp_edit );
+    layout->addWidget( mp_onlyMatches );
+    layout->addWidget( mp_label );
+    layout->addStretch();
+    layout->addWidget( mp_exclude );
+    layout->addWidget( mp_include );
+
+    connect( mp_timer, SIGNAL( timeout() ), this, SLOT( runSearch() ) );
+    connect( mp_edit, SIGNAL( textChanged( QString ) ), this, SLOT( scheduleSearch() ) );
+    connect( mp_edit, SIGNAL( returnPressed() ), this, SIGNAL( nextRequested() ) );
+    connect( mp_onlyMatches, SIGNAL( toggled( bool ) ), this, SIGNAL( onlyMatchesToggled() ) );
+    connect( mp_exclude, SIGNAL( clicked( bool ) ), this, SLOT( excludeClicked() ) );
+    connect( mp_include, SIGNAL( clicked( bool ) ), this, SLOT( includeClicked() ) );
+    connect( mp_indexWatcher, SIGNAL( finished() ), this, SLOT( indexFinished() ) );
+}
+
+void
+SearchBar::setFunctions( QSharedPointer<const dataCenter::functionSnapshot> functions )
+{
+    /*matches of an older snapshot are useless, the search reruns on the new index*/
+    m_active = true;
+    m_matches.clear();
+    if ( m_index && m_index->fits( functions ) )
+    {
+        /*a reloaded profile mostly keeps its names, the index and its strings stay*/
+        m_indexValid = false;
+        if ( !text().isEmpty() )
+        {
+            runSearch();
+        }
+        return;
+    }
+    m_indexValid = true;
+    m_index.clear();
+    mp_indexWatcher->setFuture( QtConcurrent::run( &TrigramIndex::build, functions ) );
+}
+
+void
+SearchBar::clear()
+{
+    m_active     = false;
+    m_indexValid = false;
+    mp_timer->stop();
+    mp_edit->blockSignals( true );
+    mp_edit->clear();
+    mp_edit->blockSignals( false );
+    mp_label->clear();
+    mp_exclude->setEnabled( false );
+    mp_include->setEnabled( false );
+    m_matches.clear();
+}
+
+QString
+SearchBar::text() const
+{
+    return mp_edit->text().trimmed();
+}
+
+bool
+SearchBar::onlyMatches() const
+{
+    return mp_onlyMatches->isChecked();
+}
+
+void
+SearchBar::setSearch( const QString& text, bool onlyMatches )
+{
+    mp_onlyMatches->setChecked( onlyMatches );
+    mp_edit->setText( text );
+}
+
+QVector<int>
+SearchBar::matches() const
+{
+    return m_matches;
+}
+
+void
+SearchBar::focus()
+{
+    mp_edit->setFocus();
+    mp_edit->selectAll();
+}
+
+void
+SearchBar::scheduleSearch()
+{
+    mp_timer->start();
+}
+
+void
+SearchBar::runSearch()
+{
+    mp_timer->stop();
+    if ( !m_active )
+    {
+        return;
+    }
+    if ( text().isEmpty() )
+    {
+        m_matches.clear();
+        mp_label->clear();
+    }
+    else if ( !m_index )
+    {
+        /*indexFinished searches again*/
+        mp_label->setText( "indexing..." );
+        return;
+    }
+    else
+    {
+        m_matches = m_index->search( text() );
+        mp_label->setText( QString( "%1 matches" ).arg( m_matches.size() ) );
+    }
+    mp_exclude->setEnabled( !m_matches.isEmpty() );
+    mp_include->setEnabled( !m_matches.isEmpty() );
+    emit searched();
+}
+
+void
+SearchBar::indexFinished()
+{
+    if ( !m_indexValid || mp_indexWatcher->isRunning() )
+    {
+        return;
+    }
+    m_index = mp_indexWatcher->result();
+    if ( !text().isEmpty() )
+    {
+        runSearch();
+    }
+}
+
+void
+SearchBar::excludeClicked()
+{
+    emit changeRequested( true );
+}
+
+void
+SearchBar::includeClicked()
+{
+    emit changeRequested( false );
+}
@@ -0,0 +1,103 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#ifndef SEARCHBAR_HPP
+#define SEARCHBAR_HPP
+
+#include <QWidget>
+#include <QLabel>
+#include <QLineEdit>
+#include <QCheckBox>
+#include <QPushButton>
+#include <QHBoxLayout>
+#include <QTimer>
+#include <QFutureWatcher>
+#include <QtConcurrentRun>
+
+#include "trigramindex.hpp"
+
+/*
+ * Search row above the function table. The index over the region names
+ * is built in the background for every new snapshot, the search runs as
+ * you type, but not on every single key.
+ */
+class SearchBar : public QWidget
+{
+    Q_OBJECT
+
+public:
+    SearchBar( QWidget* parent = 0 );
+
+    /*drops the matches, the index is kept if functions has the same
+     * names, e.g. after the profile was rewritten*/
+    void
+    setFunctions( QSharedPointer<const dataCenter::functionSnapshot> functions );
+    /*clears the text and the matches without searching, the index stays
+     * for the next setFunctions*/
+    void
+    clear();
+
+    QString
+    text() const;
+    /*only the matching rows are to be shown*/
+    bool
+    onlyMatches() const;
+    /*searches once the index is built*/
+    void
+    setSearch( const QString& text,
+               bool           onlyMatches );
+    /*sorted keys matching the text*/
+    QVector<int>
+    matches() const;
+    void
+    focus();
+
+signals:
+    /*the matches changed*/
+    void
+    searched();
+    void
+    onlyMatchesToggled();
+    void
+    nextRequested();
+    void
+    changeRequested( bool exclude );
+
+private slots:
+    void
+    scheduleSearch();
+    void
+    runSearch();
+    void
+    indexFinished();
+    void
+    excludeClicked();
+    void
+    includeClicked();
+
+private:
+    QLineEdit*   mp_edit;
+    QCheckBox*   mp_onlyMatches;
+    QLabel*      mp_label;
+    QPushButton* mp_exclude;
+    QPushButton* mp_include;
+    QTimer*      mp_timer;
+    /*false until the first snapshot and after clear()*/
+    bool         m_active;
+
+    QFutureWatcher<QSharedPointer<const TrigramIndex> >* mp_indexWatcher;
+    QSharedPointer<const TrigramIndex>                   m_index;
+    bool                                                 m_indexValid;
+    QVector<int>                                         m_matches;
+};
+
+#endif // SEARCHBAR_HPP
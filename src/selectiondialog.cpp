@@ -0,0 +1,243 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#include "selectiondialog.hpp"
+
+SelectionDialog::SelectionDialog( Connector* connection, QWidget* parent )
+    : QDialog( parent )
+    , mp_connection( connection )
+{
+    setWindowTitle( "Select regions by rules" );
+    QVBoxLayout* layout = new QVBoxLayout( this );
+    mp_ruleLayout   = new QVBoxLayout();
+    mp_removeMapper = new QSignalMapper( this );
+    mp_previewTimer = new QTimer( this );
+    mp_previewTimer->setSingleShot( true );
+    mp_previewTimer->setInterval( 150 );
+
+    QHBoxLayout* actionRow = new QHBoxLayout();
+    mp_action = new QComboBox( this );
+    mp_action->addItem( "Exclude" );
+    mp_action->addItem( "Include" );
+    QPushButton* addButton = new QPushButton( "Add rule", this );
+    actionRow->addWidget( mp_action );
+    actionRow->addWidget( new QLabel( "all regions matching every rule", this ) );
+    actionRow->addStretch();
+    actionRow->addWidget( addButton );
+
+    mp_previewLabel = new QLabel( this );
+    QHBoxLayout* buttonRow   = new QHBoxLayout();
+    QPushButton* closeButton = new QPushButton( "Close", this );
+    mp_applyButton = new QPushButton( "Apply", this );
+    mp_applyButton->setDefault( true );
+    buttonRow->addStretch();
+    buttonRow->addWidget( mp_applyButton );
+    buttonRow->addWidget( closeButton );
+
+    layout->addLayout( actionRow );
+    layout->addLayout( mp_ruleLayout );
+    layout->addWidget( mp_previewLabel );
+    layout->addLayout( buttonRow );
+
+    connect( addButton, SIGNAL( clicked( bool ) ), this, SLOT( addRule() ) );
+    connect( mp_removeMapper, SIGNAL( mapped( QWidget* ) ), this, SLOT( removeRule( QWidget* ) ) );
+    connect( mp_action, SIGNAL( currentIndexChanged( int ) ), this, SLOT( schedulePreview() ) );
+    connect( mp_previewTimer, SIGNAL( timeout() ), this, SLOT( updatePreview() ) );
+    connect( mp_applyButton, SIGNAL( clicked( bool ) ), this, SLOT( apply() ) );
+    connect( closeButton, SIGNAL( clicked( bool ) ), this, SLOT( reject() ) );
+
+    addRule();
+    updatePreview();
+}
+
+Connector::selectionPreview
+SelectionDialog::preview()
+{
+    return m_preview;
+}
+
+void
+SelectionDialog::addRule()
+{
+    ruleRow row;
+    row.widget     = new QWidget( this );
+    row.column     = new QComboBox( row.widget );
+    row.comparison = new QComboBox( row.widget );
+    row.value      = new QLineEdit( row.widget );
+    row.remove     = new QPushButton( "Remove", row.widget );
+    for ( int i = 0; i < RegionSelection::COLUMN_NUM; i++ )
+    {
+        row.column->addItem( RegionSelection::columnName( ( RegionSelection::column )i ) );
+    }
+    row.column->setCurrentIndex( RegionSelection::TYPE );
+    updateComparisons( row );
+
+    QHBoxLayout* layout = new QHBoxLayout( row.widget );
+    layout->setContentsMargins( 0, 0, 0, 0 );
+    layout->addWidget( row.column );
+    layout->addWidget( row.comparison );
+    layout->addWidget( row.value );
+    layout->addWidget( row.remove );
+    mp_ruleLayout->addWidget( row.widget );
+    m_rows.append( row );
+
+    mp_removeMapper->setMapping( row.remove, row.widget );
+    connect( row.remove, SIGNAL( clicked( bool ) ), mp_removeMapper, SLOT( map() ) );
+    connect( row.column, SIGNAL( currentIndexChanged( int ) ), this, SLOT( columnChanged() ) );
+    connect( row.comparison, SIGNAL( currentIndexChanged( int ) ), this, SLOT( schedulePreview() ) );
+    connect( row.value, SIGNAL( textChanged( QString ) ), this, SLOT( schedulePreview() ) );
+    schedulePreview();
+}
+
+void
+SelectionDialog::removeRule( QWidget* widget )
+{
+    for ( int i = 0; i < m_rows.size(); i++ )
+    {
+        if ( m_rows[ i ].widget == widget )
+        {
+            m_rows.removeAt( i );
+            break;
+        }
+    }
+    widget->deleteLater();
+    schedulePreview();
+}
+
+void
+SelectionDialog::updateComparisons( ruleRow& row )
+{
+    bool numeric = RegionSelection::isNumeric( ( RegionSelection::column )row.column->currentIndex() );
+    /*keep the comparison if it still fits the column*/
+    if ( row.comparison->count() > 0 &&
+         ( row.comparison->itemData( 0 ).toInt() == RegionSelection::LESS ) == numeric )
+    {
+        return;
+    }
+    row.comparison->blockSignals( true );
+    row.comparison->clear();
+    if ( numeric )
+    {
+        row.comparison->addItem( "<", RegionSelection::LESS );
+        row.comparison->addItem( ">", RegionSelection::GREATER );
+        row.value->setPlaceholderText( "number, e.g. 1e6" );
+    }
+    else
+    {
+        row.comparison->addItem( "matches", RegionSelection::MATCHES );
+        row.comparison->addItem( "does not match", RegionSelection::NOT_MATCHES );
+        row.value->setPlaceholderText( "wildcard pattern, e.g. *solver*" );
+    }
+    row.comparison->blockSignals( false );
+}
+
+void
+SelectionDialog::columnChanged()
+{
+    for ( int i = 0; i < m_rows.size(); i++ )
+    {
+        updateComparisons( m_rows[ i ] );
+    }
+    schedulePreview();
+}
+
+QList<RegionSelection::rule>
+SelectionDialog::rules( bool* valid )
+{
+    QList<RegionSelection::rule> result;
+    *valid = true;
+    for ( int i = 0; i < m_rows.size(); i++ )
+    {
+        const ruleRow&        row = m_rows[ i ];
+        RegionSelection::rule r;
+        r.col     = ( RegionSelection::column )row.column->currentIndex();
+        r.op      = ( RegionSelection::comparison )row.comparison->itemData( row.comparison->currentIndex() ).toInt();
+        r.value   = 0;
+        r.pattern = row.value->text().trimmed();
+        if ( RegionSelection::isNumeric( r.col ) )
+        {
+            bool ok = false;
+            r.value = r.pattern.toDouble( &ok );
+            if ( !ok )
+            {
+                *valid = false;
+                continue;
+            }
+        }
+        else if ( r.pattern.isEmpty() )
+        {
+            *valid = false;
+            continue;
+        }
+        result.append( r );
+    }
+    return result;
+}
+
+void
+SelectionDialog::schedulePreview()
+{
+    mp_previewTimer->start();
+}
+
+QString
+SelectionDialog::sizeDelta( uint64_t before, uint64_t after )
+{
+    /*getReadableByteNo rounds up, a delta of 0 would read 1bytes*/
+    if ( after == before )
+    {
+        return mp_connection->getReadableByteNo( before ) + " (unchanged)";
+    }
+    QString sign = after > before ? "+" : "-";
+    return mp_connection->getReadableByteNo( before ) + " -> " +
+           mp_connection->getReadableByteNo( after ) + " (" + sign +
+           mp_connection->getReadableByteNo( after > before ? after - before : before - after ) + ")";
+}
+
+void
+SelectionDialog::updatePreview()
+{
+    mp_previewTimer->stop();
+    bool                         valid;
+    QList<RegionSelection::rule> current = rules( &valid );
+    if ( !valid || current.isEmpty() )
+    {
+        m_preview         = Connector::selectionPreview();
+        m_preview.changed = 0;
+        mp_previewLabel->setText( "Every rule needs a value" );
+        mp_applyButton->setEnabled( false );
+        return;
+    }
+    m_preview = mp_connection->previewSelection( current, mp_action->currentIndex() == 0 );
+    mp_previewLabel->setText( QString( "%1 regions match, %2 change their state\n"
+                                       "max_buf: %3\n"
+                                       "trace size: %4" )
+                              .arg( m_preview.keys.size() )
+                              .arg( m_preview.changed )
+                              .arg( sizeDelta( m_preview.before.maxBuf, m_preview.after.maxBuf ) )
+                              .arg( sizeDelta( m_preview.before.traceSize, m_preview.after.traceSize ) ) );
+    mp_applyButton->setEnabled( m_preview.changed > 0 );
+}
+
+void
+SelectionDialog::apply()
+{
+    /*the rules may have changed since the last preview*/
+    if ( mp_previewTimer->isActive() )
+    {
+        updatePreview();
+    }
+    if ( m_preview.changed > 0 )
+    {
+        accept();
+    }
+}
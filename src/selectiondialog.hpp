@@ -0,0 +1,83 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#ifndef SELECTIONDIALOG_HPP
+#define SELECTIONDIALOG_HPP
+
+#include <QDialog>
+#include <QComboBox>
+#include <QLineEdit>
+#include <QPushButton>
+#include <QLabel>
+#include <QLayout>
+#include <QTimer>
+#include <QSignalMapper>
+
+#include "connector.hpp"
+
+/*builds selection rules and previews their effect on the filtered sizes*/
+class SelectionDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    SelectionDialog( Connector* connection,
+                     QWidget*   parent = 0 );
+
+    /*preview of the current rules, up to date after exec() returned*/
+    Connector::selectionPreview
+    preview();
+
+private:
+    struct ruleRow
+    {
+        QWidget*     widget;
+        QComboBox*   column;
+        QComboBox*   comparison;
+        QLineEdit*   value;
+        QPushButton* remove;
+    };
+
+    Connector*                  mp_connection;
+    QList<ruleRow>              m_rows;
+    QVBoxLayout*                mp_ruleLayout;
+    QComboBox*                  mp_action;
+    QLabel*                     mp_previewLabel;
+    QPushButton*                mp_applyButton;
+    QTimer*                     mp_previewTimer;
+    QSignalMapper*              mp_removeMapper;
+    Connector::selectionPreview m_preview;
+
+    QList<RegionSelection::rule>
+    rules( bool* valid );
+    void
+    updateComparisons( ruleRow& row );
+    QString
+    sizeDelta( uint64_t before,
+               uint64_t after );
+
+private slots:
+    void
+    addRule();
+    void
+    removeRule( QWidget* widget );
+    void
+    columnChanged();
+    void
+    schedulePreview();
+    void
+    updatePreview();
+    void
+    apply();
+};
+
+#endif // SELECTIONDIALOG_HPP
@@ -0,0 +1,217 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#include <QFile>
+#include <QByteArray>
+#include <QDataStream>
+
+#include "sessionfile.hpp"
+#include "filterexport.hpp"
+
+/*"SGUI" followed by the version of the format*/
+#define SESSIONFILE_MAGIC 0x53475549
+#define SESSIONFILE_VERSION 1
+
+namespace
+{
+/*the functions that differ from base, the sizes without per process
+ * totals, and the rules unless they are shared with the ones of base*/
+void
+writeEntry( QDataStream& out, const FilterState& base, const QVector<FilterFile::rule>& baseRules,
+            const FilterState& state, const QVector<FilterFile::rule>& rules )
+{
+    QVector<int> changed = state.changedKeys( base );
+    out << ( qint32 )changed.size();
+    for ( int i = 0; i < changed.size(); i++ )
+    {
+        out << ( qint32 )changed[ i ];
+    }
+    out << state.hasSizes() << ( quint64 )state.traceSize() << ( quint64 )state.maxBuf();
+    bool shared = rules.size() == baseRules.size() && ( rules.isEmpty() || rules.constData() == baseRules.constData() );
+    out << shared;
+    if ( !shared )
+    {
+        out << rules;
+    }
+}
+
+bool
+readEntry( QDataStream& in, const FilterState& base, const QVector<FilterFile::rule>& baseRules,
+           FilterState* state, QVector<FilterFile::rule>* rules )
+{
+    qint32 changed = 0;
+    in >> changed;
+    if ( changed < 0 || changed > base.functionNum() )
+    {
+        in.setStatus( QDataStream::ReadCorruptData );
+    }
+    /*toggling the changed functions of a copy shares the other chunks*/
+    *state = base;
+    for ( int i = 0; i < changed && in.status() == QDataStream::Ok; i++ )
+    {
+        qint32 key = -1;
+        in >> key;
+        if ( key < 0 || key >= base.functionNum() )
+        {
+            in.setStatus( QDataStream::ReadCorruptData );
+            break;
+        }
+        state->setExcluded( key, !state->isExcluded( key ) );
+    }
+    bool    hasSizes  = false;
+    quint64 traceSize = 0;
+    quint64 maxBuf    = 0;
+    bool    shared    = false;
+    in >> hasSizes >> traceSize >> maxBuf >> shared;
+    /*an unchanged selection keeps the sizes of base, they are the same*/
+    if ( hasSizes && !state->hasSizes() )
+    {
+        state->setSizes( traceSize, maxBuf );
+    }
+    if ( shared )
+    {
+        *rules = baseRules;
+    }
+    else
+    {
+        in >> *rules;
+    }
+    return in.status() == QDataStream::Ok;
+}
+
+/*entries nearest to the current state first, each relative to the one before*/
+void
+writeHistory( QDataStream& out, const Connector::history& h,
+              const QList<FilterState>& states, const QList<QVector<FilterFile::rule> >& rules )
+{
+    out << ( qint32 )states.size();
+    const FilterState*               base      = &h.state;
+    const QVector<FilterFile::rule>* baseRules = &h.rules;
+    for ( int i = states.size() - 1; i >= 0; i-- )
+    {
+        writeEntry( out, *base, *baseRules, states[ i ], rules[ i ] );
+        base      = &states[ i ];
+        baseRules = &rules[ i ];
+    }
+}
+
+bool
+readHistory( QDataStream& in, const Connector::history& h,
+             QList<FilterState>* states, QList<QVector<FilterFile::rule> >* rules )
+{
+    qint32 num = 0;
+    in >> num;
+    if ( num < 0 )
+    {
+        in.setStatus( QDataStream::ReadCorruptData );
+    }
+    FilterState               base      = h.state;
+    QVector<FilterFile::rule> baseRules = h.rules;
+    for ( int i = 0; i < num && in.status() == QDataStream::Ok; i++ )
+    {
+        FilterState               state;
+        QVector<FilterFile::rule> stateRules;
+        if ( !readEntry( in, base, baseRules, &state, &stateRules ) )
+        {
+            break;
+        }
+        states->prepend( state );
+        rules->prepend( stateRules );
+        base      = state;
+        baseRules = stateRules;
+    }
+    return in.status() == QDataStream::Ok;
+}
+}
+
+bool
+SessionFile::save( const QString& fileName, const content& c, QString* error )
+{
+    QByteArray  payload;
+    QDataStream out( &payload, QIODevice::WriteOnly );
+    out.setVersion( QDataStream::Qt_4_6 );
+    out << c.profile << ( qint64 )c.profileSize << c.profileModified
+        << c.filterFile << c.compress
+        << ( qint32 )c.sortColumn << ( qint32 )c.sortOrder
+        << c.search << c.onlyMatches << ( qint32 )c.tab;
+    /*only the current state keeps its per process totals*/
+    out << c.filter.state << c.filter.rules;
+    writeHistory( out, c.filter, c.filter.undo, c.filter.undoRules );
+    writeHistory( out, c.filter, c.filter.redo, c.filter.redoRules );
+
+    QByteArray  text;
+    QDataStream header( &text, QIODevice::WriteOnly );
+    header.setVersion( QDataStream::Qt_4_6 );
+    header << ( quint32 )SESSIONFILE_MAGIC << ( quint32 )SESSIONFILE_VERSION << qCompress( payload );
+    return FilterExport::write( fileName, text, error );
+}
+
+bool
+SessionFile::load( const QString& fileName, content* c, QString* error )
+{
+    QFile file( fileName );
+    if ( !file.open( QIODevice::ReadOnly ) )
+    {
+        *error = "cannot open " + fileName + ", " + file.errorString();
+        return false;
+    }
+    QByteArray  text = file.readAll();
+    QDataStream header( text );
+    header.setVersion( QDataStream::Qt_4_6 );
+    quint32     magic   = 0;
+    quint32     version = 0;
+    QByteArray  compressed;
+    header >> magic >> version;
+    if ( header.status() != QDataStream::Ok || magic != SESSIONFILE_MAGIC )
+    {
+        *error = fileName + " is not a session file";
+        return false;
+    }
+    if ( version > SESSIONFILE_VERSION )
+    {
+        *error = fileName + " was saved by a newer version";
+        return false;
+    }
+    header >> compressed;
+    QByteArray payload = qUncompress( compressed );
+    if ( payload.isEmpty() )
+    {
+        *error = fileName + " is damaged";
+        return false;
+    }
+
+    QDataStream in( payload );
+    in.setVersion( QDataStream::Qt_4_6 );
+    qint64      profileSize = 0;
+    qint32      sortColumn  = 0;
+    qint32      sortOrder   = 0;
+    qint32      tab         = 0;
+    in >> c->profile >> profileSize >> c->profileModified
+    >> c->filterFile >> c->compress
+    >> sortColumn >> sortOrder
+    >> c->search >> c->onlyMatches >> tab;
+    c->profileSize = profileSize;
+    c->sortColumn  = sortColumn;
+    c->sortOrder   = sortOrder;
+    c->tab         = tab;
+    c->filter      = Connector::history();
+    in >> c->filter.state >> c->filter.rules;
+    if ( in.status() != QDataStream::Ok ||
+         !readHistory( in, c->filter, &c->filter.undo, &c->filter.undoRules ) ||
+         !readHistory( in, c->filter, &c->filter.redo, &c->filter.redoRules ) ||
+         !in.atEnd() )
+    {
+        *error = fileName + " is damaged";
+        return false;
+    }
+    return true;
+}
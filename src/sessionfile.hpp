@@ -0,0 +1,65 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#ifndef SESSIONFILE_HPP
+#define SESSIONFILE_HPP
+
+#include <QtGlobal>
+#include <QString>
+#include <QDateTime>
+
+#include "connector.hpp"
+
+/*
+ * The state of the GUI for one profile: the filter with its rules and
+ * history, the filtered sizes and per process totals, the sort order and
+ * the search. The profile itself is only referenced, its size and time
+ * of modification tell whether it changed since.
+ *
+ * The file is a short header followed by compressed QDataStream data.
+ * The current state is stored completely, every history entry as the
+ * functions that differ from its neighbour. Reading rebuilds the entries
+ * by toggling these functions, so they share their chunks again, see
+ * FilterState.
+ */
+class SessionFile
+{
+public:
+    struct content
+    {
+        QString            profile;
+        qint64             profileSize;
+        QDateTime          profileModified;
+        Connector::history filter;
+        QString            filterFile;
+        bool               compress;
+        /*TableModel column, CHECK if unsorted*/
+        int                sortColumn;
+        int                sortOrder;
+        QString            search;
+        bool               onlyMatches;
+        int                tab;
+    };
+
+    static bool
+    save( const QString& fileName,
+          const content& c,
+          QString*       error );
+    /*the values are not checked against the profile, see
+     * Connector::restoreHistory*/
+    static bool
+    load( const QString& fileName,
+          content*       c,
+          QString*       error );
+};
+
+#endif // SESSIONFILE_HPP
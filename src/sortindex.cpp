@@ -0,0 +1,177 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#include <algorithm>
+#include <QThread>
+#include <QtConcurrentMap>
+
+#include "sortindex.hpp"
+#include "tablemodel.hpp"
+
+namespace
+{
+/*orders the keys by one column, equal values keep the order of the keys*/
+struct keyLess
+{
+    const QVector<dataCenter::data>* rows;
+    int                              column;
+
+    bool
+    operator()( int a, int b ) const
+    {
+        const dataCenter::data& x = ( *rows )[ a ];
+        const dataCenter::data& y = ( *rows )[ b ];
+        switch ( column )
+        {
+            case TableModel::TYPE:
+                if ( x.type != y.type )
+                {
+                    return x.type < y.type;
+                }
+                break;
+            case TableModel::MAX_BUF:
+                if ( x.maxBuf != y.maxBuf )
+                {
+                    return x.maxBuf < y.maxBuf;
+                }
+                break;
+            case TableModel::VISITS:
+                if ( x.visits != y.visits )
+                {
+                    return x.visits < y.visits;
+                }
+                break;
+            case TableModel::TIME:
+                if ( x.timeS != y.timeS )
+                {
+                    return x.timeS < y.timeS;
+                }
+                break;
+            case TableModel::TIME_PERCENT:
+                if ( x.timeP != y.timeP )
+                {
+                    return x.timeP < y.timeP;
+                }
+                break;
+            case TableModel::TIME_PER_VISIT:
+                if ( x.timePerVisit != y.timePerVisit )
+                {
+                    return x.timePerVisit < y.timePerVisit;
+                }
+                break;
+            case TableModel::REGION:
+                if ( x.region != y.region )
+                {
+                    return x.region < y.region;
+                }
+                break;
+            default:
+                break;
+        }
+        return a < b;
+    }
+};
+
+/*[first, middle) and [middle, last) of keys, middle is only used by merges*/
+struct range
+{
+    int*    keys;
+    int     first;
+    int     middle;
+    int     last;
+    keyLess less;
+};
+
+void
+sortRange( range& r )
+{
+    std::sort( r.keys + r.first, r.keys + r.last, r.less );
+}
+
+void
+mergeRange( range& r )
+{
+    std::inplace_merge( r.keys + r.first, r.keys + r.middle, r.keys + r.last, r.less );
+}
+}
+
+QVector<QVector<int> >
+SortIndex::compute( QSharedPointer<const dataCenter::functionSnapshot> functions )
+{
+    QVector<QVector<int> > result( TableModel::COLUMN_NUM );
+    if ( !functions )
+    {
+        return result;
+    }
+    for ( int column = TableModel::CHECK + 1; column < TableModel::COLUMN_NUM; column++ )
+    {
+        result[ column ] = sortColumn( functions->rows, column );
+    }
+    return result;
+}
+
+QVector<int>
+SortIndex::sortColumn( const QVector<dataCenter::data>& rows, int column )
+{
+    QVector<int> keys( rows.size() );
+    for ( int i = 0; i < keys.size(); i++ )
+    {
+        keys[ i ] = i;
+    }
+    keyLess less;
+    less.rows   = &rows;
+    less.column = column;
+
+    /*small tables are not worth the threads*/
+    int chunkNum = qMax( 1, qMin( QThread::idealThreadCount(), keys.size() / 4096 ) );
+    int chunk    = ( keys.size() + chunkNum - 1 ) / chunkNum;
+    if ( chunkNum == 1 )
+    {
+        std::sort( keys.begin(), keys.end(), less );
+        return keys;
+    }
+
+    QVector<range> ranges;
+    for ( int first = 0; first < keys.size(); first += chunk )
+    {
+        range r;
+        r.keys   = keys.data();
+        r.first  = first;
+        r.middle = first;
+        r.last   = qMin( first + chunk, keys.size() );
+        r.less   = less;
+        ranges.append( r );
+    }
+    QtConcurrent::blockingMap( ranges, sortRange );
+
+    /*neighbouring sorted ranges are merged until one is left*/
+    while ( ranges.size() > 1 )
+    {
+        QVector<range> merges;
+        QVector<range> next;
+        for ( int i = 0; i + 1 < ranges.size(); i += 2 )
+        {
+            range r = ranges[ i ];
+            r.middle = ranges[ i ].last;
+            r.last   = ranges[ i + 1 ].last;
+            merges.append( r );
+            next.append( r );
+        }
+        if ( ranges.size() % 2 == 1 )
+        {
+            next.append( ranges.last() );
+        }
+        QtConcurrent::blockingMap( merges, mergeRange );
+        ranges = next;
+    }
+    return keys;
+}
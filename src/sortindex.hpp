@@ -0,0 +1,41 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#ifndef SORTINDEX_HPP
+#define SORTINDEX_HPP
+
+#include <QtGlobal>
+#include <QVector>
+#include <QSharedPointer>
+
+#include "data.hpp"
+
+/*
+ * Ascending order of the function keys for every column of the function
+ * table. The orders are computed once after loading, switching the sort
+ * column then only means switching the order. Descending is the
+ * ascending order read backwards.
+ */
+class SortIndex
+{
+public:
+    /*runs in a worker thread, indexed by TableModel::columns, CHECK is empty*/
+    static QVector<QVector<int> >
+    compute( QSharedPointer<const dataCenter::functionSnapshot> functions );
+
+    /*chunks are sorted in parallel and then merged pairwise, also in parallel*/
+    static QVector<int>
+    sortColumn( const QVector<dataCenter::data>& rows,
+                int                              column );
+};
+
+#endif // SORTINDEX_HPP
@@ -0,0 +1,485 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#include <algorithm>
+#include <QBrush>
+
+#include "tablemodel.hpp"
+
+namespace
+{
+/*change of a numeric column against the baseline, changes hidden by the
+ * two decimals of the time columns count as none*/
+template<class T>
+double
+delta( const T& row, const T& base, int column )
+{
+    double d = 0;
+    switch ( column )
+    {
+        case TableModel::MAX_BUF:
+            return ( double )row.maxBuf - base.maxBuf;
+        case TableModel::VISITS:
+            return ( double )row.visits - base.visits;
+        case TableModel::TIME:
+            d = row.timeS - base.timeS;
+            break;
+        case TableModel::TIME_PERCENT:
+            d = row.timeP - base.timeP;
+            break;
+        case TableModel::TIME_PER_VISIT:
+            d = row.timePerVisit - base.timePerVisit;
+            break;
+        default:
+            return 0;
+    }
+    return qAbs( d ) < 0.005 ? 0 : d;
+}
+
+QString
+deltaText( double d, int column )
+{
+    QString sign = d < 0 ? "-" : "+";
+    if ( column == TableModel::MAX_BUF || column == TableModel::VISITS )
+    {
+        return " (" + sign + TableModel::seperate( ( int )qAbs( d ) ) + ")";
+    }
+    return " (" + sign + QString::number( qAbs( d ), 'f', 2 ) + ")";
+}
+
+/*data and groupData share the columns of the tables, base is the row of
+ * the baseline while compared*/
+template<class T>
+QVariant
+rowCell( const T& row, const T* base, bool compared, int column, int role )
+{
+    if ( role == Qt::TextAlignmentRole )
+    {
+        if ( column == TableModel::TYPE || column == TableModel::REGION )
+        {
+            return ( int )( Qt::AlignLeft | Qt::AlignVCenter );
+        }
+        return ( int )( Qt::AlignRight | Qt::AlignVCenter );
+    }
+    if ( role == Qt::ForegroundRole && base )
+    {
+        /*growth is what costs buffer space*/
+        double d = delta( row, *base, column );
+        if ( d != 0 )
+        {
+            return QBrush( d > 0 ? Qt::darkRed : Qt::darkGreen );
+        }
+        return QVariant();
+    }
+    if ( role != Qt::DisplayRole )
+    {
+        return QVariant();
+    }
+    QString text;
+    switch ( column )
+    {
+        case TableModel::TYPE:
+            return QString::fromStdString( row.type );
+        case TableModel::MAX_BUF:
+            text = TableModel::seperate( row.maxBuf );
+            break;
+        case TableModel::VISITS:
+            text = TableModel::seperate( row.visits );
+            break;
+        case TableModel::TIME:
+            text = QString::number( row.timeS, 'f', 2 );
+            break;
+        case TableModel::TIME_PERCENT:
+            text = QString::number( row.timeP, 'f', 2 );
+            break;
+        case TableModel::TIME_PER_VISIT:
+            text = QString::number( row.timePerVisit, 'f', 2 );
+            break;
+        case TableModel::REGION:
+            text = QString::fromStdString( row.region );
+            if ( compared && !base )
+            {
+                text += "  (new)";
+            }
+            return text;
+        default:
+            return QVariant();
+    }
+    if ( base )
+    {
+        double d = delta( row, *base, column );
+        if ( d != 0 )
+        {
+            text += deltaText( d, column );
+        }
+    }
+    return text;
+}
+}
+
+TableModel::TableModel( QObject* parent )
+    : QAbstractTableModel( parent )
+{
+    m_noFilter = dataCenter::noFilterTypes();
+}
+
+int
+TableModel::columnCount( const QModelIndex& parent ) const
+{
+    if ( parent.isValid() )
+    {
+        return 0;
+    }
+    return COLUMN_NUM;
+}
+
+QVariant
+TableModel::headerData( int section, Qt::Orientation orientation, int role ) const
+{
+    if ( orientation != Qt::Horizontal || role != Qt::DisplayRole )
+    {
+        return QVariant();
+    }
+    switch ( section )
+    {
+        case TYPE:
+            return "type";
+        case MAX_BUF:
+            return "max_buff[B]";
+        case VISITS:
+            return "visits";
+        case TIME:
+            return "time[s]";
+        case TIME_PERCENT:
+            return "time[%]";
+        case TIME_PER_VISIT:
+            return "time/visit[us]";
+        case REGION:
+            return "region";
+        default:
+            return "";
+    }
+}
+
+Qt::ItemFlags
+TableModel::flags( const QModelIndex& index ) const
+{
+    if ( !index.isValid() )
+    {
+        return Qt::NoItemFlags;
+    }
+    Qt::ItemFlags result = Qt::ItemIsEnabled | Qt::ItemIsSelectable;
+    if ( index.column() == CHECK && !m_noFilter.contains( rowType( index.row() ) ) )
+    {
+        result |= Qt::ItemIsUserCheckable;
+    }
+    return result;
+}
+
+bool
+TableModel::setData( const QModelIndex& index, const QVariant& value, int role )
+{
+    Q_UNUSED( value );
+    if ( !index.isValid() || index.column() != CHECK || role != Qt::CheckStateRole )
+    {
+        return false;
+    }
+    /*the Connector decides about the new state, the model is told afterwards*/
+    emit toggled( keyAt( index.row() ) );
+    return false;
+}
+
+int
+TableModel::keyAt( int row ) const
+{
+    return row;
+}
+
+void
+TableModel::emitRows( QVector<int> rows, int firstColumn, int lastColumn )
+{
+    std::sort( rows.begin(), rows.end() );
+    int i = 0;
+    while ( i < rows.size() )
+    {
+        int first = rows[ i ];
+        int last  = first;
+        while ( i + 1 < rows.size() && rows[ i + 1 ] <= last + 1 )
+        {
+            last = rows[ ++i ];
+        }
+        emit dataChanged( index( first, firstColumn ), index( last, lastColumn ) );
+        i++;
+    }
+}
+
+QString
+TableModel::seperate( int number )
+{
+    QString temp = QString::number( number );
+    if ( temp.size() > 3 )
+    {
+        temp.insert( temp.size() - 3, "," );
+    }
+    /*7 because of the added ,*/
+    if ( temp.size() > 7 )
+    {
+        temp.insert( temp.size() - 7, "," );
+    }
+    return temp;
+}
+
+void
+TableModel::setDiff( QSharedPointer<const ProfileDiff> diff )
+{
+    m_diff = diff;
+    if ( rowCount() > 0 )
+    {
+        emit dataChanged( index( 0, TYPE ), index( rowCount() - 1, COLUMN_NUM - 1 ) );
+    }
+}
+
+QVariant
+TableModel::cell( const dataCenter::data& row, int key, int column, int role ) const
+{
+    return rowCell( row, m_diff ? m_diff->baselineFunction( key ) : 0, !m_diff.isNull(), column, role );
+}
+
+QVariant
+TableModel::cell( const dataCenter::groupData& row, int column, int role ) const
+{
+    return rowCell( row, m_diff ? m_diff->baselineGroup( row.type ) : 0, !m_diff.isNull(), column, role );
+}
+
+GroupTableModel::GroupTableModel( QObject* parent )
+    : TableModel( parent )
+{
+}
+
+void
+GroupTableModel::setGroups( QSharedPointer<const dataCenter::groupSnapshot> groups,
+                            const QVector<int>&                             rows )
+{
+    /*same rows with new values keep the selection of the view*/
+    if ( m_groups && groups && m_groups->rows.size() == groups->rows.size() )
+    {
+        m_groups = groups;
+        emitRows( rows, 0, COLUMN_NUM - 1 );
+        return;
+    }
+    beginResetModel();
+    m_groups = groups;
+    endResetModel();
+}
+
+int
+GroupTableModel::rowCount( const QModelIndex& parent ) const
+{
+    if ( parent.isValid() || !m_groups )
+    {
+        return 0;
+    }
+    return m_groups->rows.size();
+}
+
+QVariant
+GroupTableModel::data( const QModelIndex& index, int role ) const
+{
+    if ( !index.isValid() || !m_groups || index.row() >= m_groups->rows.size() )
+    {
+        return QVariant();
+    }
+    const dataCenter::groupData& row = m_groups->rows[ index.row() ];
+    if ( index.column() == CHECK )
+    {
+        if ( role != Qt::CheckStateRole || m_noFilter.contains( QString::fromStdString( row.type ) ) )
+        {
+            return QVariant();
+        }
+        if ( row.state == dataCenter::PARTIAL )
+        {
+            return Qt::PartiallyChecked;
+        }
+        return row.state == dataCenter::INCLUDED ? Qt::Checked : Qt::Unchecked;
+    }
+    return cell( row, index.column(), role );
+}
+
+QString
+GroupTableModel::rowType( int row ) const
+{
+    return QString::fromStdString( m_groups->rows[ row ].type );
+}
+
+FunctionTableModel::FunctionTableModel( QObject* parent )
+    : TableModel( parent )
+    , m_descending( false )
+    , m_identity( true )
+{
+}
+
+void
+FunctionTableModel::setFunctions( QSharedPointer<const dataCenter::functionSnapshot> functions,
+                                  const FilterState&                                 state )
+{
+    beginResetModel();
+    m_functions = functions;
+    m_state     = state;
+    m_ascending.clear();
+    m_descending = false;
+    m_visible.clear();
+    updateRows();
+    endResetModel();
+}
+
+void
+FunctionTableModel::setState( const FilterState& state, const QVector<int>& keys, bool allRows )
+{
+    /*a copy of the state only shares its chunks*/
+    m_state = state;
+    if ( allRows && rowCount() > 0 )
+    {
+        emit dataChanged( index( 0, CHECK ), index( rowCount() - 1, CHECK ) );
+    }
+    else if ( !allRows )
+    {
+        QVector<int> rows;
+        for ( int i = 0; i < keys.size(); i++ )
+        {
+            /*hidden keys have no row*/
+            if ( rowOf( keys[ i ] ) >= 0 )
+            {
+                rows.append( rowOf( keys[ i ] ) );
+            }
+        }
+        emitRows( rows, CHECK, CHECK );
+    }
+}
+
+void
+FunctionTableModel::setOrder( const QVector<int>& ascending, bool descending )
+{
+    emit layoutAboutToBeChanged();
+    QModelIndexList oldIndexes = persistentIndexList();
+    QVector<int>    oldKeys( oldIndexes.size() );
+    for ( int i = 0; i < oldIndexes.size(); i++ )
+    {
+        oldKeys[ i ] = keyAt( oldIndexes[ i ].row() );
+    }
+
+    /*the orders are shared, only the rows cost a pass*/
+    m_ascending  = ascending;
+    m_descending = descending;
+    updateRows();
+
+    QModelIndexList newIndexes;
+    for ( int i = 0; i < oldIndexes.size(); i++ )
+    {
+        newIndexes.append( index( rowOf( oldKeys[ i ] ), oldIndexes[ i ].column() ) );
+    }
+    changePersistentIndexList( oldIndexes, newIndexes );
+    emit layoutChanged();
+}
+
+void
+FunctionTableModel::setVisible( const QVector<int>& keys, bool allKeys )
+{
+    /*the number of rows changes, the view has to start over*/
+    beginResetModel();
+    m_visible.clear();
+    if ( !allKeys && m_functions )
+    {
+        m_visible.fill( 0, m_functions->rows.size() );
+        for ( int i = 0; i < keys.size(); i++ )
+        {
+            m_visible[ keys[ i ] ] = 1;
+        }
+    }
+    updateRows();
+    endResetModel();
+}
+
+void
+FunctionTableModel::updateRows()
+{
+    m_order.clear();
+    m_rows.clear();
+    m_identity = m_ascending.isEmpty() && m_visible.isEmpty();
+    if ( m_identity || !m_functions )
+    {
+        return;
+    }
+    int size = m_functions->rows.size();
+    m_rows.fill( -1, size );
+    m_order.reserve( m_visible.isEmpty() ? size : 0 );
+    for ( int i = 0; i < size; i++ )
+    {
+        int key = i;
+        if ( !m_ascending.isEmpty() )
+        {
+            key = m_ascending[ m_descending ? size - 1 - i : i ];
+        }
+        if ( m_visible.isEmpty() || m_visible[ key ] )
+        {
+            m_rows[ key ] = m_order.size();
+            m_order.append( key );
+        }
+    }
+}
+
+int
+FunctionTableModel::keyAt( int row ) const
+{
+    return m_identity ? row : m_order[ row ];
+}
+
+int
+FunctionTableModel::rowOf( int key ) const
+{
+    return m_identity ? key : m_rows[ key ];
+}
+
+int
+FunctionTableModel::rowCount( const QModelIndex& parent ) const
+{
+    if ( parent.isValid() || !m_functions )
+    {
+        return 0;
+    }
+    return m_identity ? m_functions->rows.size() : m_order.size();
+}
+
+QVariant
+FunctionTableModel::data( const QModelIndex& index, int role ) const
+{
+    if ( !index.isValid() || !m_functions || index.row() >= rowCount() )
+    {
+        return QVariant();
+    }
+    int                     key = keyAt( index.row() );
+    const dataCenter::data& row = m_functions->rows[ key ];
+    if ( index.column() == CHECK )
+    {
+        if ( role != Qt::CheckStateRole || m_noFilter.contains( QString::fromStdString( row.type ) ) )
+        {
+            return QVariant();
+        }
+        return m_state.isExcluded( key ) ? Qt::Unchecked : Qt::Checked;
+    }
+    return cell( row, key, index.column(), role );
+}
+
+QString
+FunctionTableModel::rowType( int row ) const
+{
+    return QString::fromStdString( m_functions->rows[ keyAt( row ) ].type );
+}
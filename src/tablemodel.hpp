@@ -0,0 +1,174 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#ifndef TABLEMODEL_HPP
+#define TABLEMODEL_HPP
+
+#include <QAbstractTableModel>
+#include <QSharedPointer>
+#include <QStringList>
+
+#include "data.hpp"
+#include "filterstate.hpp"
+#include "profilediff.hpp"
+
+/*
+ * Models of the group and the function table. Rows are only turned into
+ * text when the view asks for them, so only the visible rows cost anything.
+ * The checkbox in column 0 is painted by the view, a click is reported by
+ * toggled() and the state itself is owned by the Connector.
+ *
+ * While a profile is compared with a baseline the numbers are followed
+ * by their change, see ProfileDiff.
+ */
+class TableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum columns { CHECK, TYPE, MAX_BUF, VISITS, TIME, TIME_PERCENT, TIME_PER_VISIT, REGION, COLUMN_NUM };
+
+    TableModel( QObject* parent = 0 );
+
+    int
+    columnCount( const QModelIndex& parent = QModelIndex() ) const;
+    QVariant
+    headerData( int             section,
+                Qt::Orientation orientation,
+                int             role = Qt::DisplayRole ) const;
+    Qt::ItemFlags
+    flags( const QModelIndex& index ) const;
+    bool
+    setData( const QModelIndex& index,
+             const QVariant&    value,
+             int                role = Qt::EditRole );
+
+    static QString
+    seperate( int number );
+
+    /*null stops comparing*/
+    void
+    setDiff( QSharedPointer<const ProfileDiff> diff );
+
+    /*key of the data shown in row, the rows of a sorted model are permuted*/
+    virtual int
+    keyAt( int row ) const;
+
+signals:
+    /*key of the clicked row*/
+    void
+    toggled( int key );
+
+protected:
+    QStringList                       m_noFilter;
+    QSharedPointer<const ProfileDiff> m_diff;
+
+    virtual QString
+    rowType( int row ) const = 0;
+    /*one dataChanged per run of consecutive rows*/
+    void
+    emitRows( QVector<int> rows,
+              int          firstColumn,
+              int          lastColumn );
+    QVariant
+    cell( const dataCenter::data& row,
+          int                     key,
+          int                     column,
+          int                     role ) const;
+    QVariant
+    cell( const dataCenter::groupData& row,
+          int                          column,
+          int                          role ) const;
+};
+
+class GroupTableModel : public TableModel
+{
+    Q_OBJECT
+
+public:
+    GroupTableModel( QObject* parent = 0 );
+
+    /*rows lists the changed rows if only values changed*/
+    void
+    setGroups( QSharedPointer<const dataCenter::groupSnapshot> groups,
+               const QVector<int>&                             rows = QVector<int>() );
+    int
+    rowCount( const QModelIndex& parent = QModelIndex() ) const;
+    QVariant
+    data( const QModelIndex& index,
+          int                role = Qt::DisplayRole ) const;
+
+protected:
+    QString
+    rowType( int row ) const;
+
+private:
+    QSharedPointer<const dataCenter::groupSnapshot> m_groups;
+};
+
+class FunctionTableModel : public TableModel
+{
+    Q_OBJECT
+
+public:
+    FunctionTableModel( QObject* parent = 0 );
+
+    void
+    setFunctions( QSharedPointer<const dataCenter::functionSnapshot> functions,
+                  const FilterState&                                 state );
+    /*only the checkboxes of keys depend on the state change, all if allRows*/
+    void
+    setState( const FilterState&  state,
+              const QVector<int>& keys,
+              bool                allRows );
+    /*shows the keys in the given ascending order or reversed, an empty
+     * order restores the order of the snapshot, selections follow their keys*/
+    void
+    setOrder( const QVector<int>& ascending,
+              bool                descending );
+    /*only keys get a row, all of them if allKeys*/
+    void
+    setVisible( const QVector<int>& keys,
+                bool                allKeys );
+    int
+    keyAt( int row ) const;
+    /*-1 if the key is hidden*/
+    int
+    rowOf( int key ) const;
+    int
+    rowCount( const QModelIndex& parent = QModelIndex() ) const;
+    QVariant
+    data( const QModelIndex& index,
+          int                role = Qt::DisplayRole ) const;
+
+protected:
+    QString
+    rowType( int row ) const;
+
+private:
+    QSharedPointer<const dataCenter::functionSnapshot> m_functions;
+    FilterState                                        m_state;
+    QVector<int>                                       m_ascending;
+    bool                                               m_descending;
+    /*flag per key, empty if every key is shown*/
+    QVector<char> m_visible;
+    /*key of each row and row of each key, -1 if hidden, both unused
+     * while the rows are the keys*/
+    bool         m_identity;
+    QVector<int> m_order;
+    QVector<int> m_rows;
+
+    void
+    updateRows();
+};
+
+#endif // TABLEMODEL_HPP
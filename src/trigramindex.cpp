@@ -0,0 +1,201 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#include <algorithm>
+
+#include "trigramindex.hpp"
+
+namespace
+{
+/*names are compared byte wise, only ASCII letters are folded*/
+inline char
+lower( char c )
+{
+    return c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c;
+}
+
+inline quint32
+trigram( const std::string& name, size_t i )
+{
+    return ( ( quint32 )( unsigned char )lower( name[ i ] ) << 16 ) |
+           ( ( quint32 )( unsigned char )lower( name[ i + 1 ] ) << 8 ) |
+           ( quint32 )( unsigned char )lower( name[ i + 2 ] );
+}
+
+struct lowerEqual
+{
+    bool
+    operator()( char a, char b ) const
+    {
+        return lower( a ) == b;
+    }
+};
+
+/*distinct trigrams of both names of a function*/
+void
+trigrams( const dataCenter::data& row, QVector<quint32>& result )
+{
+    result.clear();
+    for ( size_t i = 0; i + 2 < row.region.size(); i++ )
+    {
+        result.append( trigram( row.region, i ) );
+    }
+    for ( size_t i = 0; i + 2 < row.mangledName.size(); i++ )
+    {
+        result.append( trigram( row.mangledName, i ) );
+    }
+    std::sort( result.begin(), result.end() );
+    result.erase( std::unique( result.begin(), result.end() ), result.end() );
+}
+}
+
+TrigramIndex::TrigramIndex()
+{
+}
+
+QSharedPointer<const TrigramIndex>
+TrigramIndex::build( QSharedPointer<const dataCenter::functionSnapshot> functions )
+{
+    QSharedPointer<TrigramIndex> index( new TrigramIndex() );
+    index->m_functions = functions;
+    if ( !functions )
+    {
+        return index;
+    }
+    const QVector<dataCenter::data>& rows = functions->rows;
+
+    /*first pass counts the keys per trigram, the second one fills the
+     * lists, keys are visited in order so every list ends up sorted*/
+    QVector<quint32> current;
+    for ( int key = 0; key < rows.size(); key++ )
+    {
+        trigrams( rows[ key ], current );
+        for ( int i = 0; i < current.size(); i++ )
+        {
+            index->m_lists[ current[ i ] ].second++;
+        }
+    }
+    int offset = 0;
+    for ( QHash<quint32, QPair<int, int> >::iterator it = index->m_lists.begin(); it != index->m_lists.end(); ++it )
+    {
+        it.value().first = offset;
+        offset          += it.value().second;
+        it.value().second = 0;
+    }
+    index->m_keys.resize( offset );
+    for ( int key = 0; key < rows.size(); key++ )
+    {
+        trigrams( rows[ key ], current );
+        for ( int i = 0; i < current.size(); i++ )
+        {
+            QPair<int, int>& list = index->m_lists[ current[ i ] ];
+            index->m_keys[ list.first + list.second++ ] = key;
+        }
+    }
+    return index;
+}
+
+bool
+TrigramIndex::fits( QSharedPointer<const dataCenter::functionSnapshot> functions ) const
+{
+    if ( !m_functions || !functions || m_functions->rows.size() != functions->rows.size() )
+    {
+        return false;
+    }
+    const QVector<dataCenter::data>& own  = m_functions->rows;
+    const QVector<dataCenter::data>& rows = functions->rows;
+    for ( int key = 0; key < rows.size(); key++ )
+    {
+        if ( own[ key ].region != rows[ key ].region || own[ key ].mangledName != rows[ key ].mangledName )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+QVector<int>
+TrigramIndex::search( const QString& text ) const
+{
+    QVector<int> result;
+    QByteArray   utf8 = text.toUtf8();
+    std::string  lowerText( utf8.constData(), utf8.size() );
+    for ( size_t i = 0; i < lowerText.size(); i++ )
+    {
+        lowerText[ i ] = lower( lowerText[ i ] );
+    }
+    if ( lowerText.empty() || !m_functions )
+    {
+        return result;
+    }
+
+    /*too short for a trigram, every name has to be checked*/
+    if ( lowerText.size() < 3 )
+    {
+        for ( int key = 0; key < m_functions->rows.size(); key++ )
+        {
+            if ( matches( key, lowerText ) )
+            {
+                result.append( key );
+            }
+        }
+        return result;
+    }
+
+    /*the lists of the query, shortest first to keep the intersections small*/
+    QVector<QPair<int, int> > lists;
+    for ( size_t i = 0; i + 2 < lowerText.size(); i++ )
+    {
+        QHash<quint32, QPair<int, int> >::const_iterator it = m_lists.find( trigram( lowerText, i ) );
+        if ( it == m_lists.end() )
+        {
+            return result;
+        }
+        lists.append( qMakePair( it.value().second, it.value().first ) );
+    }
+    std::sort( lists.begin(), lists.end() );
+    lists.erase( std::unique( lists.begin(), lists.end() ), lists.end() );
+
+    const int*   keys = m_keys.constData();
+    QVector<int> candidates( lists[ 0 ].first );
+    std::copy( keys + lists[ 0 ].second, keys + lists[ 0 ].second + lists[ 0 ].first, candidates.begin() );
+    QVector<int> next;
+    for ( int i = 1; i < lists.size() && !candidates.isEmpty(); i++ )
+    {
+        const int* first = keys + lists[ i ].second;
+        next.resize( candidates.size() );
+        next.erase( std::set_intersection( candidates.begin(), candidates.end(),
+                                           first, first + lists[ i ].first,
+                                           next.begin() ), next.end() );
+        candidates.swap( next );
+    }
+
+    /*the trigrams may appear in another order or in different names*/
+    for ( int i = 0; i < candidates.size(); i++ )
+    {
+        if ( matches( candidates[ i ], lowerText ) )
+        {
+            result.append( candidates[ i ] );
+        }
+    }
+    return result;
+}
+
+bool
+TrigramIndex::matches( int key, const std::string& lowerText ) const
+{
+    const dataCenter::data& row = m_functions->rows[ key ];
+    return std::search( row.region.begin(), row.region.end(),
+                        lowerText.begin(), lowerText.end(), lowerEqual() ) != row.region.end() ||
+           std::search( row.mangledName.begin(), row.mangledName.end(),
+                        lowerText.begin(), lowerText.end(), lowerEqual() ) != row.mangledName.end();
+}
@@ -0,0 +1,61 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2016,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#ifndef TRIGRAMINDEX_HPP
+#define TRIGRAMINDEX_HPP
+
+#include <QtGlobal>
+#include <QVector>
+#include <QHash>
+#include <QPair>
+#include <QString>
+#include <QSharedPointer>
+
+#include "data.hpp"
+
+/*
+ * Case insensitive substring search over the region and mangled names of
+ * the functions. Every trigram of the names points to the sorted keys
+ * containing it, a query intersects the lists of its trigrams and only
+ * checks the names of the remaining keys. The index is immutable after
+ * build() and can be shared between threads.
+ */
+class TrigramIndex
+{
+public:
+    TrigramIndex();
+
+    /*runs in a worker thread*/
+    static QSharedPointer<const TrigramIndex>
+    build( QSharedPointer<const dataCenter::functionSnapshot> functions );
+
+    /*true if functions has the same names under the same keys, e.g.
+     * after the profile was rewritten, the index then serves it as well*/
+    bool
+    fits( QSharedPointer<const dataCenter::functionSnapshot> functions ) const;
+
+    /*sorted keys whose region or mangled name contains text*/
+    QVector<int>
+    search( const QString& text ) const;
+
+private:
+    QSharedPointer<const dataCenter::functionSnapshot> m_functions;
+    /*offset and length of the keys of each trigram in m_keys*/
+    QHash<quint32, QPair<int, int> > m_lists;
+    QVector<int>                     m_keys;
+
+    bool
+    matches( int                key,
+             const std::string& lowerText ) const;
+};
+
+#endif // TRIGRAMINDEX_HPP